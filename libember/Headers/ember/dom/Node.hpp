@@ -24,6 +24,23 @@ namespace libember { namespace dom
     class LIBEMBER_API Node
     {
         friend class Container;
+        public:
+            /**
+             * Enumeration of the node categories that can be told apart without
+             * relying on runtime type information.
+             */
+            enum Kind
+            {
+                /** A node whose concrete type is not known to the DOM layer. */
+                UnknownKind = 0,
+
+                /** A node derived from Container. */
+                ContainerKind,
+
+                /** A VariantLeaf. */
+                VariantLeafKind
+            };
+
         public:
             /**
              * Virtualized copy constructor that creates a deep copy of the DOM
@@ -43,6 +60,14 @@ namespace libember { namespace dom
              */
             virtual ~Node();
 
+            /**
+             * Return the category of this node. Code that needs to downcast a
+             * node may check the category and use a static_cast instead of a
+             * dynamic_cast.
+             * @return The category of this node.
+             */
+            Kind kind() const;
+
             /**
              * Return the application tag of this node.
              * @return The application tag of this node.
@@ -155,6 +180,15 @@ namespace libember { namespace dom
              */
             explicit Node(ber::Tag tag);
 
+            /**
+             * Constructor that initializes the node with the application tag
+             * specified in @p tag, the category specified in @p kind and
+             * without a parent node.
+             * @param tag the application tag of of this node.
+             * @param kind the category of this node.
+             */
+            Node(ber::Tag tag, Kind kind);
+
             /**
              * Copy constructor that initializes the instance as a copy of
              * @p other, with the exception that the parent pointer is
@@ -201,6 +235,7 @@ namespace libember { namespace dom
         private:
             ber::Tag m_applicationTag;
             Node* m_parent;
+            Kind m_kind;
             mutable bool m_dirty;
     };
 }
@@ -16,7 +16,7 @@ namespace libember { namespace dom
 {
     LIBEMBER_INLINE
     Container::Container(ber::Tag tag)
-        : Node(tag)
+        : Node(tag, ContainerKind)
     {}
 
     LIBEMBER_INLINE
@@ -16,18 +16,29 @@ namespace libember { namespace dom
 {
     LIBEMBER_INLINE
     Node::Node(ber::Tag tag)
-        : m_applicationTag(tag), m_parent(0), m_dirty(true)
+        : m_applicationTag(tag), m_parent(0), m_kind(UnknownKind), m_dirty(true)
+    {}
+
+    LIBEMBER_INLINE
+    Node::Node(ber::Tag tag, Kind kind)
+        : m_applicationTag(tag), m_parent(0), m_kind(kind), m_dirty(true)
     {}
 
     LIBEMBER_INLINE
     Node::Node(Node const& other)
-        : m_applicationTag(other.m_applicationTag), m_parent(0), m_dirty(true)
+        : m_applicationTag(other.m_applicationTag), m_parent(0), m_kind(other.m_kind), m_dirty(true)
     {}
 
     LIBEMBER_INLINE
     Node::~Node()
     {}
 
+    LIBEMBER_INLINE
+    Node::Kind Node::kind() const
+    {
+        return m_kind;
+    }
+
     LIBEMBER_INLINE
     ber::Tag Node::applicationTag() const
     {
@@ -16,12 +16,12 @@ namespace libember { namespace dom
 {
     LIBEMBER_INLINE
     VariantLeaf::VariantLeaf(ber::Tag tag)
-        : Node(tag), m_value(), m_cachedLength(0)
+        : Node(tag, VariantLeafKind), m_value(), m_cachedLength(0)
     {}
 
     LIBEMBER_INLINE
     VariantLeaf::VariantLeaf(ber::Tag tag, ber::Value value)
-        : Node(tag), m_value(value), m_cachedLength(0)
+        : Node(tag, VariantLeafKind), m_value(value), m_cachedLength(0)
     {}
 
     LIBEMBER_INLINE
@@ -31,7 +31,9 @@
 #include "GlowQualifiedMatrix.hpp"
 #include "GlowTarget.hpp"
 #include "GlowSource.hpp"
-#include "GlowConnection.hpp"
+#include "GlowConnection.hpp"
+#include "GlowCompactSignalCollection.hpp"
+#include "GlowCompactConnectionCollection.hpp"
 #include "GlowLabel.hpp"
 #include "GlowInvocation.hpp"
 #include "GlowInvocationResult.hpp"
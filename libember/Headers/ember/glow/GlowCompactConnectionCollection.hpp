@@ -0,0 +1,213 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_GLOWCOMPACTCONNECTIONCOLLECTION_HPP
+#define __LIBEMBER_GLOW_GLOWCOMPACTCONNECTIONCOLLECTION_HPP
+
+#include <vector>
+#include "../ber/ObjectIdentifier.hpp"
+#include "../dom/Node.hpp"
+#include "../dom/Sequence.hpp"
+#include "ConnectionDisposition.hpp"
+#include "ConnectionOperation.hpp"
+
+namespace libember { namespace glow
+{
+    /**
+     * Array backed replacement for the sequence of GlowConnection objects
+     * contained in a matrix. The connections are stored as one row per target,
+     * where all source numbers share a single array and each row only stores
+     * the offset of its first source. The collection encodes to exactly the
+     * same BER representation as a dom::Sequence containing the corresponding
+     * GlowConnection objects, where the sources are only present if the row
+     * contains at least one source, the operation is only present if it is
+     * not ConnectionOperation::Absolute and the disposition is only present
+     * if it is not ConnectionDisposition::Tally.
+     * Decoded matrices always contain the node based representation.
+     */
+    class LIBEMBER_API GlowCompactConnectionCollection : public dom::Node
+    {
+        public:
+            typedef ber::ObjectIdentifier::value_type source_type;
+            typedef std::vector<source_type>::const_iterator const_source_iterator;
+            typedef std::vector<int>::size_type size_type;
+
+        public:
+            /**
+             * Initializes a new, empty connection collection.
+             * @param tag The application tag of the collection.
+             */
+            explicit GlowCompactConnectionCollection(ber::Tag const& tag);
+
+            /**
+             * Reserves the memory required to store @p connectionCount connections
+             * which reference @p sourceCount sources in total.
+             * @param connectionCount The number of connections to reserve memory for.
+             * @param sourceCount The total number of sources to reserve memory for.
+             */
+            void reserve(size_type connectionCount, size_type sourceCount);
+
+            /**
+             * Appends an absolute connection for @p target, which has no sources
+             * connected.
+             * @param target The number of the target.
+             */
+            void insert(int target);
+
+            /**
+             * Appends a connection for @p target which contains the sources in the
+             * range [@p first, @p last).
+             * @param target The number of the target.
+             * @param first An iterator pointing to the first source number.
+             * @param last An iterator pointing one past the last source number.
+             * @param operation The connection operation.
+             * @param disposition The connection disposition.
+             */
+            template<typename InputIterator>
+            void insert(
+                int target,
+                InputIterator first,
+                InputIterator last,
+                ConnectionOperation const& operation = ConnectionOperation::Absolute,
+                ConnectionDisposition const& disposition = ConnectionDisposition::Tally);
+
+            /**
+             * Replaces the contents of this collection with all GlowConnection
+             * objects contained in @p sequence.
+             * @param sequence The node based connection sequence to copy.
+             */
+            void assign(dom::Sequence const& sequence);
+
+            /** Removes all connections from this collection. */
+            void clear();
+
+            /**
+             * Returns the number of connections in this collection.
+             * @return The number of connections in this collection.
+             */
+            size_type size() const;
+
+            /**
+             * Returns true if this collection contains no connections.
+             * @return True if this collection contains no connections.
+             */
+            bool empty() const;
+
+            /**
+             * Returns the target number of the connection at @p index.
+             * @param index The index of the connection.
+             * @return The target number.
+             */
+            int target(size_type index) const;
+
+            /**
+             * Returns an iterator pointing to the first source of the connection at @p index.
+             * @param index The index of the connection.
+             * @return An iterator pointing to the first source number.
+             */
+            const_source_iterator sourcesBegin(size_type index) const;
+
+            /**
+             * Returns an iterator pointing one past the last source of the connection at @p index.
+             * @param index The index of the connection.
+             * @return An iterator pointing one past the last source number.
+             */
+            const_source_iterator sourcesEnd(size_type index) const;
+
+            /**
+             * Returns the operation of the connection at @p index.
+             * @param index The index of the connection.
+             * @return The connection operation.
+             */
+            ConnectionOperation operation(size_type index) const;
+
+            /**
+             * Returns the disposition of the connection at @p index.
+             * @param index The index of the connection.
+             * @return The connection disposition.
+             */
+            ConnectionDisposition disposition(size_type index) const;
+
+            /**
+             * Creates a node based sequence containing a GlowConnection for each
+             * connection of this collection. The returned sequence uses the
+             * application tag of this collection and has no parent. The caller
+             * takes ownership of the returned object.
+             * @return The node based representation of this collection.
+             */
+            dom::Sequence* toSequence() const;
+
+        public:
+            /** @see Node::clone() */
+            virtual GlowCompactConnectionCollection* clone() const;
+
+        protected:
+            /** @see Node::typeTagImpl() */
+            virtual ber::Tag typeTagImpl() const;
+
+            /** @see Node::updateImpl() */
+            virtual void updateImpl() const;
+
+            /** @see Node::encodeImpl() */
+            virtual void encodeImpl(libember::util::OctetStream& output) const;
+
+            /** @see Node::encodedLengthImpl() */
+            virtual std::size_t encodedLengthImpl() const;
+
+        private:
+            /**
+             * Appends the row for a new connection, after its sources have
+             * been appended to the source array.
+             */
+            void insertRow(int target, ConnectionOperation const& operation, ConnectionDisposition const& disposition);
+
+            /**
+             * Returns the number of bytes the contents of the connection at
+             * @p index require, excluding the element frame.
+             * @param index The index of the connection.
+             * @return The encoded length of the connection contents.
+             */
+            std::size_t connectionLength(size_type index) const;
+
+        private:
+            std::vector<int> m_targets;
+            std::vector<size_type> m_offsets;
+            std::vector<source_type> m_sources;
+            std::vector<ConnectionOperation::value_type> m_operations;
+            std::vector<ConnectionDisposition::value_type> m_dispositions;
+            mutable std::size_t m_cachedPayloadLength;
+            mutable std::size_t m_cachedLength;
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename InputIterator>
+    inline void GlowCompactConnectionCollection::insert(
+        int target,
+        InputIterator first,
+        InputIterator last,
+        ConnectionOperation const& operation,
+        ConnectionDisposition const& disposition)
+    {
+        for (/* Nothing */; first != last; ++first)
+        {
+            m_sources.push_back(static_cast<source_type>(*first));
+        }
+        insertRow(target, operation, disposition);
+    }
+}
+}
+
+#ifdef LIBEMBER_HEADER_ONLY
+#  include "impl/GlowCompactConnectionCollection.ipp"
+#endif
+
+#endif  // __LIBEMBER_GLOW_GLOWCOMPACTCONNECTIONCOLLECTION_HPP
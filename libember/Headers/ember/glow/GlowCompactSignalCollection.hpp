@@ -0,0 +1,168 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_GLOWCOMPACTSIGNALCOLLECTION_HPP
+#define __LIBEMBER_GLOW_GLOWCOMPACTSIGNALCOLLECTION_HPP
+
+#include <vector>
+#include "../dom/Node.hpp"
+#include "../dom/Sequence.hpp"
+#include "GlowType.hpp"
+
+namespace libember { namespace glow
+{
+    /**
+     * Array backed replacement for the sequence of GlowTarget or GlowSource
+     * objects contained in a matrix. Instead of allocating a GlowSignal node
+     * with a child leaf for each signal, only the signal numbers are stored.
+     * The collection encodes to exactly the same BER representation as a
+     * dom::Sequence containing the corresponding GlowTarget or GlowSource
+     * objects.
+     * Since the collection is a leaf of the DOM, it is intended to be used
+     * by providers which send large matrices. Decoded matrices always
+     * contain the node based representation.
+     */
+    class LIBEMBER_API GlowCompactSignalCollection : public dom::Node
+    {
+        typedef std::vector<int> NumberVector;
+
+        public:
+            typedef NumberVector::size_type size_type;
+            typedef NumberVector::const_iterator const_iterator;
+
+        public:
+            /**
+             * Initializes a new, empty signal collection.
+             * @param type The type of the contained signals. Must either be
+             *      GlowType::Target or GlowType::Source.
+             * @param tag The application tag of the collection.
+             */
+            GlowCompactSignalCollection(GlowType const& type, ber::Tag const& tag);
+
+            /**
+             * Returns the type of the signals contained in this collection.
+             * @return The signal type, either GlowType::Target or GlowType::Source.
+             */
+            GlowType const& type() const;
+
+            /**
+             * Reserves the memory required to store @p count signals.
+             * @param count The number of signals to reserve memory for.
+             */
+            void reserve(size_type count);
+
+            /**
+             * Appends a signal to the collection.
+             * @param number The number of the signal to append.
+             */
+            void insert(int number);
+
+            /**
+             * Appends the signal numbers in the range [@p first, @p last) to
+             * the collection.
+             * @param first An iterator pointing to the first signal number.
+             * @param last An iterator pointing one past the last signal number.
+             */
+            template<typename InputIterator>
+            void insert(InputIterator first, InputIterator last);
+
+            /**
+             * Replaces the contents of this collection with the numbers of
+             * all signals of the matching type contained in @p sequence.
+             * @param sequence The node based signal sequence to copy.
+             */
+            void assign(dom::Sequence const& sequence);
+
+            /** Removes all signals from this collection. */
+            void clear();
+
+            /**
+             * Returns the number of signals in this collection.
+             * @return The number of signals in this collection.
+             */
+            size_type size() const;
+
+            /**
+             * Returns true if this collection contains no signals.
+             * @return True if this collection contains no signals.
+             */
+            bool empty() const;
+
+            /**
+             * Returns an iterator pointing to the first signal number.
+             * @return An iterator pointing to the first signal number.
+             */
+            const_iterator begin() const;
+
+            /**
+             * Returns an iterator pointing one past the last signal number.
+             * @return An iterator pointing one past the last signal number.
+             */
+            const_iterator end() const;
+
+            /**
+             * Creates a node based sequence containing a GlowTarget or GlowSource
+             * for each signal of this collection. The returned sequence uses the
+             * application tag of this collection and has no parent. The caller
+             * takes ownership of the returned object.
+             * @return The node based representation of this collection.
+             */
+            dom::Sequence* toSequence() const;
+
+        public:
+            /** @see Node::clone() */
+            virtual GlowCompactSignalCollection* clone() const;
+
+        protected:
+            /** @see Node::typeTagImpl() */
+            virtual ber::Tag typeTagImpl() const;
+
+            /** @see Node::updateImpl() */
+            virtual void updateImpl() const;
+
+            /** @see Node::encodeImpl() */
+            virtual void encodeImpl(libember::util::OctetStream& output) const;
+
+            /** @see Node::encodedLengthImpl() */
+            virtual std::size_t encodedLengthImpl() const;
+
+        private:
+            /**
+             * Returns the number of bytes the contents of a single signal require,
+             * excluding the element frame.
+             * @param number The signal number.
+             * @return The encoded length of the signal contents.
+             */
+            std::size_t signalLength(int number) const;
+
+        private:
+            GlowType m_type;
+            NumberVector m_numbers;
+            mutable std::size_t m_cachedPayloadLength;
+            mutable std::size_t m_cachedLength;
+    };
+
+
+    /**************************************************************************/
+    /* Mandatory inline implementation                                        */
+    /**************************************************************************/
+
+    template<typename InputIterator>
+    inline void GlowCompactSignalCollection::insert(InputIterator first, InputIterator last)
+    {
+        m_numbers.insert(m_numbers.end(), first, last);
+        markDirty();
+    }
+}
+}
+
+#ifdef LIBEMBER_HEADER_ONLY
+#  include "impl/GlowCompactSignalCollection.ipp"
+#endif
+
+#endif  // __LIBEMBER_GLOW_GLOWCOMPACTSIGNALCOLLECTION_HPP
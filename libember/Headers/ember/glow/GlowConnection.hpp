@@ -81,6 +81,23 @@ namespace libember { namespace glow
              */
             ConnectionDisposition disposition() const;
 
+            /**
+             * Computes the sources that have to be connected and disconnected in order
+             * to turn the connection state described by @p previousSources into the
+             * one described by @p sources. The order of the sub-ids is not significant.
+             * @param previousSources The sources that were connected before the change.
+             * @param sources The sources that are connected after the change.
+             * @param connected Receives the sources contained in @p sources but not in
+             *      @p previousSources, in ascending order.
+             * @param disconnected Receives the sources contained in @p previousSources but
+             *      not in @p sources, in ascending order.
+             */
+            static void computeDelta(
+                ber::ObjectIdentifier const& previousSources,
+                ber::ObjectIdentifier const& sources,
+                ber::ObjectIdentifier& connected,
+                ber::ObjectIdentifier& disconnected);
+
         private:
             /**
              * Initializes a new instance of GlowConnection.
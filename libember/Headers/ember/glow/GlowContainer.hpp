@@ -22,6 +22,34 @@ namespace libember { namespace glow
      */
     class LIBEMBER_API GlowContainer : public dom::Sequence
     {
+        public:
+            /**
+             * Returns the passed node as GlowContainer, if it is one. Unlike a
+             * dynamic_cast, this method only inspects the node's category and
+             * type tag, since every node with an application defined type tag
+             * is a GlowContainer.
+             * The concrete type of the returned container can be determined by
+             * calling type(), which allows to static_cast it to the class
+             * that corresponds to that type.
+             * @param node The node to convert.
+             * @return The passed node, or null if it is not a GlowContainer.
+             */
+            static GlowContainer const* fromNode(dom::Node const* node);
+
+            /**
+             * Returns the passed node as GlowContainer, if it is one.
+             * @param node The node to convert.
+             * @return The passed node, or null if it is not a GlowContainer.
+             * @see fromNode(dom::Node const*)
+             */
+            static GlowContainer* fromNode(dom::Node* node);
+
+            /**
+             * Returns the glow type of this container.
+             * @return The glow type of this container.
+             */
+            GlowType type() const;
+
         protected:
             /**
              * Initializes a new container with a glow type and application tag.
@@ -21,6 +21,8 @@
 #include "GlowTarget.hpp"
 #include "GlowSource.hpp"
 #include "GlowConnection.hpp"
+#include "GlowCompactSignalCollection.hpp"
+#include "GlowCompactConnectionCollection.hpp"
 
 namespace libember { namespace glow
 {
@@ -135,6 +137,8 @@ namespace libember { namespace glow
             /**
              * Returns a modifiable sequence collection that contains the targets.
              * The element will be inserted if it doesn't already exist.
+             * If the targets are currently stored in a compact collection, they are
+             * converted into the node based representation first.
              * @return The target collection.
              */
             dom::Sequence* targets();
@@ -142,6 +146,8 @@ namespace libember { namespace glow
             /**
              * Returns a modifiable sequence collection that contains the sources.
              * The element will be inserted if it doesn't already exist.
+             * If the sources are currently stored in a compact collection, they are
+             * converted into the node based representation first.
              * @return The source collection.
              */
             dom::Sequence* sources();
@@ -149,10 +155,59 @@ namespace libember { namespace glow
             /**
              * Returns a modifiable sequence collection that contains the connections.
              * The element will be inserted if it doesn't already exist.
+             * If the connections are currently stored in a compact collection, they are
+             * converted into the node based representation first.
              * @return The connection collection.
              */
             dom::Sequence* connections();
 
+            /**
+             * Returns the compact target collection, which stores the target numbers
+             * without allocating a GlowTarget for each of them. The collection will
+             * be inserted if it doesn't already exist. If the matrix contains a node
+             * based target sequence, its targets are moved into the compact collection.
+             * @return The compact target collection.
+             */
+            GlowCompactSignalCollection* compactTargets();
+
+            /**
+             * Returns the compact source collection, which stores the source numbers
+             * without allocating a GlowSource for each of them. The collection will
+             * be inserted if it doesn't already exist. If the matrix contains a node
+             * based source sequence, its sources are moved into the compact collection.
+             * @return The compact source collection.
+             */
+            GlowCompactSignalCollection* compactSources();
+
+            /**
+             * Returns the compact connection collection, which stores the connections
+             * without allocating a GlowConnection for each of them. The collection will
+             * be inserted if it doesn't already exist. If the matrix contains a node
+             * based connection sequence, its connections are moved into the compact
+             * collection.
+             * @return The compact connection collection.
+             */
+            GlowCompactConnectionCollection* compactConnections();
+
+            /**
+             * Appends the connection state of a single target to the connections sequence.
+             * The change from @p previousSources to @p sources is either reported as one
+             * absolute GlowConnection or as a pair of GlowConnections using the operations
+             * ConnectionOperation::Disconnect and ConnectionOperation::Connect, depending
+             * on which representation requires fewer bytes when encoded.
+             * @param target The number of the target whose connection state changed.
+             * @param previousSources The sources that were connected to @p target before
+             *      the change.
+             * @param sources The sources that are currently connected to @p target.
+             * @param disposition The disposition to report with each inserted connection.
+             * @return The number of GlowConnection objects that have been inserted.
+             */
+            size_type insertConnectionChange(
+                int target,
+                ber::ObjectIdentifier const& previousSources,
+                ber::ObjectIdentifier const& sources,
+                ConnectionDisposition const& disposition);
+
             /**
              * Returns the identifier string.
              * @return The identifier string.
@@ -253,6 +308,8 @@ namespace libember { namespace glow
              * Returns the constant target collection. If no targets are present,
              * this method returns null.
              * @return Sequence containing the targets of this matrix.
+             * @note If the targets are stored in a compact collection, this method
+             *      returns null as well. Use compactTargets() to access them.
              */
             dom::Sequence const* targets() const;
 
@@ -267,6 +324,8 @@ namespace libember { namespace glow
              * Returns the constant source collection. If no sources are present,
              * this method returns null.
              * @return Sequence containing the sources of this matrix.
+             * @note If the sources are stored in a compact collection, this method
+             *      returns null as well. Use compactSources() to access them.
              */
             dom::Sequence const* sources() const;
 
@@ -281,6 +340,8 @@ namespace libember { namespace glow
              * Returns the constant connection collection. If no connections are present,
              * this method returns null.
              * @return Sequence containing the connections of this matrix.
+             * @note If the connections are stored in a compact collection, this method
+             *      returns null as well. Use compactConnections() to access them.
              */
             dom::Sequence const* connections() const;
 
@@ -291,6 +352,27 @@ namespace libember { namespace glow
             template<typename OutputIterator>
             size_type typedConnections(OutputIterator dest) const;
 
+            /**
+             * Returns the constant compact target collection. If the targets are not
+             * stored in a compact collection, this method returns null.
+             * @return The compact target collection of this matrix.
+             */
+            GlowCompactSignalCollection const* compactTargets() const;
+
+            /**
+             * Returns the constant compact source collection. If the sources are not
+             * stored in a compact collection, this method returns null.
+             * @return The compact source collection of this matrix.
+             */
+            GlowCompactSignalCollection const* compactSources() const;
+
+            /**
+             * Returns the constant compact connection collection. If the connections are
+             * not stored in a compact collection, this method returns null.
+             * @return The compact connection collection of this matrix.
+             */
+            GlowCompactConnectionCollection const* compactConnections() const;
+
             /**
              * Returns the object identifier of the template reference. If not present,
              * an empty oid is being returned.
@@ -317,6 +399,27 @@ namespace libember { namespace glow
                 ber::Tag const& sourcesTag,
                 ber::Tag const& connectionsTag);
 
+        private:
+            /**
+             * Returns the node based sequence with the application tag @p tag. If the
+             * matrix contains a compact collection with that tag, it is replaced by its
+             * node based representation. If neither exists, a new sequence is inserted.
+             * @param tag The application tag of the sequence.
+             * @return The node based sequence.
+             */
+            dom::Sequence* findOrInsertSequence(ber::Tag const& tag);
+
+            /**
+             * Returns the compact signal collection with the application tag @p tag. If
+             * the matrix contains a node based sequence with that tag, it is replaced by
+             * a compact collection containing the same signals. If neither exists, a new
+             * collection is inserted.
+             * @param type The signal type, either GlowType::Target or GlowType::Source.
+             * @param tag The application tag of the collection.
+             * @return The compact signal collection.
+             */
+            GlowCompactSignalCollection* findOrInsertCompactSignals(GlowType const& type, ber::Tag const& tag);
+
         private:
             ber::Tag m_childrenTag;
             ber::Tag m_targetsTag;
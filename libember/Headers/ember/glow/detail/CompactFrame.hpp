@@ -0,0 +1,136 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_DETAIL_COMPACTFRAME_HPP
+#define __LIBEMBER_GLOW_DETAIL_COMPACTFRAME_HPP
+
+#include "../../ber/Encoding.hpp"
+#include "../../ber/ObjectIdentifier.hpp"
+#include "../../ber/detail/MultiByte.hpp"
+#include "../../util/OctetStream.hpp"
+
+namespace libember { namespace glow { namespace detail
+{
+    /**
+     * Return the number of bytes a container frame with the application tag
+     * @p tag and a payload of @p payloadLength bytes requires when encoded.
+     * @param tag the tag of the frame. It is encoded as container tag.
+     * @param payloadLength the number of bytes of the frame payload.
+     * @return The encoded length of the entire frame.
+     */
+    inline std::size_t containerFrameLength(ber::Tag const& tag, std::size_t payloadLength)
+    {
+        return ber::encodedLength(tag.toContainer()) + ber::encodedLength(ber::make_length(payloadLength)) + payloadLength;
+    }
+
+    /**
+     * Encode the header of a container frame, which consists of the container
+     * tag and the length of the payload that follows.
+     * @param output a reference to the octet stream to which the header should
+     *      be encoded.
+     * @param tag the tag of the frame. It is encoded as container tag.
+     * @param payloadLength the number of bytes of the frame payload.
+     */
+    inline void encodeContainerHeader(libember::util::OctetStream& output, ber::Tag const& tag, std::size_t payloadLength)
+    {
+        ber::encode(output, tag.toContainer());
+        ber::encode(output, ber::make_length(payloadLength));
+    }
+
+    /**
+     * Return the number of bytes an integer leaf with the application tag
+     * @p tag requires, when encoded the same way as a dom::VariantLeaf.
+     * @param tag the application tag of the leaf.
+     * @param value the value of the leaf.
+     * @return The encoded length of the leaf.
+     */
+    inline std::size_t integerLeafLength(ber::Tag const& tag, int value)
+    {
+        return containerFrameLength(tag, ber::encodedFrameLength(value));
+    }
+
+    /**
+     * Encode an integer leaf with the application tag @p tag the same way
+     * as a dom::VariantLeaf.
+     * @param output a reference to the octet stream to which the leaf should
+     *      be encoded.
+     * @param tag the application tag of the leaf.
+     * @param value the value of the leaf.
+     */
+    inline void encodeIntegerLeaf(libember::util::OctetStream& output, ber::Tag const& tag, int value)
+    {
+        encodeContainerHeader(output, tag, ber::encodedFrameLength(value));
+        ber::encodeFrame(output, value);
+    }
+
+    /**
+     * Return the number of bytes the relative object identifier consisting of
+     * the sub-identifiers in the range [@p first, @p last) requires when
+     * encoded, without the frame header.
+     * @param first an iterator pointing to the first sub-identifier.
+     * @param last an iterator pointing one past the last sub-identifier.
+     * @return The encoded length of the object identifier payload.
+     */
+    template<typename InputIterator>
+    inline std::size_t relativeOidLength(InputIterator first, InputIterator last)
+    {
+        std::size_t length = 0;
+        for (/* Nothing */; first != last; ++first)
+        {
+            length += ber::detail::getMultiByteEncodedLength(static_cast<ber::ObjectIdentifier::value_type>(*first));
+        }
+        return length;
+    }
+
+    /**
+     * Return the number of bytes a relative object identifier leaf with the
+     * application tag @p tag requires, when encoded the same way as a
+     * dom::VariantLeaf containing a ber::ObjectIdentifier.
+     * @param tag the application tag of the leaf.
+     * @param first an iterator pointing to the first sub-identifier.
+     * @param last an iterator pointing one past the last sub-identifier.
+     * @return The encoded length of the leaf.
+     */
+    template<typename InputIterator>
+    inline std::size_t relativeOidLeafLength(ber::Tag const& tag, InputIterator first, InputIterator last)
+    {
+        std::size_t const payloadLength = relativeOidLength(first, last);
+        ber::Tag const innerTag = ber::universalTag<ber::ObjectIdentifier>();
+        std::size_t const innerLength = ber::encodedLength(innerTag) + ber::encodedLength(ber::make_length(payloadLength)) + payloadLength;
+        return containerFrameLength(tag, innerLength);
+    }
+
+    /**
+     * Encode a relative object identifier leaf with the application tag @p tag
+     * the same way as a dom::VariantLeaf containing a ber::ObjectIdentifier.
+     * @param output a reference to the octet stream to which the leaf should
+     *      be encoded.
+     * @param tag the application tag of the leaf.
+     * @param first an iterator pointing to the first sub-identifier.
+     * @param last an iterator pointing one past the last sub-identifier.
+     */
+    template<typename InputIterator>
+    inline void encodeRelativeOidLeaf(libember::util::OctetStream& output, ber::Tag const& tag, InputIterator first, InputIterator last)
+    {
+        std::size_t const payloadLength = relativeOidLength(first, last);
+        ber::Tag const innerTag = ber::universalTag<ber::ObjectIdentifier>();
+        std::size_t const innerLength = ber::encodedLength(innerTag) + ber::encodedLength(ber::make_length(payloadLength)) + payloadLength;
+
+        encodeContainerHeader(output, tag, innerLength);
+        ber::encode(output, innerTag);
+        ber::encode(output, ber::make_length(payloadLength));
+        for (/* Nothing */; first != last; ++first)
+        {
+            ber::detail::encodeMultibyte(output, static_cast<ber::ObjectIdentifier::value_type>(*first));
+        }
+    }
+}
+}
+}
+
+#endif  // __LIBEMBER_GLOW_DETAIL_COMPACTFRAME_HPP
@@ -0,0 +1,245 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_GLOWCOMPACTCONNECTIONCOLLECTION_IPP
+#define __LIBEMBER_GLOW_GLOWCOMPACTCONNECTIONCOLLECTION_IPP
+
+#include "../../util/Inline.hpp"
+#include "../detail/CompactFrame.hpp"
+#include "../GlowConnection.hpp"
+#include "../GlowTags.hpp"
+#include "../GlowType.hpp"
+
+namespace libember { namespace glow
+{
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection::GlowCompactConnectionCollection(ber::Tag const& tag)
+        : dom::Node(tag)
+        , m_targets()
+        , m_offsets(1, 0)
+        , m_sources()
+        , m_operations()
+        , m_dispositions()
+        , m_cachedPayloadLength(0)
+        , m_cachedLength(0)
+    {}
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::reserve(size_type connectionCount, size_type sourceCount)
+    {
+        m_targets.reserve(connectionCount);
+        m_offsets.reserve(connectionCount + 1);
+        m_operations.reserve(connectionCount);
+        m_dispositions.reserve(connectionCount);
+        m_sources.reserve(sourceCount);
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::insert(int target)
+    {
+        insertRow(target, ConnectionOperation::Absolute, ConnectionDisposition::Tally);
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::insertRow(int target, ConnectionOperation const& operation, ConnectionDisposition const& disposition)
+    {
+        m_targets.push_back(target);
+        m_offsets.push_back(m_sources.size());
+        m_operations.push_back(operation.value());
+        m_dispositions.push_back(disposition.value());
+        markDirty();
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::assign(dom::Sequence const& sequence)
+    {
+        clear();
+
+        dom::Sequence::const_iterator first = sequence.begin();
+        dom::Sequence::const_iterator const last = sequence.end();
+        for (/* Nothing */; first != last; ++first)
+        {
+            GlowConnection const* connection = dynamic_cast<GlowConnection const*>(&*first);
+            if (connection != 0)
+            {
+                ber::ObjectIdentifier const sources = connection->sources();
+                insert(connection->target(), sources.begin(), sources.end(), connection->operation(), connection->disposition());
+            }
+        }
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::clear()
+    {
+        m_targets.clear();
+        m_offsets.assign(1, 0);
+        m_sources.clear();
+        m_operations.clear();
+        m_dispositions.clear();
+        markDirty();
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection::size_type GlowCompactConnectionCollection::size() const
+    {
+        return m_targets.size();
+    }
+
+    LIBEMBER_INLINE
+    bool GlowCompactConnectionCollection::empty() const
+    {
+        return m_targets.empty();
+    }
+
+    LIBEMBER_INLINE
+    int GlowCompactConnectionCollection::target(size_type index) const
+    {
+        return m_targets[index];
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection::const_source_iterator GlowCompactConnectionCollection::sourcesBegin(size_type index) const
+    {
+        return m_sources.begin() + m_offsets[index];
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection::const_source_iterator GlowCompactConnectionCollection::sourcesEnd(size_type index) const
+    {
+        return m_sources.begin() + m_offsets[index + 1];
+    }
+
+    LIBEMBER_INLINE
+    ConnectionOperation GlowCompactConnectionCollection::operation(size_type index) const
+    {
+        return ConnectionOperation(m_operations[index]);
+    }
+
+    LIBEMBER_INLINE
+    ConnectionDisposition GlowCompactConnectionCollection::disposition(size_type index) const
+    {
+        return ConnectionDisposition(m_dispositions[index]);
+    }
+
+    LIBEMBER_INLINE
+    dom::Sequence* GlowCompactConnectionCollection::toSequence() const
+    {
+        dom::Sequence* sequence = new dom::Sequence(applicationTag());
+        size_type const count = size();
+        for (size_type index = 0; index < count; ++index)
+        {
+            GlowConnection* connection = new GlowConnection(m_targets[index]);
+            if (m_offsets[index] != m_offsets[index + 1])
+            {
+                connection->setSources(ber::ObjectIdentifier(sourcesBegin(index), sourcesEnd(index)));
+            }
+            if (m_operations[index] != ConnectionOperation::Absolute)
+            {
+                connection->setOperation(operation(index));
+            }
+            if (m_dispositions[index] != ConnectionDisposition::Tally)
+            {
+                connection->setDisposition(disposition(index));
+            }
+            sequence->insert(sequence->end(), connection);
+        }
+        return sequence;
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection* GlowCompactConnectionCollection::clone() const
+    {
+        return new GlowCompactConnectionCollection(*this);
+    }
+
+    LIBEMBER_INLINE
+    ber::Tag GlowCompactConnectionCollection::typeTagImpl() const
+    {
+        return ber::make_tag(ber::Class::Universal, ber::Type::Sequence);
+    }
+
+    LIBEMBER_INLINE
+    std::size_t GlowCompactConnectionCollection::connectionLength(size_type index) const
+    {
+        std::size_t length = detail::integerLeafLength(GlowTags::Connection::Target(), m_targets[index]);
+        if (m_offsets[index] != m_offsets[index + 1])
+        {
+            length += detail::relativeOidLeafLength(GlowTags::Connection::Sources(), sourcesBegin(index), sourcesEnd(index));
+        }
+        if (m_operations[index] != ConnectionOperation::Absolute)
+        {
+            length += detail::integerLeafLength(GlowTags::Connection::Operation(), m_operations[index]);
+        }
+        if (m_dispositions[index] != ConnectionDisposition::Tally)
+        {
+            length += detail::integerLeafLength(GlowTags::Connection::Disposition(), m_dispositions[index]);
+        }
+        return length;
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::updateImpl() const
+    {
+        ber::Tag const elementTag = GlowTags::ElementDefault();
+        ber::Tag const connectionTag = GlowType(GlowType::Connection).toTypeTag();
+        std::size_t payloadLength = 0;
+        size_type const count = size();
+        for (size_type index = 0; index < count; ++index)
+        {
+            std::size_t const connectionFrameLength = detail::containerFrameLength(connectionTag, connectionLength(index));
+            payloadLength += detail::containerFrameLength(elementTag, connectionFrameLength);
+        }
+
+        std::size_t const innerLength = detail::containerFrameLength(typeTag(), payloadLength);
+        m_cachedPayloadLength = payloadLength;
+        m_cachedLength = detail::containerFrameLength(applicationTag(), innerLength);
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactConnectionCollection::encodeImpl(libember::util::OctetStream& output) const
+    {
+        ber::Tag const elementTag = GlowTags::ElementDefault();
+        ber::Tag const connectionTag = GlowType(GlowType::Connection).toTypeTag();
+        ber::Tag const innerTag = typeTag();
+
+        detail::encodeContainerHeader(output, applicationTag(), detail::containerFrameLength(innerTag, m_cachedPayloadLength));
+        detail::encodeContainerHeader(output, innerTag, m_cachedPayloadLength);
+
+        size_type const count = size();
+        for (size_type index = 0; index < count; ++index)
+        {
+            std::size_t const length = connectionLength(index);
+
+            detail::encodeContainerHeader(output, elementTag, detail::containerFrameLength(connectionTag, length));
+            detail::encodeContainerHeader(output, connectionTag, length);
+            detail::encodeIntegerLeaf(output, GlowTags::Connection::Target(), m_targets[index]);
+
+            if (m_offsets[index] != m_offsets[index + 1])
+            {
+                detail::encodeRelativeOidLeaf(output, GlowTags::Connection::Sources(), sourcesBegin(index), sourcesEnd(index));
+            }
+            if (m_operations[index] != ConnectionOperation::Absolute)
+            {
+                detail::encodeIntegerLeaf(output, GlowTags::Connection::Operation(), m_operations[index]);
+            }
+            if (m_dispositions[index] != ConnectionDisposition::Tally)
+            {
+                detail::encodeIntegerLeaf(output, GlowTags::Connection::Disposition(), m_dispositions[index]);
+            }
+        }
+    }
+
+    LIBEMBER_INLINE
+    std::size_t GlowCompactConnectionCollection::encodedLengthImpl() const
+    {
+        return m_cachedLength;
+    }
+}
+}
+
+#endif  // __LIBEMBER_GLOW_GLOWCOMPACTCONNECTIONCOLLECTION_IPP
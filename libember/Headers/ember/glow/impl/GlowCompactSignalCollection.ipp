@@ -0,0 +1,187 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBEMBER_GLOW_GLOWCOMPACTSIGNALCOLLECTION_IPP
+#define __LIBEMBER_GLOW_GLOWCOMPACTSIGNALCOLLECTION_IPP
+
+#include "../../util/Inline.hpp"
+#include "../detail/CompactFrame.hpp"
+#include "../GlowSource.hpp"
+#include "../GlowTags.hpp"
+#include "../GlowTarget.hpp"
+
+namespace libember { namespace glow
+{
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection::GlowCompactSignalCollection(GlowType const& type, ber::Tag const& tag)
+        : dom::Node(tag)
+        , m_type(type)
+        , m_numbers()
+        , m_cachedPayloadLength(0)
+        , m_cachedLength(0)
+    {}
+
+    LIBEMBER_INLINE
+    GlowType const& GlowCompactSignalCollection::type() const
+    {
+        return m_type;
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactSignalCollection::reserve(size_type count)
+    {
+        m_numbers.reserve(count);
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactSignalCollection::insert(int number)
+    {
+        m_numbers.push_back(number);
+        markDirty();
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactSignalCollection::assign(dom::Sequence const& sequence)
+    {
+        NumberVector numbers;
+        dom::Sequence::const_iterator first = sequence.begin();
+        dom::Sequence::const_iterator const last = sequence.end();
+        for (/* Nothing */; first != last; ++first)
+        {
+            GlowSignal const* signal = dynamic_cast<GlowSignal const*>(&*first);
+            if (signal != 0 && signal->typeTag() == m_type.toTypeTag())
+            {
+                numbers.push_back(signal->number());
+            }
+        }
+
+        m_numbers.swap(numbers);
+        markDirty();
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactSignalCollection::clear()
+    {
+        m_numbers.clear();
+        markDirty();
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection::size_type GlowCompactSignalCollection::size() const
+    {
+        return m_numbers.size();
+    }
+
+    LIBEMBER_INLINE
+    bool GlowCompactSignalCollection::empty() const
+    {
+        return m_numbers.empty();
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection::const_iterator GlowCompactSignalCollection::begin() const
+    {
+        return m_numbers.begin();
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection::const_iterator GlowCompactSignalCollection::end() const
+    {
+        return m_numbers.end();
+    }
+
+    LIBEMBER_INLINE
+    dom::Sequence* GlowCompactSignalCollection::toSequence() const
+    {
+        bool const isTarget = (m_type.value() == GlowType::Target);
+        dom::Sequence* sequence = new dom::Sequence(applicationTag());
+        const_iterator first = m_numbers.begin();
+        const_iterator const last = m_numbers.end();
+        for (/* Nothing */; first != last; ++first)
+        {
+            if (isTarget)
+            {
+                sequence->insert(sequence->end(), new GlowTarget(*first));
+            }
+            else
+            {
+                sequence->insert(sequence->end(), new GlowSource(*first));
+            }
+        }
+        return sequence;
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection* GlowCompactSignalCollection::clone() const
+    {
+        return new GlowCompactSignalCollection(*this);
+    }
+
+    LIBEMBER_INLINE
+    ber::Tag GlowCompactSignalCollection::typeTagImpl() const
+    {
+        return ber::make_tag(ber::Class::Universal, ber::Type::Sequence);
+    }
+
+    LIBEMBER_INLINE
+    std::size_t GlowCompactSignalCollection::signalLength(int number) const
+    {
+        std::size_t const numberLength = detail::integerLeafLength(GlowTags::Signal::Number(), number);
+        return detail::containerFrameLength(m_type.toTypeTag(), numberLength);
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactSignalCollection::updateImpl() const
+    {
+        ber::Tag const elementTag = GlowTags::ElementDefault();
+        std::size_t payloadLength = 0;
+        const_iterator first = m_numbers.begin();
+        const_iterator const last = m_numbers.end();
+        for (/* Nothing */; first != last; ++first)
+        {
+            payloadLength += detail::containerFrameLength(elementTag, signalLength(*first));
+        }
+
+        std::size_t const innerLength = detail::containerFrameLength(typeTag(), payloadLength);
+        m_cachedPayloadLength = payloadLength;
+        m_cachedLength = detail::containerFrameLength(applicationTag(), innerLength);
+    }
+
+    LIBEMBER_INLINE
+    void GlowCompactSignalCollection::encodeImpl(libember::util::OctetStream& output) const
+    {
+        ber::Tag const elementTag = GlowTags::ElementDefault();
+        ber::Tag const signalTag = m_type.toTypeTag();
+        ber::Tag const numberTag = GlowTags::Signal::Number();
+        ber::Tag const innerTag = typeTag();
+
+        detail::encodeContainerHeader(output, applicationTag(), detail::containerFrameLength(innerTag, m_cachedPayloadLength));
+        detail::encodeContainerHeader(output, innerTag, m_cachedPayloadLength);
+
+        const_iterator first = m_numbers.begin();
+        const_iterator const last = m_numbers.end();
+        for (/* Nothing */; first != last; ++first)
+        {
+            int const number = *first;
+            std::size_t const numberLength = detail::integerLeafLength(numberTag, number);
+
+            detail::encodeContainerHeader(output, elementTag, detail::containerFrameLength(signalTag, numberLength));
+            detail::encodeContainerHeader(output, signalTag, numberLength);
+            detail::encodeIntegerLeaf(output, numberTag, number);
+        }
+    }
+
+    LIBEMBER_INLINE
+    std::size_t GlowCompactSignalCollection::encodedLengthImpl() const
+    {
+        return m_cachedLength;
+    }
+}
+}
+
+#endif  // __LIBEMBER_GLOW_GLOWCOMPACTSIGNALCOLLECTION_IPP
@@ -9,6 +9,9 @@
 #ifndef __LIBEMBER_GLOW_GLOWCONNECTION_IPP
 #define __LIBEMBER_GLOW_GLOWCONNECTION_IPP
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
 #include "../../util/Inline.hpp"
 #include "../util/ValueConverter.hpp"
 
@@ -123,6 +126,24 @@ namespace libember { namespace glow
             return ConnectionDisposition::Tally;
         }
     }
+
+    LIBEMBER_INLINE
+    void GlowConnection::computeDelta(
+        ber::ObjectIdentifier const& previousSources,
+        ber::ObjectIdentifier const& sources,
+        ber::ObjectIdentifier& connected,
+        ber::ObjectIdentifier& disconnected)
+    {
+        typedef std::vector<ber::ObjectIdentifier::value_type> SubidVector;
+
+        SubidVector previous(previousSources.begin(), previousSources.end());
+        SubidVector current(sources.begin(), sources.end());
+        std::sort(previous.begin(), previous.end());
+        std::sort(current.begin(), current.end());
+
+        std::set_difference(current.begin(), current.end(), previous.begin(), previous.end(), std::back_inserter(connected));
+        std::set_difference(previous.begin(), previous.end(), current.begin(), current.end(), std::back_inserter(disconnected));
+    }
 }
 }
 
@@ -26,6 +26,28 @@ namespace libember { namespace glow
         , m_universalTag(type.toTypeTag())
     {}
 
+    LIBEMBER_INLINE
+    GlowContainer const* GlowContainer::fromNode(dom::Node const* node)
+    {
+        return (node != 0
+            &&  node->kind() == dom::Node::ContainerKind
+            &&  node->typeTag().getClass() == ber::Class::Application)
+            ? static_cast<GlowContainer const*>(node)
+            : 0;
+    }
+
+    LIBEMBER_INLINE
+    GlowContainer* GlowContainer::fromNode(dom::Node* node)
+    {
+        return const_cast<GlowContainer*>(fromNode(static_cast<dom::Node const*>(node)));
+    }
+
+    LIBEMBER_INLINE
+    GlowType GlowContainer::type() const
+    {
+        return GlowType(static_cast<GlowType::value_type>(m_universalTag.number()));
+    }
+
     LIBEMBER_INLINE
     GlowContainer::iterator GlowContainer::insertImpl(iterator const&, Node* child)
     {
@@ -157,55 +157,198 @@ namespace libember { namespace glow
 
     LIBEMBER_INLINE
     dom::Sequence* GlowMatrixBase::targets()
+    {
+        return findOrInsertSequence(m_targetsTag);
+    }
+
+    LIBEMBER_INLINE
+    dom::Sequence* GlowMatrixBase::sources()
+    {
+        return findOrInsertSequence(m_sourcesTag);
+    }
+
+    LIBEMBER_INLINE
+    dom::Sequence* GlowMatrixBase::connections()
+    {
+        return findOrInsertSequence(m_connectionsTag);
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection* GlowMatrixBase::compactTargets()
+    {
+        return findOrInsertCompactSignals(GlowType::Target, m_targetsTag);
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection* GlowMatrixBase::compactSources()
+    {
+        return findOrInsertCompactSignals(GlowType::Source, m_sourcesTag);
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection* GlowMatrixBase::compactConnections()
     {
         iterator const first = begin();
         iterator const last = end();
-        iterator const result = util::find_tag(first, last, m_targetsTag);
+        iterator const result = util::find_tag(first, last, m_connectionsTag);
+        GlowCompactConnectionCollection* collection = 0;
         if (result != last)
         {
-            return dynamic_cast<dom::Sequence*>(&*result);
+            collection = dynamic_cast<GlowCompactConnectionCollection*>(&*result);
+            if (collection != 0)
+            {
+                return collection;
+            }
+
+            collection = new GlowCompactConnectionCollection(m_connectionsTag);
+            dom::Sequence const* sequence = dynamic_cast<dom::Sequence const*>(&*result);
+            if (sequence != 0)
+            {
+                collection->assign(*sequence);
+            }
+            erase(result);
         }
         else
         {
-            dom::Sequence* collection = new dom::Sequence(m_targetsTag);
-            insert(last, collection);
-            return collection;
+            collection = new GlowCompactConnectionCollection(m_connectionsTag);
         }
+
+        insert(end(), collection);
+        return collection;
     }
 
     LIBEMBER_INLINE
-    dom::Sequence* GlowMatrixBase::sources()
+    dom::Sequence* GlowMatrixBase::findOrInsertSequence(ber::Tag const& tag)
     {
         iterator const first = begin();
         iterator const last = end();
-        iterator const result = util::find_tag(first, last, m_sourcesTag);
+        iterator const result = util::find_tag(first, last, tag);
+        dom::Sequence* collection = 0;
         if (result != last)
         {
-            return dynamic_cast<dom::Sequence*>(&*result);
+            collection = dynamic_cast<dom::Sequence*>(&*result);
+            if (collection != 0)
+            {
+                return collection;
+            }
+
+            if (GlowCompactSignalCollection const* signalCollection = dynamic_cast<GlowCompactSignalCollection const*>(&*result))
+            {
+                collection = signalCollection->toSequence();
+            }
+            else if (GlowCompactConnectionCollection const* connectionCollection = dynamic_cast<GlowCompactConnectionCollection const*>(&*result))
+            {
+                collection = connectionCollection->toSequence();
+            }
+            else
+            {
+                collection = new dom::Sequence(tag);
+            }
+            erase(result);
         }
         else
         {
-            dom::Sequence* collection = new dom::Sequence(m_sourcesTag);
-            insert(last, collection);
-            return collection;
+            collection = new dom::Sequence(tag);
         }
+
+        insert(end(), collection);
+        return collection;
     }
 
     LIBEMBER_INLINE
-    dom::Sequence* GlowMatrixBase::connections()
+    GlowCompactSignalCollection* GlowMatrixBase::findOrInsertCompactSignals(GlowType const& type, ber::Tag const& tag)
     {
         iterator const first = begin();
         iterator const last = end();
-        iterator const result = util::find_tag(first, last, m_connectionsTag);
+        iterator const result = util::find_tag(first, last, tag);
+        GlowCompactSignalCollection* collection = 0;
         if (result != last)
         {
-            return dynamic_cast<dom::Sequence*>(&*result);
+            collection = dynamic_cast<GlowCompactSignalCollection*>(&*result);
+            if (collection != 0)
+            {
+                return collection;
+            }
+
+            collection = new GlowCompactSignalCollection(type, tag);
+            dom::Sequence const* sequence = dynamic_cast<dom::Sequence const*>(&*result);
+            if (sequence != 0)
+            {
+                collection->assign(*sequence);
+            }
+            erase(result);
         }
         else
         {
-            dom::Sequence* collection = new dom::Sequence(m_connectionsTag);
-            insert(last, collection);
-            return collection;
+            collection = new GlowCompactSignalCollection(type, tag);
+        }
+
+        insert(end(), collection);
+        return collection;
+    }
+
+    LIBEMBER_INLINE
+    GlowContainer::size_type GlowMatrixBase::insertConnectionChange(
+        int target,
+        ber::ObjectIdentifier const& previousSources,
+        ber::ObjectIdentifier const& sources,
+        ConnectionDisposition const& disposition)
+    {
+        ber::ObjectIdentifier connected;
+        ber::ObjectIdentifier disconnected;
+        GlowConnection::computeDelta(previousSources, sources, connected, disconnected);
+
+        dom::Sequence* const connections = this->connections();
+        GlowConnection* const absolute = new GlowConnection(target);
+        absolute->setSources(sources);
+        absolute->setDisposition(disposition);
+
+        if (connected.empty() && disconnected.empty())
+        {
+            connections->insert(connections->end(), absolute);
+            return 1;
+        }
+
+        GlowConnection* delta[2] = { 0, 0 };
+        size_type deltaCount = 0;
+        std::size_t deltaLength = 0;
+
+        if (disconnected.empty() == false)
+        {
+            GlowConnection* const connection = new GlowConnection(target);
+            connection->setSources(disconnected);
+            connection->setOperation(ConnectionOperation::Disconnect);
+            connection->setDisposition(disposition);
+            deltaLength += connection->encodedLength();
+            delta[deltaCount++] = connection;
+        }
+
+        if (connected.empty() == false)
+        {
+            GlowConnection* const connection = new GlowConnection(target);
+            connection->setSources(connected);
+            connection->setOperation(ConnectionOperation::Connect);
+            connection->setDisposition(disposition);
+            deltaLength += connection->encodedLength();
+            delta[deltaCount++] = connection;
+        }
+
+        if (absolute->encodedLength() <= deltaLength)
+        {
+            for (size_type index = 0; index < deltaCount; ++index)
+                delete delta[index];
+
+            connections->insert(connections->end(), absolute);
+            return 1;
+        }
+        else
+        {
+            delete absolute;
+
+            for (size_type index = 0; index < deltaCount; ++index)
+                connections->insert(connections->end(), delta[index]);
+
+            return deltaCount;
         }
     }
 
@@ -368,6 +511,54 @@ namespace libember { namespace glow
         }
     }
 
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection const* GlowMatrixBase::compactTargets() const
+    {
+        const_iterator const first = begin();
+        const_iterator const last = end();
+        const_iterator const result = util::find_tag(first, last, m_targetsTag);
+        if (result != last)
+        {
+            return dynamic_cast<GlowCompactSignalCollection const*>(&*result);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactSignalCollection const* GlowMatrixBase::compactSources() const
+    {
+        const_iterator const first = begin();
+        const_iterator const last = end();
+        const_iterator const result = util::find_tag(first, last, m_sourcesTag);
+        if (result != last)
+        {
+            return dynamic_cast<GlowCompactSignalCollection const*>(&*result);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    LIBEMBER_INLINE
+    GlowCompactConnectionCollection const* GlowMatrixBase::compactConnections() const
+    {
+        const_iterator const first = begin();
+        const_iterator const last = end();
+        const_iterator const result = util::find_tag(first, last, m_connectionsTag);
+        if (result != last)
+        {
+            return dynamic_cast<GlowCompactConnectionCollection const*>(&*result);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
     LIBEMBER_INLINE
     ber::ObjectIdentifier GlowMatrixBase::templateReference() const
     {
@@ -74,7 +74,7 @@ namespace libember { namespace glow { namespace util
             template<typename ValueType>
             static ValueType valueOf(dom::Node const* node, ValueType const& default_)
             {
-                return valueOf(dynamic_cast<dom::VariantLeaf const*>(node), default_);
+                return valueOf(asVariantLeaf(node), default_);
             }
 
             /**
@@ -84,7 +84,7 @@ namespace libember { namespace glow { namespace util
              */
             static ber::Value valueOf(dom::Node const* node)
             {
-                return valueOf(dynamic_cast<dom::VariantLeaf const*>(node));
+                return valueOf(asVariantLeaf(node));
             }
 
             /**
@@ -96,6 +96,19 @@ namespace libember { namespace glow { namespace util
             {
                 return (leaf != 0) ? leaf->value() : ber::Value();
             }
+
+        private:
+            /**
+             * Returns the passed node as VariantLeaf, if it is one.
+             * @param node The node to convert.
+             * @return The passed node, or null if @p node is not a VariantLeaf.
+             */
+            static dom::VariantLeaf const* asVariantLeaf(dom::Node const* node)
+            {
+                return (node != 0 && node->kind() == dom::Node::VariantLeafKind)
+                    ? static_cast<dom::VariantLeaf const*>(node)
+                    : 0;
+            }
     };
 }
 }
@@ -0,0 +1,145 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "ember/glow/GlowQualifiedMatrix.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    int const SignalCount = 300;
+
+    std::vector<unsigned char> encode(libember::dom::Node const& node)
+    {
+        libember::util::OctetStream stream;
+        node.encode(stream);
+        return std::vector<unsigned char>(stream.begin(), stream.end());
+    }
+
+    std::vector<int> sourcesOf(int target)
+    {
+        std::vector<int> result;
+        for (int source = 0; source < target % 4; ++source)
+            result.push_back((target * 7 + source * 131) % SignalCount);
+
+        return result;
+    }
+
+    void fillNodeBased(libember::glow::GlowMatrixBase& matrix)
+    {
+        libember::dom::Sequence* targets = matrix.targets();
+        libember::dom::Sequence* sources = matrix.sources();
+        libember::dom::Sequence* connections = matrix.connections();
+
+        for (int number = 0; number < SignalCount; ++number)
+        {
+            targets->insert(targets->end(), new libember::glow::GlowTarget(number * 1000));
+            sources->insert(sources->end(), new libember::glow::GlowSource(number));
+
+            libember::glow::GlowConnection* connection = new libember::glow::GlowConnection(number * 1000);
+            std::vector<int> const numbers = sourcesOf(number);
+            if (numbers.empty() == false)
+                connection->setSources(libember::ber::ObjectIdentifier(numbers.begin(), numbers.end()));
+
+            if (number % 5 == 0)
+                connection->setOperation(libember::glow::ConnectionOperation::Connect);
+
+            if (number % 3 == 0)
+                connection->setDisposition(libember::glow::ConnectionDisposition::Modified);
+
+            connections->insert(connections->end(), connection);
+        }
+    }
+
+    void fillCompact(libember::glow::GlowMatrixBase& matrix)
+    {
+        libember::glow::GlowCompactSignalCollection* targets = matrix.compactTargets();
+        libember::glow::GlowCompactSignalCollection* sources = matrix.compactSources();
+        libember::glow::GlowCompactConnectionCollection* connections = matrix.compactConnections();
+
+        for (int number = 0; number < SignalCount; ++number)
+        {
+            targets->insert(number * 1000);
+            sources->insert(number);
+
+            std::vector<int> const numbers = sourcesOf(number);
+            connections->insert(
+                number * 1000,
+                numbers.begin(),
+                numbers.end(),
+                number % 5 == 0 ? libember::glow::ConnectionOperation::Connect : libember::glow::ConnectionOperation::Absolute,
+                number % 3 == 0 ? libember::glow::ConnectionDisposition::Modified : libember::glow::ConnectionDisposition::Tally);
+        }
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        libember::glow::GlowQualifiedMatrix nodeBased(libember::ber::ObjectIdentifier(1));
+        libember::glow::GlowQualifiedMatrix compact(libember::ber::ObjectIdentifier(1));
+        fillNodeBased(nodeBased);
+        fillCompact(compact);
+
+        std::vector<unsigned char> const expected = encode(nodeBased);
+        if (nodeBased.encodedLength() != compact.encodedLength())
+        {
+            THROW_TEST_EXCEPTION("Encoded length mismatch: " << nodeBased.encodedLength() << " != " << compact.encodedLength());
+        }
+        if (encode(compact) != expected)
+        {
+            THROW_TEST_EXCEPTION("The compact encoding differs from the node based encoding.");
+        }
+
+        {
+            // Converting the node based collections to compact ones keeps the encoding.
+            libember::glow::GlowQualifiedMatrix matrix(libember::ber::ObjectIdentifier(1));
+            fillNodeBased(matrix);
+            matrix.compactTargets();
+            matrix.compactSources();
+            matrix.compactConnections();
+
+            if (matrix.compactConnections()->size() != static_cast<std::size_t>(SignalCount)
+            ||  static_cast<libember::glow::GlowQualifiedMatrix const&>(matrix).connections() != 0
+            ||  encode(matrix) != expected)
+            {
+                THROW_TEST_EXCEPTION("Converting to compact collections changed the matrix.");
+            }
+
+            // And back again.
+            matrix.targets();
+            matrix.sources();
+            matrix.connections();
+
+            std::vector<libember::glow::GlowConnection const*> connections;
+            static_cast<libember::glow::GlowQualifiedMatrix const&>(matrix).typedConnections(std::back_inserter(connections));
+            if (connections.size() != static_cast<std::size_t>(SignalCount)
+            ||  static_cast<libember::glow::GlowQualifiedMatrix const&>(matrix).compactConnections() != 0
+            ||  encode(matrix) != expected)
+            {
+                THROW_TEST_EXCEPTION("Converting to node based collections changed the matrix.");
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+    libember -- C++ 03 implementation of the Ember+ Protocol
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "ember/glow/GlowQualifiedMatrix.hpp"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    libember::ber::ObjectIdentifier range(std::size_t first, std::size_t last)
+    {
+        libember::ber::ObjectIdentifier result;
+        for (; first < last; ++first)
+            result.push_back(first);
+
+        return result;
+    }
+
+    std::vector<libember::glow::GlowConnection const*> connectionsOf(libember::glow::GlowMatrixBase const& matrix)
+    {
+        std::vector<libember::glow::GlowConnection const*> result;
+        matrix.typedConnections(std::back_inserter(result));
+        return result;
+    }
+}
+
+int main(int, char const* const*)
+{
+    using libember::glow::ConnectionDisposition;
+    using libember::glow::ConnectionOperation;
+
+    try
+    {
+        {
+            libember::ber::ObjectIdentifier connected;
+            libember::ber::ObjectIdentifier disconnected;
+            libember::ber::ObjectIdentifier previous = range(0, 4);
+            libember::ber::ObjectIdentifier current = range(2, 6);
+            libember::glow::GlowConnection::computeDelta(previous, current, connected, disconnected);
+
+            if (connected != range(4, 6) || disconnected != range(0, 2))
+            {
+                THROW_TEST_EXCEPTION("GlowConnection::computeDelta() returned an unexpected delta.");
+            }
+        }
+        {
+            // A single changed source out of many is reported as delta.
+            libember::glow::GlowQualifiedMatrix matrix(libember::ber::ObjectIdentifier(1));
+            libember::ber::ObjectIdentifier previous = range(0, 300);
+            libember::ber::ObjectIdentifier current = range(0, 301);
+
+            if (matrix.insertConnectionChange(7, previous, current, ConnectionDisposition::Modified) != 1)
+            {
+                THROW_TEST_EXCEPTION("Expected a single delta connection.");
+            }
+
+            std::vector<libember::glow::GlowConnection const*> connections = connectionsOf(matrix);
+            if (connections.size() != 1
+            ||  connections[0]->target() != 7
+            ||  connections[0]->operation().value() != ConnectionOperation::Connect
+            ||  connections[0]->sources() != range(300, 301))
+            {
+                THROW_TEST_EXCEPTION("Unexpected delta connection.");
+            }
+        }
+        {
+            // Connecting and disconnecting on a small target is reported as absolute.
+            libember::glow::GlowQualifiedMatrix matrix(libember::ber::ObjectIdentifier(1));
+            libember::ber::ObjectIdentifier previous = range(0, 1);
+            libember::ber::ObjectIdentifier current = range(1, 2);
+
+            if (matrix.insertConnectionChange(3, previous, current, ConnectionDisposition::Modified) != 1)
+            {
+                THROW_TEST_EXCEPTION("Expected a single absolute connection.");
+            }
+
+            std::vector<libember::glow::GlowConnection const*> connections = connectionsOf(matrix);
+            if (connections.size() != 1
+            ||  connections[0]->operation().value() != ConnectionOperation::Absolute
+            ||  connections[0]->sources() != current
+            ||  connections[0]->disposition().value() != ConnectionDisposition::Modified)
+            {
+                THROW_TEST_EXCEPTION("Unexpected absolute connection.");
+            }
+        }
+        {
+            // Large changes in both directions are reported as disconnect followed by connect.
+            libember::glow::GlowQualifiedMatrix matrix(libember::ber::ObjectIdentifier(1));
+            libember::ber::ObjectIdentifier previous = range(0, 200);
+            libember::ber::ObjectIdentifier current = range(1, 201);
+
+            if (matrix.insertConnectionChange(0, previous, current, ConnectionDisposition::Modified) != 2)
+            {
+                THROW_TEST_EXCEPTION("Expected a disconnect/connect pair.");
+            }
+
+            std::vector<libember::glow::GlowConnection const*> connections = connectionsOf(matrix);
+            if (connections.size() != 2
+            ||  connections[0]->operation().value() != ConnectionOperation::Disconnect
+            ||  connections[0]->sources() != range(0, 1)
+            ||  connections[1]->operation().value() != ConnectionOperation::Connect
+            ||  connections[1]->sources() != range(200, 201))
+            {
+                THROW_TEST_EXCEPTION("Unexpected disconnect/connect pair.");
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
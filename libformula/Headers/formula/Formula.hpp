@@ -9,7 +9,9 @@
 #include "Version.hpp"
 #include "util/CodeDump.hpp"
 #include "util/CodeInterpreter.hpp"
+#include "util/RegisterMachine.hpp"
 #include "CodeEmitter.hpp"
 #include "TermCompiler.hpp"
+#include "TermCache.hpp"
 
 #endif  // __LIBFORMULA_FORMULA_HPP
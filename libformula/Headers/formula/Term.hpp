@@ -11,6 +11,7 @@
 #include "Scanner.hpp"
 #include "Parser.hpp"
 #include "util/CodeInterpreter.hpp"
+#include "util/RegisterMachine.hpp"
 #include <memory>
 
 namespace libformula
@@ -78,7 +79,7 @@ namespace libformula
         return result;
     }
 
-    typedef Term<util::CodeInterpreter> CompiledTerm;
+    typedef Term<util::RegisterMachine> CompiledTerm;
 }
 
 #endif  // __LIBFORMULA_TERM_HPP
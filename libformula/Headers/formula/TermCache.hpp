@@ -0,0 +1,118 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+#ifndef __LIBFORMULA_TERMCACHE_HPP
+#define __LIBFORMULA_TERMCACHE_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "TermCompiler.hpp"
+
+namespace libformula
+{
+    /**
+     * TermCache, interns compiled terms by their term string. Each distinct term
+     * string is compiled once, and all callers requesting the same string share
+     * the compiled term. A compiled term is not modified by compute, so a shared
+     * term may be computed by several threads at the same time.
+     * All methods of this class are thread-safe.
+     */
+    class TermCache
+    {
+        public:
+            typedef std::shared_ptr<CompiledTerm const> TermHandle;
+            typedef std::size_t size_type;
+
+            /**
+             * Returns the cache shared by the whole process.
+             * @return The cache shared by the whole process.
+             */
+            static TermCache& instance();
+
+            /**
+             * Returns the compiled term for the passed term string. The term is
+             * compiled when it is requested for the first time. Like with
+             * TermCompiler::compile, errors are ignored and the term is cached
+             * anyway.
+             * @param term Termstring to compile.
+             * @return A handle to the compiled term, which is never nullptr.
+             */
+            TermHandle get(std::string const& term);
+
+            /**
+             * Returns the number of cached terms.
+             * @return The number of cached terms.
+             */
+            size_type size() const;
+
+            /**
+             * Removes all terms from the cache. Handles that have been returned
+             * before remain valid.
+             */
+            void clear();
+
+        private:
+            /** Constructor, use instance() to access the cache. */
+            TermCache();
+
+            /** Copying is not supported. */
+            TermCache(TermCache const&);
+
+            /** Assignment is not supported. */
+            TermCache& operator=(TermCache const&);
+
+        private:
+            typedef std::unordered_map<std::string, TermHandle> TermMap;
+
+            mutable std::mutex m_mutex;
+            TermMap m_terms;
+    };
+
+    /**************************************************************************
+     * Inline implementation                                                  *
+     **************************************************************************/
+
+    inline TermCache::TermCache()
+    {}
+
+    inline TermCache& TermCache::instance()
+    {
+        static TermCache cache;
+        return cache;
+    }
+
+    inline TermCache::TermHandle TermCache::get(std::string const& term)
+    {
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            auto const result = m_terms.find(term);
+            if (result != m_terms.end())
+                return result->second;
+        }
+
+        // The term is compiled without holding the lock. If two threads compile the
+        // same term at once, the term stored first is returned to both.
+        auto const compiled = std::make_shared<CompiledTerm const>(TermCompiler::compile(term));
+
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        return m_terms.insert(std::make_pair(term, compiled)).first->second;
+    }
+
+    inline TermCache::size_type TermCache::size() const
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        return m_terms.size();
+    }
+
+    inline void TermCache::clear()
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_terms.clear();
+    }
+}
+
+#endif  // __LIBFORMULA_TERMCACHE_HPP
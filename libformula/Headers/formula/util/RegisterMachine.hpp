@@ -0,0 +1,796 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+#ifndef __LIBFORMULA_UTIL_REGISTERMACHINE_HPP
+#define __LIBFORMULA_UTIL_REGISTERMACHINE_HPP
+
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+#include "../CodeEmitter.hpp"
+#include "../Types.hpp"
+
+namespace libformula { namespace util
+{
+    /**
+     * Implementation of the CodeEmitter interface, that translates the emitted
+     * stack code into register code while the term is being parsed.
+     * Each position of the value stack is mapped to a register, and since the type
+     * of every value only depends on the type of the '$' symbol, two programs are
+     * generated: one that is used when '$' is an integer and one that is used when
+     * it is a real value. Each instruction of a program operates on a single,
+     * fixed type, so no types have to be checked when the term is computed.
+     * Operations whose operands are constant are evaluated while the term is
+     * compiled, and constant right hand operands are stored within the
+     * instruction that uses them.
+     * A computation does not allocate any memory, unless the term requires more
+     * than MaxInlineRegisters registers. The results are identical to the ones
+     * computed by the CodeInterpreter.
+     */
+    class RegisterMachine : public CodeEmitter
+    {
+        typedef libformula::long_type long_type;
+        typedef libformula::real_type real_type;
+        public:
+            /**
+             * The number of registers that are reserved on the call stack when a
+             * term is computed. Only terms which require more registers allocate
+             * their registers on the heap.
+             */
+            enum { MaxInlineRegisters = 32 };
+
+            /**
+             * Initializes a new register machine instance.
+             */
+            RegisterMachine();
+
+            /**
+             * Computes the term with the provided value used for the $ variable.
+             * @param value Value of the variable.
+             * @return Returns the result of the term computation.
+             */
+            template<typename ValueType>
+            ValueType compute(ValueType value) const;
+
+        public:
+            /** @see CodeEmitter */
+            virtual void emitPushLong(long_type value);
+
+            /** @see CodeEmitter */
+            virtual void emitPushReal(real_type value);
+
+            /** @see CodeEmitter */
+            virtual void emitPushIt();
+
+            /** @see CodeEmitter */
+            virtual void emitAdd();
+
+            /** @see CodeEmitter */
+            virtual void emitSubtract();
+
+            /** @see CodeEmitter */
+            virtual void emitMultiply();
+
+            /** @see CodeEmitter */
+            virtual void emitDivide();
+
+            /** @see CodeEmitter */
+            virtual void emitLongDivide();
+
+            /** @see CodeEmitter */
+            virtual void emitModulo();
+
+            /** @see CodeEmitter */
+            virtual void emitCall(FunctionType const& function, int argcount);
+
+            /** @see CodeEmitter */
+            virtual void emitNegate();
+
+        private:
+            /**
+             * A single register, which either contains an integer or a real value.
+             * The type of the value is known when the program is compiled.
+             */
+            union Register
+            {
+                long_type l;
+                real_type r;
+            };
+
+            /**
+             * Scoped enumeration containing the types a register may have.
+             */
+            struct OperandType
+            {
+                enum _Domain
+                {
+                    Long,
+                    Real
+                };
+            };
+
+            /**
+             * Scoped enumeration containing the operations emitted by the parser,
+             * independent of the type of their operands.
+             */
+            struct Operation
+            {
+                enum _Domain
+                {
+                    // Binary operations
+                    Add,
+                    Subtract,
+                    Multiply,
+                    Divide,
+                    LongDivide,
+                    Modulo,
+                    Pow,
+                    Atan2,
+                    LogBase,
+
+                    // Unary operations
+                    Negate,
+                    Abs,
+                    Sgn,
+                    Int,
+                    Float,
+                    Exp,
+                    Cos,
+                    Sin,
+                    Tan,
+                    Acos,
+                    Asin,
+                    Atan,
+                    Cosh,
+                    Sinh,
+                    Tanh,
+                    Log,
+                    Floor,
+                    Ceil,
+                    Sqrt
+                };
+            };
+
+            /**
+             * Scoped enumeration containing the typed instructions. Each instruction
+             * stores its result in the destination register. Binary instructions
+             * read their second operand from the register following the destination,
+             * the variants suffixed with Imm use the immediate value instead.
+             */
+            struct OpCode
+            {
+                enum _Domain
+                {
+                    None,
+                    LoadIt,
+                    LoadConstant,
+                    ToLong,
+                    ToReal,
+                    AddLong,
+                    AddReal,
+                    SubLong,
+                    SubReal,
+                    MulLong,
+                    MulReal,
+                    DivReal,
+                    IdivLong,
+                    ModLong,
+                    AddLongImm,
+                    AddRealImm,
+                    SubLongImm,
+                    SubRealImm,
+                    MulLongImm,
+                    MulRealImm,
+                    DivRealImm,
+                    IdivLongImm,
+                    ModLongImm,
+                    PowReal,
+                    Atan2Real,
+                    LogBaseReal,
+                    NegLong,
+                    NegReal,
+                    AbsLong,
+                    AbsReal,
+                    SgnLong,
+                    SgnReal,
+                    ExpReal,
+                    CosReal,
+                    SinReal,
+                    TanReal,
+                    AcosReal,
+                    AsinReal,
+                    AtanReal,
+                    CoshReal,
+                    SinhReal,
+                    TanhReal,
+                    LogReal,
+                    FloorReal,
+                    CeilReal,
+                    SqrtReal
+                };
+            };
+
+            /**
+             * A single instruction of a program.
+             */
+            struct Instruction
+            {
+                /**
+                 * Initializes a new instruction.
+                 * @param code The operation to perform.
+                 * @param dst The index of the destination register.
+                 * @param imm The immediate operand, if the instruction requires one.
+                 */
+                Instruction(OpCode::_Domain code, unsigned int dst, Register imm);
+
+                OpCode::_Domain code;
+                unsigned int dst;
+                Register imm;
+            };
+
+            /**
+             * Describes an item of the value stack while a program is compiled.
+             * Constant items have not been loaded into a register, all other items
+             * are stored in the register whose index equals their stack position.
+             */
+            struct Operand
+            {
+                OperandType::_Domain type;
+                bool isConstant;
+                unsigned int index;
+                Register value;
+            };
+
+            /**
+             * Contains the instructions that compute the term for a specific type
+             * of the '$' symbol.
+             */
+            class Program
+            {
+                public:
+                    /**
+                     * Initializes a new, empty program.
+                     * @param itType The type of the '$' symbol.
+                     */
+                    explicit Program(OperandType::_Domain itType);
+
+                    /**
+                     * Pushes a constant onto the value stack.
+                     * @param type The type of the constant.
+                     * @param value The constant value.
+                     */
+                    void pushConstant(OperandType::_Domain type, Register value);
+
+                    /**
+                     * Pushes the value of the '$' symbol onto the value stack.
+                     */
+                    void pushIt();
+
+                    /**
+                     * Applies an operation to the topmost items of the value stack.
+                     * The operation is evaluated immediately if all of its operands
+                     * are constant.
+                     * @param operation The operation to apply.
+                     */
+                    void apply(Operation::_Domain operation);
+
+                    /**
+                     * Runs the program.
+                     * @param value The value of the '$' symbol.
+                     * @return The result of the computation.
+                     */
+                    template<typename ValueType>
+                    ValueType run(ValueType value) const;
+
+                private:
+                    void applyUnary(Operation::_Domain operation);
+                    void applyBinary(Operation::_Domain operation);
+                    void load(Operand const& operand, unsigned int index, OperandType::_Domain type);
+                    void append(OpCode::_Domain code, unsigned int dst, Register imm);
+
+                private:
+                    std::vector<Instruction> m_code;
+                    std::vector<Operand> m_operands;
+                    OperandType::_Domain m_itType;
+                    unsigned int m_registerCount;
+                    bool m_isValid;
+            };
+
+        private:
+            /**
+             * Applies an operation to both programs.
+             * @param operation The operation to apply.
+             */
+            void apply(Operation::_Domain operation);
+
+            static bool isBinary(Operation::_Domain operation);
+            static bool hasImmediateForm(Operation::_Domain operation);
+            static OperandType::_Domain operandType(Operation::_Domain operation, OperandType::_Domain x, OperandType::_Domain y);
+            static OperandType::_Domain resultType(Operation::_Domain operation, OperandType::_Domain type);
+            static OpCode::_Domain opcode(Operation::_Domain operation, OperandType::_Domain type, bool isImmediate);
+            static Register convert(Operand const& operand, OperandType::_Domain type);
+
+            template<typename ValueType>
+            static ValueType valueOf(OperandType::_Domain type, Register const& value);
+
+            /**
+             * Executes a single instruction.
+             * @param instruction The instruction to execute.
+             * @param registers The register file.
+             * @param it The value of the '$' symbol.
+             */
+            static void execute(Instruction const& instruction, Register* registers, Register const& it);
+
+        private:
+            Program m_long;
+            Program m_real;
+    };
+
+    /**************************************************************************
+     * Inline implementation                                                  *
+     **************************************************************************/
+
+    inline RegisterMachine::Instruction::Instruction(OpCode::_Domain code, unsigned int dst, Register imm)
+        : code(code)
+        , dst(dst)
+        , imm(imm)
+    {}
+
+    inline RegisterMachine::Program::Program(OperandType::_Domain itType)
+        : m_itType(itType)
+        , m_registerCount(0)
+        , m_isValid(true)
+    {}
+
+    inline void RegisterMachine::Program::pushConstant(OperandType::_Domain type, Register value)
+    {
+        auto operand = Operand();
+        operand.type = type;
+        operand.isConstant = true;
+        operand.index = static_cast<unsigned int>(m_operands.size());
+        operand.value = value;
+        m_operands.push_back(operand);
+    }
+
+    inline void RegisterMachine::Program::pushIt()
+    {
+        auto operand = Operand();
+        operand.type = m_itType;
+        operand.isConstant = false;
+        operand.index = static_cast<unsigned int>(m_operands.size());
+        m_operands.push_back(operand);
+
+        append(OpCode::LoadIt, operand.index, Register());
+    }
+
+    inline void RegisterMachine::Program::apply(Operation::_Domain operation)
+    {
+        if (m_isValid == false)
+            return;
+
+        if (isBinary(operation))
+            applyBinary(operation);
+        else
+            applyUnary(operation);
+    }
+
+    inline void RegisterMachine::Program::applyUnary(Operation::_Domain operation)
+    {
+        if (m_operands.empty())
+        {
+            m_isValid = false;
+            return;
+        }
+
+        auto result = m_operands.back();
+        auto const type = operandType(operation, result.type, result.type);
+        auto const code = opcode(operation, type, false);
+
+        if (result.isConstant)
+        {
+            Register registers[2] = { convert(result, type), Register() };
+            if (code != OpCode::None)
+                execute(Instruction(code, 0, Register()), registers, Register());
+
+            result.value = registers[0];
+        }
+        else
+        {
+            load(result, result.index, type);
+            if (code != OpCode::None)
+                append(code, result.index, Register());
+        }
+
+        result.type = resultType(operation, type);
+        m_operands.back() = result;
+    }
+
+    inline void RegisterMachine::Program::applyBinary(Operation::_Domain operation)
+    {
+        if (m_operands.size() < 2)
+        {
+            m_isValid = false;
+            return;
+        }
+
+        auto const y = m_operands.back();
+        m_operands.pop_back();
+
+        auto result = m_operands.back();
+        auto const type = operandType(operation, result.type, y.type);
+        auto const rhs = convert(y, type);
+
+        // Integer divisions by 0 and -1 are left to the computation, so that they
+        // behave exactly like they did before.
+        auto const isDivision = operation == Operation::LongDivide || operation == Operation::Modulo;
+        auto const isFoldable = isDivision == false || (rhs.l != 0 && rhs.l != -1);
+
+        if (result.isConstant && y.isConstant && isFoldable)
+        {
+            Register registers[2] = { convert(result, type), rhs };
+            execute(Instruction(opcode(operation, type, false), 0, Register()), registers, Register());
+            result.value = registers[0];
+        }
+        else if (y.isConstant && hasImmediateForm(operation))
+        {
+            load(result, result.index, type);
+            append(opcode(operation, type, true), result.index, rhs);
+            result.isConstant = false;
+        }
+        else
+        {
+            load(result, result.index, type);
+            load(y, y.index, type);
+            append(opcode(operation, type, false), result.index, Register());
+            result.isConstant = false;
+        }
+
+        result.type = resultType(operation, type);
+        m_operands.back() = result;
+    }
+
+    inline void RegisterMachine::Program::load(Operand const& operand, unsigned int index, OperandType::_Domain type)
+    {
+        if (operand.isConstant)
+        {
+            append(OpCode::LoadConstant, index, convert(operand, type));
+        }
+        else if (operand.type != type)
+        {
+            append(type == OperandType::Real ? OpCode::ToReal : OpCode::ToLong, index, Register());
+        }
+    }
+
+    inline void RegisterMachine::Program::append(OpCode::_Domain code, unsigned int dst, Register imm)
+    {
+        m_code.push_back(Instruction(code, dst, imm));
+
+        if (dst >= m_registerCount)
+            m_registerCount = dst + 1;
+    }
+
+    template<typename ValueType>
+    inline ValueType RegisterMachine::Program::run(ValueType value) const
+    {
+        if (m_isValid == false || m_operands.empty())
+            return value;
+
+        auto const& result = m_operands.back();
+        if (result.isConstant)
+            return valueOf<ValueType>(result.type, result.value);
+
+        auto it = Register();
+        if (m_itType == OperandType::Real)
+            it.r = static_cast<real_type>(value);
+        else
+            it.l = static_cast<long_type>(value);
+
+        Register inlineRegisters[MaxInlineRegisters];
+        std::vector<Register> heapRegisters;
+        auto registers = inlineRegisters;
+
+        if (m_registerCount > MaxInlineRegisters)
+        {
+            heapRegisters.resize(m_registerCount);
+            registers = &heapRegisters[0];
+        }
+
+        auto first = std::begin(m_code);
+        auto const last = std::end(m_code);
+        for (; first != last; ++first)
+            execute(*first, registers, it);
+
+        return valueOf<ValueType>(result.type, registers[result.index]);
+    }
+
+    inline RegisterMachine::RegisterMachine()
+        : m_long(OperandType::Long)
+        , m_real(OperandType::Real)
+    {}
+
+    inline void RegisterMachine::emitPushLong(long_type value)
+    {
+        auto constant = Register();
+        constant.l = value;
+        m_long.pushConstant(OperandType::Long, constant);
+        m_real.pushConstant(OperandType::Long, constant);
+    }
+
+    inline void RegisterMachine::emitPushReal(real_type value)
+    {
+        auto constant = Register();
+        constant.r = value;
+        m_long.pushConstant(OperandType::Real, constant);
+        m_real.pushConstant(OperandType::Real, constant);
+    }
+
+    inline void RegisterMachine::emitPushIt()
+    {
+        m_long.pushIt();
+        m_real.pushIt();
+    }
+
+    inline void RegisterMachine::emitAdd()
+    {
+        apply(Operation::Add);
+    }
+
+    inline void RegisterMachine::emitSubtract()
+    {
+        apply(Operation::Subtract);
+    }
+
+    inline void RegisterMachine::emitMultiply()
+    {
+        apply(Operation::Multiply);
+    }
+
+    inline void RegisterMachine::emitDivide()
+    {
+        apply(Operation::Divide);
+    }
+
+    inline void RegisterMachine::emitLongDivide()
+    {
+        apply(Operation::LongDivide);
+    }
+
+    inline void RegisterMachine::emitModulo()
+    {
+        apply(Operation::Modulo);
+    }
+
+    inline void RegisterMachine::emitCall(FunctionType const& function, int argcount)
+    {
+        switch(function.value())
+        {
+            case FunctionType::Exp:   apply(Operation::Exp); break;
+            case FunctionType::Pow:   apply(Operation::Pow); break;
+            case FunctionType::Cos:   apply(Operation::Cos); break;
+            case FunctionType::Sin:   apply(Operation::Sin); break;
+            case FunctionType::Tan:   apply(Operation::Tan); break;
+            case FunctionType::Acos:  apply(Operation::Acos); break;
+            case FunctionType::Asin:  apply(Operation::Asin); break;
+            case FunctionType::Cosh:  apply(Operation::Cosh); break;
+            case FunctionType::Sinh:  apply(Operation::Sinh); break;
+            case FunctionType::Tanh:  apply(Operation::Tanh); break;
+            case FunctionType::Int:   apply(Operation::Int); break;
+            case FunctionType::Float: apply(Operation::Float); break;
+            case FunctionType::Ln:    apply(Operation::Log); break;
+            case FunctionType::Round: apply(Operation::Floor); break;
+            case FunctionType::Ceil:  apply(Operation::Ceil); break;
+            case FunctionType::Sqrt:  apply(Operation::Sqrt); break;
+            case FunctionType::Abs:   apply(Operation::Abs); break;
+            case FunctionType::Sgn:   apply(Operation::Sgn); break;
+            case FunctionType::Atan:
+                if (argcount == 1)
+                    apply(Operation::Atan);
+                else if (argcount == 2)
+                    apply(Operation::Atan2);
+                break;
+            case FunctionType::Log:
+                if (argcount == 1)
+                    apply(Operation::Log);
+                else if (argcount == 2)
+                    apply(Operation::LogBase);
+                break;
+            default:
+                break;
+        }
+    }
+
+    inline void RegisterMachine::emitNegate()
+    {
+        apply(Operation::Negate);
+    }
+
+    inline void RegisterMachine::apply(Operation::_Domain operation)
+    {
+        m_long.apply(operation);
+        m_real.apply(operation);
+    }
+
+    template<typename ValueType>
+    inline ValueType RegisterMachine::compute(ValueType value) const
+    {
+        auto const& program = std::is_floating_point<ValueType>::value ? m_real : m_long;
+        return program.run(value);
+    }
+
+    inline bool RegisterMachine::isBinary(Operation::_Domain operation)
+    {
+        return operation <= Operation::LogBase;
+    }
+
+    inline bool RegisterMachine::hasImmediateForm(Operation::_Domain operation)
+    {
+        return operation <= Operation::Modulo;
+    }
+
+    inline RegisterMachine::OperandType::_Domain RegisterMachine::operandType(Operation::_Domain operation, OperandType::_Domain x, OperandType::_Domain y)
+    {
+        switch(operation)
+        {
+            case Operation::Add:
+            case Operation::Subtract:
+            case Operation::Multiply:
+                return x == OperandType::Real || y == OperandType::Real ? OperandType::Real : OperandType::Long;
+
+            case Operation::LongDivide:
+            case Operation::Modulo:
+            case Operation::Int:
+                return OperandType::Long;
+
+            case Operation::Negate:
+            case Operation::Abs:
+            case Operation::Sgn:
+                return x;
+
+            default:
+                return OperandType::Real;
+        }
+    }
+
+    inline RegisterMachine::OperandType::_Domain RegisterMachine::resultType(Operation::_Domain operation, OperandType::_Domain type)
+    {
+        return operation == Operation::Sgn ? OperandType::Long : type;
+    }
+
+    inline RegisterMachine::OpCode::_Domain RegisterMachine::opcode(Operation::_Domain operation, OperandType::_Domain type, bool isImmediate)
+    {
+        auto const isReal = type == OperandType::Real;
+        switch(operation)
+        {
+            case Operation::Add:
+                return isImmediate
+                    ? (isReal ? OpCode::AddRealImm : OpCode::AddLongImm)
+                    : (isReal ? OpCode::AddReal : OpCode::AddLong);
+            case Operation::Subtract:
+                return isImmediate
+                    ? (isReal ? OpCode::SubRealImm : OpCode::SubLongImm)
+                    : (isReal ? OpCode::SubReal : OpCode::SubLong);
+            case Operation::Multiply:
+                return isImmediate
+                    ? (isReal ? OpCode::MulRealImm : OpCode::MulLongImm)
+                    : (isReal ? OpCode::MulReal : OpCode::MulLong);
+            case Operation::Divide:     return isImmediate ? OpCode::DivRealImm : OpCode::DivReal;
+            case Operation::LongDivide: return isImmediate ? OpCode::IdivLongImm : OpCode::IdivLong;
+            case Operation::Modulo:     return isImmediate ? OpCode::ModLongImm : OpCode::ModLong;
+            case Operation::Pow:        return OpCode::PowReal;
+            case Operation::Atan2:      return OpCode::Atan2Real;
+            case Operation::LogBase:    return OpCode::LogBaseReal;
+            case Operation::Negate:     return isReal ? OpCode::NegReal : OpCode::NegLong;
+            case Operation::Abs:        return isReal ? OpCode::AbsReal : OpCode::AbsLong;
+            case Operation::Sgn:        return isReal ? OpCode::SgnReal : OpCode::SgnLong;
+            case Operation::Exp:        return OpCode::ExpReal;
+            case Operation::Cos:        return OpCode::CosReal;
+            case Operation::Sin:        return OpCode::SinReal;
+            case Operation::Tan:        return OpCode::TanReal;
+            case Operation::Acos:       return OpCode::AcosReal;
+            case Operation::Asin:       return OpCode::AsinReal;
+            case Operation::Atan:       return OpCode::AtanReal;
+            case Operation::Cosh:       return OpCode::CoshReal;
+            case Operation::Sinh:       return OpCode::SinhReal;
+            case Operation::Tanh:       return OpCode::TanhReal;
+            case Operation::Log:        return OpCode::LogReal;
+            case Operation::Floor:      return OpCode::FloorReal;
+            case Operation::Ceil:       return OpCode::CeilReal;
+            case Operation::Sqrt:       return OpCode::SqrtReal;
+
+            // Int and Float only convert their operand, which is done when it is loaded.
+            default:
+                return OpCode::None;
+        }
+    }
+
+    inline RegisterMachine::Register RegisterMachine::convert(Operand const& operand, OperandType::_Domain type)
+    {
+        if (operand.type == type)
+            return operand.value;
+
+        auto result = Register();
+        if (type == OperandType::Real)
+            result.r = static_cast<real_type>(operand.value.l);
+        else
+            result.l = static_cast<long_type>(operand.value.r);
+
+        return result;
+    }
+
+    template<typename ValueType>
+    inline ValueType RegisterMachine::valueOf(OperandType::_Domain type, Register const& value)
+    {
+        return type == OperandType::Real
+            ? static_cast<ValueType>(value.r)
+            : static_cast<ValueType>(value.l);
+    }
+
+    inline void RegisterMachine::execute(Instruction const& instruction, Register* registers, Register const& it)
+    {
+        auto& x = registers[instruction.dst];
+        auto const y = registers + instruction.dst + 1;
+        auto const& imm = instruction.imm;
+
+        switch(instruction.code)
+        {
+            case OpCode::None:          break;
+            case OpCode::LoadIt:        x = it; break;
+            case OpCode::LoadConstant:  x = imm; break;
+            case OpCode::ToLong:        x.l = static_cast<long_type>(x.r); break;
+            case OpCode::ToReal:        x.r = static_cast<real_type>(x.l); break;
+            case OpCode::AddLong:       x.l = x.l + y->l; break;
+            case OpCode::AddReal:       x.r = x.r + y->r; break;
+            case OpCode::SubLong:       x.l = x.l - y->l; break;
+            case OpCode::SubReal:       x.r = x.r - y->r; break;
+            case OpCode::MulLong:       x.l = x.l * y->l; break;
+            case OpCode::MulReal:       x.r = x.r * y->r; break;
+            case OpCode::DivReal:       x.r = x.r / y->r; break;
+            case OpCode::IdivLong:      x.l = x.l / y->l; break;
+            case OpCode::ModLong:       x.l = x.l % y->l; break;
+            case OpCode::AddLongImm:    x.l = x.l + imm.l; break;
+            case OpCode::AddRealImm:    x.r = x.r + imm.r; break;
+            case OpCode::SubLongImm:    x.l = x.l - imm.l; break;
+            case OpCode::SubRealImm:    x.r = x.r - imm.r; break;
+            case OpCode::MulLongImm:    x.l = x.l * imm.l; break;
+            case OpCode::MulRealImm:    x.r = x.r * imm.r; break;
+            case OpCode::DivRealImm:    x.r = x.r / imm.r; break;
+            case OpCode::IdivLongImm:   x.l = x.l / imm.l; break;
+            case OpCode::ModLongImm:    x.l = x.l % imm.l; break;
+            case OpCode::PowReal:       x.r = std::pow(x.r, y->r); break;
+            case OpCode::Atan2Real:     x.r = std::atan2(y->r, x.r); break;
+            case OpCode::LogBaseReal:
+            {
+                auto const a = std::log(x.r);
+                auto const b = std::log(y->r);
+                x.r = a / b;
+                break;
+            }
+            case OpCode::NegLong:       x.l = -x.l; break;
+            case OpCode::NegReal:       x.r = -x.r; break;
+            case OpCode::AbsLong:       x.l = std::abs(x.l); break;
+            case OpCode::AbsReal:       x.r = std::abs(x.r); break;
+            case OpCode::SgnLong:       x.l = x.l < 0 ? -1 : (x.l > 0 ? 1 : 0); break;
+            case OpCode::SgnReal:       x.l = x.r < 0.0 ? -1 : (x.r > 0.0 ? 1 : 0); break;
+            case OpCode::ExpReal:       x.r = std::exp(x.r); break;
+            case OpCode::CosReal:       x.r = std::cos(x.r); break;
+            case OpCode::SinReal:       x.r = std::sin(x.r); break;
+            case OpCode::TanReal:       x.r = std::tan(x.r); break;
+            case OpCode::AcosReal:      x.r = std::acos(x.r); break;
+            case OpCode::AsinReal:      x.r = std::asin(x.r); break;
+            case OpCode::AtanReal:      x.r = std::atan(x.r); break;
+            case OpCode::CoshReal:      x.r = std::cosh(x.r); break;
+            case OpCode::SinhReal:      x.r = std::sinh(x.r); break;
+            case OpCode::TanhReal:      x.r = std::tanh(x.r); break;
+            case OpCode::LogReal:       x.r = std::log(x.r); break;
+            case OpCode::FloorReal:     x.r = std::floor(x.r); break;
+            case OpCode::CeilReal:      x.r = std::ceil(x.r); break;
+            case OpCode::SqrtReal:      x.r = std::sqrt(x.r); break;
+        }
+    }
+}
+}
+
+#endif  // __LIBFORMULA_UTIL_REGISTERMACHINE_HPP
@@ -0,0 +1,201 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <formula/Formula.hpp>
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    std::size_t allocations = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (auto const memory = std::malloc(size != 0 ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    typedef libformula::Term<libformula::util::CodeInterpreter> InterpretedTerm;
+    typedef libformula::Term<libformula::util::RegisterMachine> RegisterTerm;
+
+    char const* const Terms[] =
+    {
+        "$",
+        "42",
+        "-$",
+        "$ + 1",
+        "$ - 2.5",
+        "2 * $",
+        "$ / 4",
+        "$ % 7",
+        "1 + 2 * 3",
+        "10 / 4",
+        "7 % 3",
+        "(1 + 2) * $ - 4 / 2",
+        "$ * 2 + $ * 3 - $",
+        "20 * log($ * $ + 1) / log(10)",
+        "log($ * $ + 2, 2)",
+        "ln(abs($) + 1)",
+        "exp($ / 100)",
+        "sqrt(abs($))",
+        "2 ^ 10",
+        "abs($) ^ 0.5",
+        "sin($) + cos($) - tan($ / 10)",
+        "sinh($ / 50) * cosh($ / 50) - tanh($)",
+        "asin(sgn($)) + acos(0.5) + atan($)",
+        "atan($, 2)",
+        "atan(1, 2)",
+        "round($ / 3)",
+        "ceil($ / 3)",
+        "int($ / 3) + float($) * 2",
+        "int(7.9) % 2 + int($) % 5",
+        "sgn($) * sgn(-2.5) + abs(-3)",
+        "pi * $ + e",
+        "(((($ + 1) * 2 + 3) * 4 + 5) * 6 + 7) * 8",
+        "$ * 0.001 + 1 - $ * $ * 0.00001",
+        "20 * log(1 / 3)",
+        "int($ * 65536 / 100) * 100 / 65536",
+    };
+
+    char const* const BenchmarkTerms[] =
+    {
+        "$ * 2",
+        "$ * 0.001 + 1 - $ * $ * 0.00001",
+        "20 * log($ * $ + 1) / log(10)",
+        "(((($ + 1) * 2 + 3) * 4 + 5) * 6 + 7) * 8",
+    };
+
+    std::size_t const TermCount = sizeof(Terms) / sizeof(Terms[0]);
+    std::size_t const BenchmarkTermCount = sizeof(BenchmarkTerms) / sizeof(BenchmarkTerms[0]);
+
+    template<typename ValueType>
+    bool isSame(ValueType x, ValueType y)
+    {
+        return std::memcmp(&x, &y, sizeof(ValueType)) == 0 || (x != x && y != y);
+    }
+
+    template<typename TermType>
+    TermType compile(std::string const& term)
+    {
+        auto error = libformula::ErrorStack();
+        auto const result = TermType(std::begin(term), std::end(term), &error);
+        if (error.any())
+        {
+            THROW_TEST_EXCEPTION("Failed to compile \"" << term << "\"");
+        }
+
+        return result;
+    }
+
+    template<typename ValueType>
+    void verify(std::string const& term, InterpretedTerm const& interpreted, RegisterTerm const& compiled, ValueType value)
+    {
+        auto const expected = interpreted.compute(value);
+        auto const allocated = allocations;
+        auto const actual = compiled.compute(value);
+        if (allocations != allocated)
+        {
+            THROW_TEST_EXCEPTION("Computing \"" << term << "\" allocated memory!");
+        }
+
+        if (isSame(expected, actual) == false)
+        {
+            THROW_TEST_EXCEPTION(
+                "Result mismatch for \"" << term << "\" with $ = " << value
+                << "! Expected " << std::setprecision(17) << expected << ", found " << actual);
+        }
+    }
+
+    template<typename TermType, typename ValueType>
+    double measure(TermType const& term, ValueType first, int iterations)
+    {
+        auto sum = ValueType();
+        auto const start = std::chrono::steady_clock::now();
+        for (auto i = 0; i < iterations; ++i)
+            sum += term.compute(static_cast<ValueType>(first + i % 1000));
+
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        // Keeps the computations from being optimized away.
+        if (sum == ValueType(-1))
+            std::cout << sum;
+
+        return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    }
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        for (auto index = std::size_t(0); index < TermCount; ++index)
+        {
+            auto const term = std::string(Terms[index]);
+            auto const interpreted = compile<InterpretedTerm>(term);
+            auto const compiled = compile<RegisterTerm>(term);
+
+            for (auto value = -200L; value <= 200L; ++value)
+            {
+                verify(term, interpreted, compiled, value);
+                verify(term, interpreted, compiled, static_cast<double>(value) * 0.37);
+            }
+        }
+
+        int const iterations = 1000000;
+        std::cout << std::fixed << std::setprecision(1);
+
+        for (auto index = std::size_t(0); index < BenchmarkTermCount; ++index)
+        {
+            auto const term = std::string(BenchmarkTerms[index]);
+            auto const interpreted = compile<InterpretedTerm>(term);
+            auto const compiled = compile<RegisterTerm>(term);
+
+            auto const interpretedLong = measure(interpreted, 1L, iterations);
+            auto const compiledLong = measure(compiled, 1L, iterations);
+            auto const interpretedReal = measure(interpreted, 0.5, iterations);
+            auto const compiledReal = measure(compiled, 0.5, iterations);
+
+            std::cout << "\"" << term << "\"" << std::endl
+                << "    long: " << interpretedLong << " ns -> " << compiledLong << " ns per compute"
+                << " (x" << interpretedLong / compiledLong << ")" << std::endl
+                << "    real: " << interpretedReal << " ns -> " << compiledReal << " ns per compute"
+                << " (x" << interpretedReal / compiledReal << ")" << std::endl;
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
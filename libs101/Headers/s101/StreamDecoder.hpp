@@ -73,6 +73,37 @@ namespace libs101
         template<typename InputIterator, typename CallbackType>
         void read(InputIterator first, InputIterator last, CallbackType callback);
 
+        /**
+         * Decodes a contiguous block of bytes, like read. Within an escaped frame,
+         * runs of bytes that have no special meaning are appended to the decoding
+         * buffer at once instead of byte by byte. This method should be preferred
+         * when the received data is available in a contiguous buffer.
+         * @param first Points to the first byte of the block to decode.
+         * @param last Points one past the last byte of the block to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded. The function must have the following 
+         *      signature: (const_iterator, const_iterator, StateType)
+         * @param state A user state that can be used to transfer any 
+         *      kind of data to the callback function.
+         * @note Each time a message has been decoded this method calls reset.
+         */
+        template<typename CallbackType, typename StateType>
+        void readSpan(const_pointer first, const_pointer last, CallbackType callback, StateType state);
+
+        /**
+         * Decodes a contiguous block of bytes, like read. Within an escaped frame,
+         * runs of bytes that have no special meaning are appended to the decoding
+         * buffer at once instead of byte by byte.
+         * @param first Points to the first byte of the block to decode.
+         * @param last Points one past the last byte of the block to decode.
+         * @param callback Callback function that will be called when a valid
+         *      message has been decoded. The function must have the following 
+         *      signature: (const_iterator, const_iterator)
+         * @note Each time a message has been decoded this method calls reset.
+         */
+        template<typename CallbackType>
+        void readSpan(const_pointer first, const_pointer last, CallbackType callback);
+
         /**
          * Decodes a single byte. If this is the last byte of a S101 message
          * the provided callback function will be invoked.
@@ -204,6 +235,45 @@ namespace libs101
             readByte(*first, callback);
     }
 
+    template<typename ValueType>
+    template<typename CallbackType, typename StateType>
+    inline void StreamDecoder<ValueType>::readSpan(const_pointer first, const_pointer last, CallbackType callback, StateType state)
+    {
+        while(first != last)
+        {
+            if (m_state == WithinFrameWithEscaping && m_escape == false)
+            {
+                // CE, BoF and EoF are the only bytes with a special meaning within
+                // an escaped frame, and they are the three largest byte values.
+                const_pointer run = first;
+                util::Crc16::value_type crc = m_crc;
+
+                for(; run != last && static_cast<unsigned char>(*run) < Byte::CE; ++run)
+                    crc = util::Crc16::add(crc, static_cast<unsigned char>(*run));
+
+                if (run != first)
+                {
+                    m_bytes.insert(m_bytes.end(), first, run);
+                    m_crc = crc;
+                    first = run;
+                    continue;
+                }
+            }
+
+            readByte(*first, callback, state);
+            ++first;
+        }
+    }
+
+    template<typename ValueType>
+    template<typename CallbackType>
+    inline void StreamDecoder<ValueType>::readSpan(const_pointer first, const_pointer last, CallbackType callback)
+    {
+        typedef void (*CallbackBindType)(const_iterator, const_iterator, CallbackType);
+
+        readSpan<CallbackBindType, CallbackType>(first, last, invokeStatelessCallback, callback);
+    }
+
     template<typename ValueType>
     template<typename InputType, typename CallbackType>
     inline void StreamDecoder<ValueType>::readByte(InputType input, CallbackType callback)
@@ -0,0 +1,277 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101NET_CONNECTION_HPP
+#define __LIBS101NET_CONNECTION_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <s101/StreamDecoder.hpp>
+#include "EventLoop.hpp"
+#include "MessageHandler.hpp"
+#include "RingBuffer.hpp"
+
+namespace libs101net
+{
+    /** Forward declaration */
+    class Server;
+
+    /**
+     * A non-blocking tcp/ip connection which transports S101 frames. Received bytes
+     * are decoded and each complete message is passed to handleMessage, which
+     * forwards it to the MessageHandler by default. Keep-alive requests are answered
+     * by the connection itself.
+     * Outgoing data is queued and written when the socket is ready, so write never
+     * blocks. A buffer may be shared by several connections.
+     * All methods except write must be called on the thread running the event loop.
+     */
+    class Connection : public EventHandler
+    {
+        friend class Server;
+        public:
+            typedef unsigned char value_type;
+            typedef std::vector<value_type> Buffer;
+            typedef std::shared_ptr<Buffer const> SharedBuffer;
+            typedef libs101::StreamDecoder<value_type> Decoder;
+            typedef Decoder::const_iterator const_iterator;
+            typedef std::size_t size_type;
+
+            /**
+             * Counts the data received by a connection. The counters replace logging
+             * each read, which is too expensive on busy links.
+             */
+            struct ReceiveMetrics
+            {
+                std::uint64_t bytes;
+                std::uint64_t reads;
+                std::uint64_t messages;
+            };
+
+            enum
+            {
+                /** The default size of the receive buffer in bytes. */
+                DefaultReceiveBufferSize = 64 * 1024,
+            };
+
+            /**
+             * Initializes a new Connection and registers it with the event loop.
+             * @param loop The event loop which handles the socket.
+             * @param fd A connected socket. The connection takes ownership.
+             * @param handler The handler to forward the received messages to. May
+             *      be nullptr if a derived class handles the messages itself.
+             */
+            Connection(EventLoop& loop, int fd, MessageHandler* handler = nullptr);
+
+            /** Destructor, closes the socket without notifying the handler. */
+            virtual ~Connection();
+
+            /**
+             * Opens a new connection to a remote host. The connection is established
+             * asynchronously, data that is written before is queued.
+             * @param loop The event loop which handles the socket.
+             * @param host The name or address of the remote host.
+             * @param port The tcp/ip port to connect to.
+             * @param handler The handler to forward the received messages to.
+             * @return The new connection. The caller takes ownership.
+             * @throws std::system_error if the address could not be resolved or the
+             *      socket could not be created.
+             */
+            static Connection* connect(EventLoop& loop, std::string const& host, unsigned short port, MessageHandler* handler);
+
+            /**
+             * Returns the event loop which handles this connection.
+             * @return The event loop which handles this connection.
+             */
+            EventLoop& loop() const;
+
+            /**
+             * Returns the handler the received messages are forwarded to.
+             * @return The handler the received messages are forwarded to.
+             */
+            MessageHandler* handler() const;
+
+            /**
+             * Replaces the handler the received messages are forwarded to.
+             * @param value The new handler.
+             */
+            void setHandler(MessageHandler* value);
+
+            /**
+             * Returns true until the connection has been closed.
+             * @return true until the connection has been closed.
+             */
+            bool isOpen() const;
+
+            /**
+             * Enables sending keep-alive requests. When enabled, a keep-alive request
+             * is sent each interval, and the connection is closed if nothing has been
+             * received for two intervals.
+             * @param interval The interval in milliseconds. Zero disables the
+             *      keep-alive requests.
+             */
+            void setKeepAliveInterval(int interval);
+
+            /**
+             * Returns the size of the receive buffer in bytes.
+             * @return The size of the receive buffer in bytes.
+             */
+            size_type receiveBufferSize() const;
+
+            /**
+             * Changes the size of the receive buffer, which limits the number of
+             * bytes read by a single system call.
+             * @param value The new size in bytes, must not be zero.
+             */
+            void setReceiveBufferSize(size_type value);
+
+            /**
+             * Returns the counters of the received data.
+             * @return The counters of the received data.
+             */
+            ReceiveMetrics const& receiveMetrics() const;
+
+            /**
+             * Appends an encoded S101 frame to the outgoing queue. This method may be
+             * called from any thread. If the calling thread doesn't run the event loop,
+             * the buffer is posted to the loop. In that case, the caller has to make
+             * sure that the connection is not deleted before the posted tasks have
+             * been executed.
+             * @param buffer The data to send.
+             */
+            void write(SharedBuffer const& buffer);
+
+            /**
+             * Appends the data defined by the iterators to the outgoing queue.
+             * @param first An iterator to the first element to write.
+             * @param last An iterator to the first element not to write.
+             */
+            template<typename InputIterator>
+            void write(InputIterator first, InputIterator last);
+
+            /**
+             * Closes the socket. The handler is notified from a posted task, so it is
+             * safe to close the connection from within a handler.
+             */
+            void close();
+
+            /** @see EventHandler::handleEvents() */
+            virtual void handleEvents(std::uint32_t events);
+
+        protected:
+            /**
+             * Handles a decoded S101 message. The default implementation forwards the
+             * message to the handler.
+             * @param first Points to the first byte of the decoded message.
+             * @param last Points one past the last byte of the decoded message.
+             */
+            virtual void handleMessage(const_iterator first, const_iterator last);
+
+            /**
+             * Handles the closing of the connection. The default implementation
+             * notifies the handler. A connection that has been accepted by a Server
+             * is released through its factory afterwards, so it must not be deleted
+             * by this method.
+             */
+            virtual void handleDisconnect();
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+            typedef std::deque<SharedBuffer> BufferQueue;
+
+            /**
+             * Reads all available bytes and passes them to the decoder.
+             */
+            void readAvailable();
+
+            /**
+             * Passes the contents of the receive buffer to the decoder and empties
+             * the buffer.
+             */
+            void decodeReceived();
+
+            /**
+             * Writes as many queued bytes as the socket accepts.
+             */
+            void flush();
+
+            /**
+             * Appends a buffer to the queue and tries to write it immediately.
+             * @param buffer The data to send.
+             */
+            void enqueue(SharedBuffer const& buffer);
+
+            /**
+             * Registers the socket with the epoll events matching the current state.
+             */
+            void updateEvents();
+
+            /**
+             * Closes the socket without notifying the handler.
+             */
+            void closeSocket();
+
+            /**
+             * Notifies the handler and the server that the connection has been closed.
+             */
+            void notifyDisconnected();
+
+            /**
+             * Sends a keep-alive request or closes the connection if the peer hasn't
+             * sent anything for too long.
+             */
+            void checkKeepAlive();
+
+            /**
+             * Callback for the s101 decoder.
+             * @param first Points to the first byte of the decoded message.
+             * @param last Points one past the last byte of the decoded message.
+             * @param state The connection that received the message.
+             */
+            static void onMessage(const_iterator first, const_iterator last, Connection* state);
+
+            /**
+             * Returns an encoded keep-alive message.
+             * @param command The command, either KeepAliveRequest or KeepAliveResponse.
+             * @return The encoded keep-alive message.
+             */
+            static SharedBuffer createKeepAliveMessage(unsigned char command);
+
+        private:
+            EventLoop& m_loop;
+            int m_fd;
+            MessageHandler* m_handler;
+            Server* m_server;
+            Decoder m_decoder;
+            RingBuffer m_receiveBuffer;
+            ReceiveMetrics m_receiveMetrics;
+            BufferQueue m_queue;
+            size_type m_offset;
+            bool m_isConnecting;
+            bool m_isWriteWatched;
+            std::shared_ptr<bool> m_isAlive;
+            EventLoop::TimerId m_keepAliveTimer;
+            std::chrono::milliseconds m_keepAliveInterval;
+            Clock::time_point m_lastReceived;
+    };
+
+    /**************************************************************************
+     * Inline implementation                                                  *
+     **************************************************************************/
+
+    template<typename InputIterator>
+    inline void Connection::write(InputIterator first, InputIterator last)
+    {
+        write(std::make_shared<Buffer const>(first, last));
+    }
+}
+
+#endif  // __LIBS101NET_CONNECTION_HPP
@@ -0,0 +1,182 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101NET_EVENTLOOP_HPP
+#define __LIBS101NET_EVENTLOOP_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libs101net
+{
+    /**
+     * Interface of objects which are notified when a file descriptor that has
+     * been registered with an EventLoop becomes ready.
+     */
+    class EventHandler
+    {
+        public:
+            /** Destructor */
+            virtual ~EventHandler()
+            {}
+
+            /**
+             * Called by the event loop when the registered file descriptor is ready.
+             * @param events The epoll events that have been signaled.
+             */
+            virtual void handleEvents(std::uint32_t events) = 0;
+    };
+
+    /**
+     * A single threaded event loop based on epoll. File descriptors are registered
+     * together with an EventHandler, which is notified from within run() when the
+     * descriptor becomes ready. Other threads may hand work over to the loop by
+     * posting tasks, which are executed in the order they have been posted.
+     * In addition, the loop supports simple timers.
+     */
+    class EventLoop
+    {
+        public:
+            typedef std::function<void()> Task;
+            typedef std::uint64_t TimerId;
+
+            /**
+             * Initializes a new EventLoop.
+             * @throws std::system_error if the epoll instance could not be created.
+             */
+            EventLoop();
+
+            /** Destructor, closes the epoll instance. Pending tasks are discarded. */
+            ~EventLoop();
+
+            /**
+             * Registers a file descriptor.
+             * @param fd The file descriptor to watch.
+             * @param events The epoll events to watch, for example EPOLLIN.
+             * @param handler The handler to notify when the descriptor is ready.
+             * @throws std::system_error if the descriptor could not be registered.
+             */
+            void add(int fd, std::uint32_t events, EventHandler* handler);
+
+            /**
+             * Changes the events watched for a registered file descriptor.
+             * @param fd The registered file descriptor.
+             * @param events The epoll events to watch.
+             * @param handler The handler to notify when the descriptor is ready.
+             */
+            void modify(int fd, std::uint32_t events, EventHandler* handler);
+
+            /**
+             * Unregisters a file descriptor. Events of the descriptor that have
+             * already been fetched by the current iteration are still delivered,
+             * so handlers must not be deleted before the loop has returned to
+             * the posted tasks.
+             * @param fd The file descriptor to unregister.
+             */
+            void remove(int fd);
+
+            /**
+             * Appends a task to the queue of posted tasks and wakes up the loop.
+             * This method may be called from any thread.
+             * @param task The task to execute on the loop thread.
+             */
+            void post(Task task);
+
+            /**
+             * Starts a timer. This method may be called from any thread.
+             * @param interval The interval in milliseconds.
+             * @param task The task to execute when the timer has elapsed.
+             * @param isRepeating If false, the timer is stopped after it has elapsed once.
+             * @return The identifier of the new timer.
+             */
+            TimerId startTimer(int interval, Task task, bool isRepeating = false);
+
+            /**
+             * Stops a timer. This method may be called from any thread. Stopping a
+             * timer that has already been stopped has no effect.
+             * @param id The identifier returned by startTimer.
+             */
+            void stopTimer(TimerId id);
+
+            /**
+             * Runs the loop on the calling thread until stop is called.
+             */
+            void run();
+
+            /**
+             * Lets run() return after the current iteration. This method may be
+             * called from any thread.
+             */
+            void stop();
+
+            /**
+             * Returns true if the calling thread is the one executing run().
+             * @return true if the calling thread is the one executing run().
+             */
+            bool isInLoopThread() const;
+
+        private:
+            typedef std::chrono::steady_clock Clock;
+
+            /**
+             * Contains the state of a running timer.
+             */
+            struct Timer
+            {
+                Clock::time_point due;
+                std::chrono::milliseconds interval;
+                Task task;
+                bool isRepeating;
+            };
+
+            typedef std::map<TimerId, Timer> TimerMap;
+
+            /**
+             * Interrupts a blocking epoll_wait.
+             */
+            void wakeup();
+
+            /**
+             * Executes all tasks that have been posted before this method was called.
+             */
+            void runPosted();
+
+            /**
+             * Executes the tasks of all timers which have elapsed. The task of a timer
+             * that is stopped by an earlier task of the same pass is not executed.
+             */
+            void runTimers();
+
+            /**
+             * Returns the number of milliseconds until the next timer is due.
+             * @return The number of milliseconds until the next timer is due, or -1
+             *      if no timer is running.
+             */
+            int nextTimeout();
+
+        private:
+            enum { MaxEvents = 64, };
+
+            int m_epoll;
+            int m_wakeup;
+            std::atomic<bool> m_isStopped;
+            std::atomic<std::thread::id> m_threadId;
+            std::mutex m_mutex;
+            std::vector<Task> m_tasks;
+            TimerMap m_timers;
+            TimerId m_nextTimerId;
+    };
+}
+
+#endif  // __LIBS101NET_EVENTLOOP_HPP
@@ -0,0 +1,52 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101NET_MESSAGEHANDLER_HPP
+#define __LIBS101NET_MESSAGEHANDLER_HPP
+
+#include <vector>
+
+namespace libs101net
+{
+    /** Forward declaration */
+    class Connection;
+
+    /**
+     * Interface which can be plugged into a Connection to handle the S101 messages
+     * it receives.
+     */
+    class MessageHandler
+    {
+        public:
+            typedef std::vector<unsigned char>::const_iterator const_iterator;
+
+            /** Destructor */
+            virtual ~MessageHandler()
+            {}
+
+            /**
+             * Called for each S101 message that has been decoded and is not handled by
+             * the connection itself. Keep-alive requests and responses are answered
+             * by the connection and not forwarded.
+             * @param connection The connection that received the message.
+             * @param first Points to the first byte of the decoded message, which is
+             *      the slot identifier.
+             * @param last Points one past the last byte of the decoded message.
+             */
+            virtual void messageReceived(Connection* connection, const_iterator first, const_iterator last) = 0;
+
+            /**
+             * Called once when the connection has been closed, either by the peer,
+             * due to an error or because a keep-alive has timed out.
+             * @param connection The connection that has been closed.
+             */
+            virtual void disconnected(Connection* connection) = 0;
+    };
+}
+
+#endif  // __LIBS101NET_MESSAGEHANDLER_HPP
@@ -0,0 +1,177 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101NET_RINGBUFFER_HPP
+#define __LIBS101NET_RINGBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <sys/uio.h>
+
+namespace libs101net
+{
+    /**
+     * A fixed size byte ring buffer. The free space and the buffered data are
+     * each exposed as at most two contiguous regions, so the buffer can be
+     * filled with a single readv call and drained without copying.
+     */
+    class RingBuffer
+    {
+        public:
+            typedef unsigned char value_type;
+            typedef std::size_t size_type;
+
+            /**
+             * Initializes a new, empty RingBuffer.
+             * @param capacity The number of bytes the buffer can hold.
+             */
+            explicit RingBuffer(size_type capacity);
+
+            /**
+             * Returns the number of bytes the buffer can hold.
+             * @return The number of bytes the buffer can hold.
+             */
+            size_type capacity() const;
+
+            /**
+             * Returns the number of buffered bytes.
+             * @return The number of buffered bytes.
+             */
+            size_type size() const;
+
+            /**
+             * Returns true if the buffer contains no data.
+             * @return true if the buffer contains no data.
+             */
+            bool empty() const;
+
+            /**
+             * Changes the capacity of the buffer and discards the buffered data.
+             * @param capacity The new capacity in bytes.
+             */
+            void reset(size_type capacity);
+
+            /**
+             * Describes the free space of the buffer, in the order it is filled.
+             * @param regions An array of at least two elements which receives the
+             *      free regions.
+             * @return The number of regions that have been stored, between 0 and 2.
+             */
+            int freeRegions(iovec* regions);
+
+            /**
+             * Appends bytes that have been written to the free regions.
+             * @param count The number of bytes written, which must not exceed the
+             *      free space.
+             */
+            void commit(size_type count);
+
+            /**
+             * Describes the buffered data, in the order it has been appended.
+             * @param regions An array of at least two elements which receives the
+             *      data regions.
+             * @return The number of regions that have been stored, between 0 and 2.
+             */
+            int dataRegions(iovec* regions);
+
+            /**
+             * Removes bytes from the beginning of the buffered data.
+             * @param count The number of bytes to remove, which must not exceed
+             *      the number of buffered bytes.
+             */
+            void consume(size_type count);
+
+        private:
+            std::vector<value_type> m_data;
+            size_type m_head;
+            size_type m_size;
+    };
+
+    /**************************************************************************
+     * Inline implementation                                                  *
+     **************************************************************************/
+
+    inline RingBuffer::RingBuffer(size_type capacity)
+        : m_data(capacity)
+        , m_head(0)
+        , m_size(0)
+    {}
+
+    inline RingBuffer::size_type RingBuffer::capacity() const
+    {
+        return m_data.size();
+    }
+
+    inline RingBuffer::size_type RingBuffer::size() const
+    {
+        return m_size;
+    }
+
+    inline bool RingBuffer::empty() const
+    {
+        return m_size == 0;
+    }
+
+    inline void RingBuffer::reset(size_type capacity)
+    {
+        std::vector<value_type>(capacity).swap(m_data);
+        m_head = 0;
+        m_size = 0;
+    }
+
+    inline int RingBuffer::freeRegions(iovec* regions)
+    {
+        auto const capacity = m_data.size();
+        auto const available = capacity - m_size;
+        if (available == 0)
+            return 0;
+
+        auto const tail = (m_head + m_size) % capacity;
+        auto const first = std::min(available, capacity - tail);
+        regions[0].iov_base = m_data.data() + tail;
+        regions[0].iov_len = first;
+
+        if (first == available)
+            return 1;
+
+        regions[1].iov_base = m_data.data();
+        regions[1].iov_len = available - first;
+        return 2;
+    }
+
+    inline void RingBuffer::commit(size_type count)
+    {
+        m_size += count;
+    }
+
+    inline int RingBuffer::dataRegions(iovec* regions)
+    {
+        if (m_size == 0)
+            return 0;
+
+        auto const first = std::min(m_size, m_data.size() - m_head);
+        regions[0].iov_base = m_data.data() + m_head;
+        regions[0].iov_len = first;
+
+        if (first == m_size)
+            return 1;
+
+        regions[1].iov_base = m_data.data();
+        regions[1].iov_len = m_size - first;
+        return 2;
+    }
+
+    inline void RingBuffer::consume(size_type count)
+    {
+        m_head = (m_head + count) % m_data.size();
+        m_size -= count;
+    }
+}
+
+#endif  // __LIBS101NET_RINGBUFFER_HPP
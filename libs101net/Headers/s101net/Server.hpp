@@ -0,0 +1,131 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __LIBS101NET_SERVER_HPP
+#define __LIBS101NET_SERVER_HPP
+
+#include <mutex>
+#include <vector>
+#include "Connection.hpp"
+#include "EventLoop.hpp"
+
+namespace libs101net
+{
+    /**
+     * Interface which is used by the Server to create and release connections.
+     */
+    class ConnectionFactory
+    {
+        public:
+            /** Destructor */
+            virtual ~ConnectionFactory()
+            {}
+
+            /**
+             * The server invokes this method when a new connection has been accepted.
+             * @param loop The event loop of the server.
+             * @param fd The accepted socket.
+             * @return A new Connection, or an instance of a class derived from it.
+             *      If nullptr is returned, the socket is closed.
+             */
+            virtual Connection* create(EventLoop& loop, int fd) = 0;
+
+            /**
+             * The server invokes this method when a connection has been closed and
+             * has been removed from the list of connections. The factory is responsible
+             * for deleting the connection once it is no longer used.
+             * @param connection The connection to release.
+             */
+            virtual void release(Connection* connection) = 0;
+    };
+
+    /**
+     * Listens to a tcp/ip port and uses a factory to create connections for the
+     * accepted sockets.
+     */
+    class Server : public EventHandler
+    {
+        friend class Connection;
+        public:
+            typedef Connection::SharedBuffer SharedBuffer;
+
+            /**
+             * Initializes a new Server, which immediately starts listening.
+             * @param loop The event loop which handles the listening socket and all
+             *      accepted connections.
+             * @param factory The factory which creates the connections.
+             * @param port The tcp/ip port to listen to. If zero, an unused port is
+             *      chosen, which may be queried with port().
+             * @throws std::system_error if the port could not be opened.
+             */
+            Server(EventLoop& loop, ConnectionFactory* factory, unsigned short port);
+
+            /** Destructor, closes the listening socket and deletes all open connections. */
+            virtual ~Server();
+
+            /**
+             * Returns the port the server listens to.
+             * @return The port the server listens to.
+             */
+            unsigned short port() const;
+
+            /**
+             * Sends the passed buffer to all currently open connections. This method
+             * may be called from any thread, all connections share the same buffer.
+             * @param buffer The data to send.
+             */
+            void write(SharedBuffer const& buffer);
+
+            /**
+             * Sends the passed buffer to all currently open connections for which
+             * @p filter returns true. This method may be called from any thread.
+             * @param buffer The data to send.
+             * @param filter A function object which is called with a pointer to
+             *      each open connection.
+             */
+            template<typename ConnectionPredicate>
+            void write(SharedBuffer const& buffer, ConnectionPredicate filter);
+
+            /** @see EventHandler::handleEvents() */
+            virtual void handleEvents(std::uint32_t events);
+
+        private:
+            /**
+             * Removes a closed connection and passes it to the factory.
+             * @param connection The connection that has been closed.
+             */
+            void release(Connection* connection);
+
+        private:
+            typedef std::vector<Connection*> ConnectionCollection;
+
+            EventLoop& m_loop;
+            ConnectionFactory* const m_factory;
+            int m_fd;
+            unsigned short m_port;
+            std::mutex m_mutex;
+            ConnectionCollection m_connections;
+    };
+
+    /**************************************************************************
+     * Mandatory inline implementation                                        *
+     **************************************************************************/
+
+    template<typename ConnectionPredicate>
+    inline void Server::write(SharedBuffer const& buffer, ConnectionPredicate filter)
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        for (auto connection : m_connections)
+        {
+            if (filter(connection))
+                connection->write(buffer);
+        }
+    }
+}
+
+#endif  // __LIBS101NET_SERVER_HPP
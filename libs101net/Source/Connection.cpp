@@ -0,0 +1,453 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <s101/CommandType.hpp>
+#include <s101/MessageType.hpp>
+#include <s101/StreamEncoder.hpp>
+#include <s101net/Connection.hpp>
+#include <s101net/Server.hpp>
+
+namespace libs101net
+{
+    namespace
+    {
+        /** The maximum number of queued buffers passed to a single sendmsg call. */
+        std::size_t const MaxIoVectors = 16;
+    }
+
+    Connection::Connection(EventLoop& loop, int fd, MessageHandler* handler)
+        : m_loop(loop)
+        , m_fd(fd)
+        , m_handler(handler)
+        , m_server(nullptr)
+        , m_receiveBuffer(DefaultReceiveBufferSize)
+        , m_receiveMetrics()
+        , m_offset(0)
+        , m_isConnecting(false)
+        , m_isWriteWatched(false)
+        , m_isAlive(std::make_shared<bool>(true))
+        , m_keepAliveTimer(0)
+        , m_keepAliveInterval(0)
+        , m_lastReceived(Clock::now())
+    {
+        auto const flags = ::fcntl(m_fd, F_GETFL, 0);
+        ::fcntl(m_fd, F_SETFL, flags | O_NONBLOCK);
+
+        // Ember+ messages are usually small and latency sensitive.
+        auto const noDelay = 1;
+        ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        m_loop.add(m_fd, EPOLLIN, this);
+    }
+
+    Connection::~Connection()
+    {
+        *m_isAlive = false;
+        closeSocket();
+    }
+
+    //static
+    Connection* Connection::connect(EventLoop& loop, std::string const& host, unsigned short port, MessageHandler* handler)
+    {
+        auto hints = addrinfo();
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        auto addresses = static_cast<addrinfo*>(nullptr);
+        auto const service = std::to_string(port);
+        auto const result = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses);
+        if (result != 0)
+            throw std::system_error(result, std::system_category(), ::gai_strerror(result));
+
+        auto error = 0;
+        for (auto address = addresses; address != nullptr; address = address->ai_next)
+        {
+            auto const fd = ::socket(address->ai_family, address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, address->ai_protocol);
+            if (fd < 0)
+            {
+                error = errno;
+                continue;
+            }
+
+            auto const status = ::connect(fd, address->ai_addr, address->ai_addrlen);
+            if (status == 0 || errno == EINPROGRESS)
+            {
+                auto const isConnecting = status != 0;
+                ::freeaddrinfo(addresses);
+
+                auto const connection = new Connection(loop, fd, handler);
+                connection->m_isConnecting = isConnecting;
+                connection->updateEvents();
+                return connection;
+            }
+
+            error = errno;
+            ::close(fd);
+        }
+
+        ::freeaddrinfo(addresses);
+        throw std::system_error(error, std::system_category(), "connect");
+    }
+
+    EventLoop& Connection::loop() const
+    {
+        return m_loop;
+    }
+
+    MessageHandler* Connection::handler() const
+    {
+        return m_handler;
+    }
+
+    void Connection::setHandler(MessageHandler* value)
+    {
+        m_handler = value;
+    }
+
+    bool Connection::isOpen() const
+    {
+        return m_fd >= 0;
+    }
+
+    void Connection::setKeepAliveInterval(int interval)
+    {
+        if (m_keepAliveTimer != 0)
+        {
+            m_loop.stopTimer(m_keepAliveTimer);
+            m_keepAliveTimer = 0;
+        }
+
+        m_keepAliveInterval = std::chrono::milliseconds(interval);
+
+        if (interval > 0 && m_fd >= 0)
+        {
+            auto const isAlive = m_isAlive;
+            m_lastReceived = Clock::now();
+            m_keepAliveTimer = m_loop.startTimer(interval, [this, isAlive]
+            {
+                if (*isAlive)
+                    checkKeepAlive();
+            }, true);
+        }
+    }
+
+    Connection::size_type Connection::receiveBufferSize() const
+    {
+        return m_receiveBuffer.capacity();
+    }
+
+    void Connection::setReceiveBufferSize(size_type value)
+    {
+        // The buffer is emptied after each read, so no data is discarded.
+        if (value > 0)
+            m_receiveBuffer.reset(value);
+    }
+
+    Connection::ReceiveMetrics const& Connection::receiveMetrics() const
+    {
+        return m_receiveMetrics;
+    }
+
+    void Connection::write(SharedBuffer const& buffer)
+    {
+        if (m_loop.isInLoopThread())
+        {
+            enqueue(buffer);
+        }
+        else
+        {
+            auto const isAlive = m_isAlive;
+            m_loop.post([this, isAlive, buffer]
+            {
+                if (*isAlive)
+                    enqueue(buffer);
+            });
+        }
+    }
+
+    void Connection::close()
+    {
+        if (m_fd < 0)
+            return;
+
+        closeSocket();
+
+        auto const isAlive = m_isAlive;
+        m_loop.post([this, isAlive]
+        {
+            if (*isAlive)
+                notifyDisconnected();
+        });
+    }
+
+    void Connection::handleEvents(std::uint32_t events)
+    {
+        if (m_fd < 0)
+            return;
+
+        if (m_isConnecting)
+        {
+            if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) == 0)
+                return;
+
+            auto error = 0;
+            auto length = socklen_t(sizeof(error));
+            ::getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &error, &length);
+            if (error != 0)
+            {
+                close();
+                return;
+            }
+
+            m_isConnecting = false;
+            m_lastReceived = Clock::now();
+            flush();
+        }
+
+        if (events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+            readAvailable();
+
+        if (m_fd >= 0 && (events & EPOLLOUT))
+            flush();
+    }
+
+    void Connection::handleMessage(const_iterator first, const_iterator last)
+    {
+        auto const handler = m_handler;
+        if (handler != nullptr)
+            handler->messageReceived(this, first, last);
+    }
+
+    void Connection::handleDisconnect()
+    {
+        auto const handler = m_handler;
+        if (handler != nullptr)
+            handler->disconnected(this);
+    }
+
+    void Connection::readAvailable()
+    {
+        while (m_fd >= 0)
+        {
+            iovec vectors[2];
+            auto const count = m_receiveBuffer.freeRegions(vectors);
+            auto const size = ::readv(m_fd, vectors, count);
+            if (size > 0)
+            {
+                m_receiveBuffer.commit(static_cast<size_type>(size));
+                m_receiveMetrics.bytes += static_cast<size_type>(size);
+                ++m_receiveMetrics.reads;
+                m_lastReceived = Clock::now();
+                decodeReceived();
+
+                // The socket is watched level-triggered, so a short read means that it
+                // has been drained and saves the call that would fail with EAGAIN.
+                if (static_cast<size_type>(size) < m_receiveBuffer.capacity())
+                    break;
+            }
+            else if (size == 0)
+            {
+                close();
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            else if (errno != EINTR)
+            {
+                close();
+            }
+        }
+    }
+
+    void Connection::decodeReceived()
+    {
+        iovec spans[2];
+        auto const count = m_receiveBuffer.dataRegions(spans);
+
+        for (auto index = 0; index < count; ++index)
+        {
+            auto const first = static_cast<value_type const*>(spans[index].iov_base);
+            m_decoder.readSpan(first, first + spans[index].iov_len, &Connection::onMessage, this);
+        }
+
+        m_receiveBuffer.consume(m_receiveBuffer.size());
+    }
+
+    void Connection::flush()
+    {
+        if (m_fd < 0 || m_isConnecting)
+            return;
+
+        while (m_queue.empty() == false)
+        {
+            iovec vectors[MaxIoVectors];
+            auto count = std::size_t(0);
+            for (auto it = m_queue.begin(); it != m_queue.end() && count < MaxIoVectors; ++it, ++count)
+            {
+                auto const& buffer = **it;
+                auto const offset = count == 0 ? m_offset : 0;
+                vectors[count].iov_base = const_cast<value_type*>(buffer.data() + offset);
+                vectors[count].iov_len = buffer.size() - offset;
+            }
+
+            auto message = msghdr();
+            message.msg_iov = vectors;
+            message.msg_iovlen = count;
+
+            auto const written = ::sendmsg(m_fd, &message, MSG_NOSIGNAL);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+
+                close();
+                return;
+            }
+
+            auto remaining = static_cast<size_type>(written);
+            while (remaining > 0)
+            {
+                auto const available = m_queue.front()->size() - m_offset;
+                if (remaining < available)
+                {
+                    m_offset += remaining;
+                    remaining = 0;
+                }
+                else
+                {
+                    remaining -= available;
+                    m_offset = 0;
+                    m_queue.pop_front();
+                }
+            }
+        }
+
+        updateEvents();
+    }
+
+    void Connection::enqueue(SharedBuffer const& buffer)
+    {
+        if (m_fd < 0 || buffer == nullptr || buffer->empty())
+            return;
+
+        // If the queue already contains data, the socket is watched for EPOLLOUT
+        // and the buffer is written when the socket is ready.
+        auto const isIdle = m_queue.empty();
+        m_queue.push_back(buffer);
+
+        if (isIdle)
+            flush();
+    }
+
+    void Connection::updateEvents()
+    {
+        if (m_fd < 0)
+            return;
+
+        auto const isWriteRequired = m_isConnecting || m_queue.empty() == false;
+        if (isWriteRequired != m_isWriteWatched)
+        {
+            m_isWriteWatched = isWriteRequired;
+            m_loop.modify(m_fd, EPOLLIN | (isWriteRequired ? std::uint32_t(EPOLLOUT) : 0U), this);
+        }
+    }
+
+    void Connection::closeSocket()
+    {
+        if (m_keepAliveTimer != 0)
+        {
+            m_loop.stopTimer(m_keepAliveTimer);
+            m_keepAliveTimer = 0;
+        }
+
+        if (m_fd >= 0)
+        {
+            m_loop.remove(m_fd);
+            ::close(m_fd);
+            m_fd = -1;
+        }
+
+        m_queue.clear();
+        m_offset = 0;
+    }
+
+    void Connection::notifyDisconnected()
+    {
+        auto const server = m_server;
+        handleDisconnect();
+
+        if (server != nullptr)
+            server->release(this);
+    }
+
+    void Connection::checkKeepAlive()
+    {
+        if (m_fd < 0 || m_isConnecting)
+            return;
+
+        if (Clock::now() - m_lastReceived > 2 * m_keepAliveInterval)
+        {
+            close();
+        }
+        else
+        {
+            static auto const request = createKeepAliveMessage(libs101::CommandType::KeepAliveRequest);
+            enqueue(request);
+        }
+    }
+
+    //static
+    void Connection::onMessage(const_iterator first, const_iterator last, Connection* state)
+    {
+        ++state->m_receiveMetrics.messages;
+
+        // Slot, message type and command
+        if (last - first >= 3 && first[1] == libs101::MessageType::EmBER)
+        {
+            auto const command = first[2];
+            if (command == libs101::CommandType::KeepAliveRequest)
+            {
+                static auto const response = createKeepAliveMessage(libs101::CommandType::KeepAliveResponse);
+                state->enqueue(response);
+                return;
+            }
+            else if (command == libs101::CommandType::KeepAliveResponse)
+            {
+                return;
+            }
+        }
+
+        state->handleMessage(first, last);
+    }
+
+    //static
+    Connection::SharedBuffer Connection::createKeepAliveMessage(unsigned char command)
+    {
+        auto encoder = libs101::StreamEncoder<value_type>();
+        encoder.encode(0x00);                           // Slot
+        encoder.encode(libs101::MessageType::EmBER);    // Message Type
+        encoder.encode(command);                        // Command
+        encoder.encode(0x01);                           // Framing Version (1)
+        encoder.finish();
+        return std::make_shared<Buffer const>(encoder.begin(), encoder.end());
+    }
+}
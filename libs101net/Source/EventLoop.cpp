@@ -0,0 +1,253 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <cerrno>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <s101net/EventLoop.hpp>
+
+namespace libs101net
+{
+    EventLoop::EventLoop()
+        : m_epoll(::epoll_create1(EPOLL_CLOEXEC))
+        , m_wakeup(-1)
+        , m_isStopped(false)
+        , m_threadId(std::thread::id())
+        , m_nextTimerId(0)
+    {
+        if (m_epoll < 0)
+            throw std::system_error(errno, std::system_category(), "epoll_create1");
+
+        m_wakeup = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_wakeup < 0)
+        {
+            auto const error = errno;
+            ::close(m_epoll);
+            throw std::system_error(error, std::system_category(), "eventfd");
+        }
+
+        // The wakeup descriptor is the only one registered without a handler.
+        auto event = epoll_event();
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &event);
+    }
+
+    EventLoop::~EventLoop()
+    {
+        ::close(m_wakeup);
+        ::close(m_epoll);
+    }
+
+    void EventLoop::add(int fd, std::uint32_t events, EventHandler* handler)
+    {
+        auto event = epoll_event();
+        event.events = events;
+        event.data.ptr = handler;
+
+        if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+            throw std::system_error(errno, std::system_category(), "epoll_ctl");
+    }
+
+    void EventLoop::modify(int fd, std::uint32_t events, EventHandler* handler)
+    {
+        auto event = epoll_event();
+        event.events = events;
+        event.data.ptr = handler;
+        ::epoll_ctl(m_epoll, EPOLL_CTL_MOD, fd, &event);
+    }
+
+    void EventLoop::remove(int fd)
+    {
+        ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    void EventLoop::post(Task task)
+    {
+        auto isWakeupRequired = false;
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+
+            // A non-empty queue means that a wakeup is already pending.
+            isWakeupRequired = m_tasks.empty();
+            m_tasks.push_back(std::move(task));
+        }
+
+        if (isWakeupRequired)
+            wakeup();
+    }
+
+    EventLoop::TimerId EventLoop::startTimer(int interval, Task task, bool isRepeating)
+    {
+        auto id = TimerId(0);
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            auto timer = Timer();
+            timer.interval = std::chrono::milliseconds(interval);
+            timer.due = Clock::now() + timer.interval;
+            timer.task = std::move(task);
+            timer.isRepeating = isRepeating;
+
+            id = ++m_nextTimerId;
+            m_timers.insert(std::make_pair(id, std::move(timer)));
+        }
+
+        // The loop has to recompute its timeout.
+        if (isInLoopThread() == false)
+            wakeup();
+
+        return id;
+    }
+
+    void EventLoop::stopTimer(TimerId id)
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        m_timers.erase(id);
+    }
+
+    void EventLoop::run()
+    {
+        m_threadId = std::this_thread::get_id();
+
+        epoll_event events[MaxEvents];
+        while (m_isStopped == false)
+        {
+            auto const count = ::epoll_wait(m_epoll, events, MaxEvents, nextTimeout());
+            if (count < 0 && errno != EINTR)
+                throw std::system_error(errno, std::system_category(), "epoll_wait");
+
+            for (auto index = 0; index < count; ++index)
+            {
+                auto const handler = static_cast<EventHandler*>(events[index].data.ptr);
+                if (handler != nullptr)
+                {
+                    handler->handleEvents(events[index].events);
+                }
+                else
+                {
+                    auto value = std::uint64_t(0);
+                    while (::read(m_wakeup, &value, sizeof(value)) > 0)
+                        ;
+                }
+            }
+
+            runTimers();
+            runPosted();
+        }
+
+        m_isStopped = false;
+        m_threadId = std::thread::id();
+    }
+
+    void EventLoop::stop()
+    {
+        m_isStopped = true;
+        wakeup();
+    }
+
+    bool EventLoop::isInLoopThread() const
+    {
+        return m_threadId.load() == std::this_thread::get_id();
+    }
+
+    void EventLoop::wakeup()
+    {
+        auto const value = std::uint64_t(1);
+        auto const result = ::write(m_wakeup, &value, sizeof(value));
+        static_cast<void>(result);
+    }
+
+    void EventLoop::runPosted()
+    {
+        auto tasks = std::vector<Task>();
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            tasks.swap(m_tasks);
+        }
+
+        for (auto& task : tasks)
+            task();
+    }
+
+    void EventLoop::runTimers()
+    {
+        auto ids = std::vector<TimerId>();
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            auto const now = Clock::now();
+            for (auto& entry : m_timers)
+            {
+                auto& timer = entry.second;
+                if (timer.due > now)
+                    continue;
+
+                ids.push_back(entry.first);
+
+                // A timer that has been delayed by a busy loop does not catch up.
+                if (timer.isRepeating)
+                {
+                    timer.due += timer.interval;
+                    if (timer.due <= now)
+                        timer.due = now + timer.interval;
+                }
+            }
+        }
+
+        // A task may stop a timer that has elapsed in the same pass, so each timer
+        // is looked up again right before its task is executed.
+        for (auto const id : ids)
+        {
+            auto task = Task();
+            {
+                std::lock_guard<std::mutex> const lock(m_mutex);
+                auto const it = m_timers.find(id);
+                if (it == m_timers.end())
+                    continue;
+
+                if (it->second.isRepeating)
+                {
+                    task = it->second.task;
+                }
+                else
+                {
+                    task = std::move(it->second.task);
+                    m_timers.erase(it);
+                }
+            }
+
+            task();
+        }
+    }
+
+    int EventLoop::nextTimeout()
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        if (m_tasks.empty() == false)
+            return 0;
+
+        if (m_timers.empty())
+            return -1;
+
+        auto due = m_timers.begin()->second.due;
+        for (auto const& entry : m_timers)
+        {
+            if (entry.second.due < due)
+                due = entry.second.due;
+        }
+
+        auto const now = Clock::now();
+        if (due <= now)
+            return 0;
+
+        // Round up, so that the timer has elapsed when epoll_wait returns.
+        auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(due - now + std::chrono::microseconds(999));
+        return static_cast<int>(remaining.count());
+    }
+}
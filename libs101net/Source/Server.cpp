@@ -0,0 +1,132 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <s101net/Server.hpp>
+
+namespace libs101net
+{
+    namespace
+    {
+        /** The number of pending connections the kernel queues for the listening socket. */
+        int const ListenBacklog = 64;
+    }
+
+    Server::Server(EventLoop& loop, ConnectionFactory* factory, unsigned short port)
+        : m_loop(loop)
+        , m_factory(factory)
+        , m_fd(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0))
+        , m_port(port)
+    {
+        if (m_fd < 0)
+            throw std::system_error(errno, std::system_category(), "socket");
+
+        auto const yes = 1;
+        ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+        auto address = sockaddr_in();
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+
+        auto length = socklen_t(sizeof(address));
+        if (::bind(m_fd, reinterpret_cast<sockaddr*>(&address), length) < 0
+        ||  ::listen(m_fd, ListenBacklog) < 0
+        ||  ::getsockname(m_fd, reinterpret_cast<sockaddr*>(&address), &length) < 0)
+        {
+            auto const error = errno;
+            ::close(m_fd);
+            throw std::system_error(error, std::system_category(), "listen");
+        }
+
+        m_port = ntohs(address.sin_port);
+        m_loop.add(m_fd, EPOLLIN, this);
+    }
+
+    Server::~Server()
+    {
+        m_loop.remove(m_fd);
+        ::close(m_fd);
+
+        auto connections = ConnectionCollection();
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            connections.swap(m_connections);
+        }
+
+        for (auto connection : connections)
+            delete connection;
+    }
+
+    unsigned short Server::port() const
+    {
+        return m_port;
+    }
+
+    void Server::write(SharedBuffer const& buffer)
+    {
+        std::lock_guard<std::mutex> const lock(m_mutex);
+        for (auto connection : m_connections)
+        {
+            connection->write(buffer);
+        }
+    }
+
+    void Server::handleEvents(std::uint32_t)
+    {
+        while (true)
+        {
+            auto const fd = ::accept4(m_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+            {
+                // Errors of a single pending connection, like ECONNABORTED, must not
+                // stop the server, so only the accept loop is left.
+                if (errno == EINTR)
+                    continue;
+
+                break;
+            }
+
+            auto const connection = m_factory->create(m_loop, fd);
+            if (connection != nullptr)
+            {
+                connection->m_server = this;
+
+                std::lock_guard<std::mutex> const lock(m_mutex);
+                m_connections.push_back(connection);
+            }
+            else
+            {
+                ::close(fd);
+            }
+        }
+    }
+
+    void Server::release(Connection* connection)
+    {
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            auto const first = m_connections.begin();
+            auto const last = m_connections.end();
+            auto const result = std::find(first, last, connection);
+            if (result != last)
+            {
+                m_connections.erase(result);
+            }
+        }
+
+        connection->m_server = nullptr;
+        m_factory->release(connection);
+    }
+}
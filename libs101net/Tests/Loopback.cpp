@@ -0,0 +1,216 @@
+/*
+    libs101net -- Non-blocking transport for S101 framed Ember+ connections
+
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <s101/CommandType.hpp>
+#include <s101/MessageType.hpp>
+#include <s101/StreamEncoder.hpp>
+#include <s101net/Connection.hpp>
+#include <s101net/EventLoop.hpp>
+#include <s101net/Server.hpp>
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    typedef libs101::StreamEncoder<unsigned char> Encoder;
+
+    std::vector<unsigned char> encodeMessage(unsigned char command, unsigned char payload)
+    {
+        Encoder encoder;
+        encoder.encode(0x00);
+        encoder.encode(libs101::MessageType::EmBER);
+        encoder.encode(command);
+        encoder.encode(0x01);
+        encoder.encode(payload);
+        encoder.finish();
+        return std::vector<unsigned char>(encoder.begin(), encoder.end());
+    }
+
+    /**
+     * Sends each received message back to the peer.
+     */
+    class EchoHandler : public libs101net::MessageHandler
+    {
+    public:
+        EchoHandler()
+            : received(0)
+            , isDisconnected(false)
+        {}
+
+        virtual void messageReceived(libs101net::Connection* connection, const_iterator first, const_iterator last)
+        {
+            Encoder encoder;
+            encoder.encode(first, last);
+            encoder.finish();
+            connection->write(encoder.begin(), encoder.end());
+            ++received;
+        }
+
+        virtual void disconnected(libs101net::Connection*)
+        {
+            isDisconnected = true;
+        }
+
+        int received;
+        bool isDisconnected;
+    };
+
+    /**
+     * Creates connections that echo the received messages.
+     */
+    class EchoFactory : public libs101net::ConnectionFactory
+    {
+    public:
+        EchoFactory()
+            : accepted(0)
+            , released(0)
+        {}
+
+        virtual libs101net::Connection* create(libs101net::EventLoop& loop, int fd)
+        {
+            ++accepted;
+            return new libs101net::Connection(loop, fd, &handler);
+        }
+
+        virtual void release(libs101net::Connection* connection)
+        {
+            ++released;
+            connection->loop().stop();
+            delete connection;
+        }
+
+        EchoHandler handler;
+        int accepted;
+        int released;
+    };
+
+    /**
+     * Records the messages received by the client and closes the connection
+     * once all expected messages have arrived.
+     */
+    class ClientHandler : public libs101net::MessageHandler
+    {
+    public:
+        explicit ClientHandler(int expected)
+            : expected(expected)
+        {}
+
+        virtual void messageReceived(libs101net::Connection* connection, const_iterator first, const_iterator last)
+        {
+            if (last - first != 5 || first[2] != libs101::CommandType::EmBER)
+                THROW_TEST_EXCEPTION("Unexpected message of " << (last - first) << " bytes");
+
+            payloads.push_back(first[4]);
+            if (static_cast<int>(payloads.size()) == expected)
+                connection->close();
+        }
+
+        virtual void disconnected(libs101net::Connection*)
+        {}
+
+        int expected;
+        std::vector<unsigned char> payloads;
+    };
+}
+
+int main(int, char const* const*)
+{
+    try
+    {
+        using libs101net::Connection;
+
+        auto const count = 100;
+        libs101net::EventLoop loop;
+        EchoFactory factory;
+        libs101net::Server server(loop, &factory, 0);
+        ClientHandler handler(count);
+        auto client = std::unique_ptr<Connection>(Connection::connect(loop, "127.0.0.1", server.port(), &handler));
+
+        // A receive buffer that is smaller than a frame splits frames across reads
+        // and makes the buffered data wrap around.
+        client->setReceiveBufferSize(7);
+
+        // A keep-alive request is answered by the server connection itself and
+        // the response is not forwarded to the client handler.
+        auto const keepAlive = encodeMessage(libs101::CommandType::KeepAliveRequest, 0);
+        client->write(keepAlive.begin(), keepAlive.end());
+
+        // Messages written by foreign threads are posted to the loop and keep
+        // their order.
+        auto writer = std::thread([&client, count]
+        {
+            for (auto index = 0; index < count; ++index)
+            {
+                auto const message = encodeMessage(libs101::CommandType::EmBER, static_cast<unsigned char>(index));
+                client->write(message.begin(), message.end());
+            }
+        });
+
+        auto const timeout = loop.startTimer(5000, [&loop] { loop.stop(); });
+        loop.run();
+        loop.stopTimer(timeout);
+        writer.join();
+
+        if (factory.accepted != 1 || factory.released != 1)
+            THROW_TEST_EXCEPTION("Invalid number of connections! Accepted " << factory.accepted << ", released " << factory.released);
+
+        if (factory.handler.isDisconnected == false)
+            THROW_TEST_EXCEPTION("The server connection has not been notified about the disconnect");
+
+        if (factory.handler.received != count)
+            THROW_TEST_EXCEPTION("Invalid number of echoed messages! Expected " << count << ", found " << factory.handler.received);
+
+        if (static_cast<int>(handler.payloads.size()) != count)
+            THROW_TEST_EXCEPTION("Invalid number of received messages! Expected " << count << ", found " << handler.payloads.size());
+
+        // The keep-alive response is counted but not forwarded.
+        auto const& metrics = client->receiveMetrics();
+        if (metrics.messages != count + 1u || metrics.bytes == 0 || metrics.reads * 7 < metrics.bytes)
+            THROW_TEST_EXCEPTION("Invalid receive metrics! " << metrics.messages << " messages, " << metrics.bytes << " bytes, " << metrics.reads << " reads");
+
+        for (auto index = 0; index < count; ++index)
+        {
+            if (handler.payloads[index] != index)
+                THROW_TEST_EXCEPTION("Invalid message order! Expected " << index << ", found " << static_cast<int>(handler.payloads[index]));
+        }
+
+        // A timer that is stopped by the task of another timer which elapsed in the
+        // same pass must not be executed anymore.
+        {
+            libs101net::EventLoop timerLoop;
+            auto isStoppedTimerExecuted = false;
+            auto stopped = libs101net::EventLoop::TimerId();
+            timerLoop.startTimer(0, [&timerLoop, &stopped]
+            {
+                timerLoop.stopTimer(stopped);
+                timerLoop.stop();
+            });
+            stopped = timerLoop.startTimer(0, [&isStoppedTimerExecuted] { isStoppedTimerExecuted = true; });
+            timerLoop.run();
+
+            if (isStoppedTimerExecuted)
+                THROW_TEST_EXCEPTION("The task of a stopped timer has been executed");
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -30,6 +30,7 @@ GadgetViewContextMenu::GadgetViewContextMenu(::glow::ConsumerProxy* proxy, QTree
     , m_item(view->currentItem())
     , m_position(view->mapToGlobal(cursor))
     , m_removeItem(false)
+    , m_isStructureChanged(false)
 {
 }
 
@@ -48,6 +49,7 @@ void GadgetViewContextMenu::exec()
                 exec(node);
                 if (m_removeItem)
                 {
+                    m_isStructureChanged = true;
                     delete m_item;
                     delete node;
                 }
@@ -62,6 +64,7 @@ void GadgetViewContextMenu::exec()
                 exec(parameter);
                 if (m_removeItem)
                 {
+                    m_isStructureChanged = true;
                     delete m_item;
                     delete parameter;
                 }
@@ -89,11 +92,17 @@ void GadgetViewContextMenu::exec()
                 item->setData(1, 0, QVariant::fromValue(TreeWidgetItemData(root)));
 
                 m_view->setCurrentItem(item);
+                m_isStructureChanged = true;
             }
         }
     }
 }
 
+bool GadgetViewContextMenu::isStructureChanged() const
+{
+    return m_isStructureChanged;
+}
+
 void GadgetViewContextMenu::exec(gadget::Node* parent)
 {
     QMenu menu;
@@ -137,6 +146,7 @@ void GadgetViewContextMenu::exec(gadget::Node* parent)
             item->setIcon(0, QIcon(":/image/resources/globe-small.png"));
             item->setText(0, ::util::StringConverter::toUtf8QString(node->identifier()));
             item->setData(1, 0, QVariant::fromValue(TreeWidgetItemData(node)));
+            m_isStructureChanged = true;
         }
     }
     else if (selection == newparameter)
@@ -182,6 +192,7 @@ void GadgetViewContextMenu::exec(gadget::Node* parent)
                 item->setIcon(0, QIcon(":/image/resources/leaf.png"));
                 item->setText(0, ::util::StringConverter::toUtf8QString(parameter->identifier()));
                 item->setData(1, 0, QVariant::fromValue(TreeWidgetItemData(parameter)));
+                m_isStructureChanged = true;
             }
         }
     }
@@ -34,6 +34,12 @@ class GadgetViewContextMenu
          */
         void exec();
 
+        /**
+         * Returns true if the context menu has added or removed a node or parameter.
+         * @return true if the structure of a gadget tree has changed.
+         */
+        bool isStructureChanged() const;
+
     private:
         /**
          * Runs the context menu for a selected node.
@@ -53,6 +59,7 @@ class GadgetViewContextMenu
         QPoint const m_position;
         ::glow::ConsumerProxy* m_proxy;
         bool m_removeItem;
+        bool m_isStructureChanged;
 };
 
 #endif//__TINYEMBER_GADGETVIEWCONTEXTMENU_H
@@ -0,0 +1,178 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include "gadget/IntegerParameter.h"
+#include "gadget/Node.h"
+#include "gadget/NodeFactory.h"
+#include "gadget/ParameterFactory.h"
+#include "serialization/AutoSave.h"
+
+#define THROW_TEST_EXCEPTION(message)                       \
+            {                                               \
+                std::ostringstream msgStream;               \
+                msgStream << message ;                      \
+                throw std::runtime_error(msgStream.str());  \
+            }
+
+namespace
+{
+    long valueOf(gadget::Node const* root, int number)
+    {
+        auto const parameter = root->findParameter(number);
+        if (parameter == nullptr)
+        {
+            THROW_TEST_EXCEPTION("Parameter #" << number << " is missing!");
+        }
+
+        return static_cast<gadget::IntegerParameter const*>(parameter)->value();
+    }
+
+    void removeFiles(String const& filename)
+    {
+        auto const name = QString::fromStdString(filename);
+        QFile::remove(name);
+        QFile::remove(name + ".log");
+    }
+
+    /**
+     * Deletes a parameter in the middle of a node, so that the numbers of the remaining
+     * parameters are no longer contiguous, and logs a change of a later sibling. The
+     * logged value must be restored to the same parameter.
+     */
+    void testReplayAfterDeletion(String const& filename)
+    {
+        auto const root = std::unique_ptr<gadget::Node>(gadget::NodeFactory::createRoot("root"));
+        gadget::ParameterFactory::create(root.get(), "a", 0, 100, 1);
+        auto const b = gadget::ParameterFactory::create(root.get(), "b", 0, 100, 2);
+        auto const c = gadget::ParameterFactory::create(root.get(), "c", 0, 100, 3);
+        root->remove(b);
+        delete b;
+        root->clearJournal();
+
+        {
+            serialization::AutoSave autoSave;
+            autoSave.reset(root.get(), filename);
+            root->registerListener(&autoSave);
+            c->setValue(42);
+            root->clearJournal();
+            root->unregisterListener(&autoSave);
+
+            auto const restored = std::unique_ptr<gadget::Node>(autoSave.restore(filename));
+            if (restored == nullptr)
+            {
+                THROW_TEST_EXCEPTION("The autosave could not be restored!");
+            }
+
+            if (restored->findParameter(2) != nullptr)
+            {
+                THROW_TEST_EXCEPTION("The deleted parameter #2 has been restored!");
+            }
+
+            if (valueOf(restored.get(), 1) != 1 || valueOf(restored.get(), 3) != 42)
+            {
+                THROW_TEST_EXCEPTION(
+                    "The logged value has been applied to the wrong parameter! "
+                    << "a = " << valueOf(restored.get(), 1) << ", c = " << valueOf(restored.get(), 3));
+            }
+        }
+
+        removeFiles(filename);
+    }
+
+    /**
+     * Simulates a crash between writing a new snapshot and truncating the log. The log
+     * that belongs to the previous snapshot must not be applied to the new one.
+     */
+    void testStaleLogIsIgnored(String const& filename)
+    {
+        auto const root = std::unique_ptr<gadget::Node>(gadget::NodeFactory::createRoot("root"));
+        auto const a = gadget::ParameterFactory::create(root.get(), "a", 0, 100, 1);
+        root->clearJournal();
+
+        auto staleLog = QByteArray();
+        {
+            serialization::AutoSave autoSave;
+            autoSave.reset(root.get(), filename);
+            root->registerListener(&autoSave);
+            a->setValue(42);
+            root->clearJournal();
+            root->unregisterListener(&autoSave);
+        }
+
+        {
+            QFile log(QString::fromStdString(filename) + ".log");
+            if (log.open(QIODevice::ReadOnly) == false)
+            {
+                THROW_TEST_EXCEPTION("The change log has not been written!");
+            }
+
+            staleLog = log.readAll();
+        }
+
+        a->setValue(7);
+        root->clearJournal();
+
+        {
+            serialization::AutoSave autoSave;
+            autoSave.reset(root.get(), filename);
+        }
+
+        {
+            QFile log(QString::fromStdString(filename) + ".log");
+            if (log.open(QIODevice::WriteOnly | QIODevice::Truncate) == false)
+            {
+                THROW_TEST_EXCEPTION("The change log cannot be replaced!");
+            }
+
+            log.write(staleLog);
+        }
+
+        {
+            serialization::AutoSave autoSave;
+            auto const restored = std::unique_ptr<gadget::Node>(autoSave.restore(filename));
+            if (restored == nullptr)
+            {
+                THROW_TEST_EXCEPTION("The autosave could not be restored!");
+            }
+
+            if (valueOf(restored.get(), 1) != 7)
+            {
+                THROW_TEST_EXCEPTION(
+                    "The log of the previous snapshot has been applied! a = " << valueOf(restored.get(), 1));
+            }
+        }
+
+        removeFiles(filename);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    try
+    {
+        auto const filename = QDir::temp().absoluteFilePath("tinyember-test-autosave.autosave").toStdString();
+        removeFiles(filename);
+
+        testReplayAfterDeletion(filename);
+        testStaleLogIsIgnored(filename);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Unexpected exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
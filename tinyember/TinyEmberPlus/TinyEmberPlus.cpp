@@ -20,10 +20,13 @@
 #include "TreeWidgetItemData.h"
 #include "ViewFactory.h"
 #include <ember/Ember.hpp>
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <qdialog.h>
 #include <qfileinfo.h>
 #include <qfiledialog.h>
+#include <qmessagebox.h>
 
 using namespace ::glow;
 using namespace ::libember;
@@ -43,6 +46,7 @@ TinyEmberPlus::TinyEmberPlus(::glow::ConsumerProxy* proxy, QWidget *parent, Qt::
     : QMainWindow(parent, flags)
     , m_proxy(proxy)
     , m_settingsSerializer("Settings.xml")
+    , m_streamScheduler(proxy, this)
     , m_generateRandomValues(false)
     , m_sendKeepAlive(false)
     , m_lastKeepAliveTransmitTime(QDateTime::currentDateTimeUtc())
@@ -59,6 +63,9 @@ TinyEmberPlus::TinyEmberPlus(::glow::ConsumerProxy* proxy, QWidget *parent, Qt::
     setWindowIcon(QIcon(":/image/resources/document-globe.png"));
     setWindowTitle(title());
     connect(m_timer, SIGNAL(timeout()), this, SLOT(timer()));
+
+    m_metricsLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(m_metricsLabel);
     
     auto const notificationBehavior = m_settingsSerializer.getOption(NotificationBehavior);
     auto const notificationBehaviorIndex = m_dialog.boxNotificationBehavior->findText(notificationBehavior);
@@ -113,6 +120,9 @@ TinyEmberPlus::TinyEmberPlus(::glow::ConsumerProxy* proxy, QWidget *parent, Qt::
         m_dialog.streamIntervalBox->setValue(streamTimer);
     }
 
+    m_streamScheduler.setInterval(m_dialog.streamIntervalBox->value());
+    connect(qApp, SIGNAL(aboutToQuit()), this, SLOT(stopStreams()));
+
     auto const sendKeepAlive = m_settingsSerializer.getOption(SendKeepAliveRequest).toLower() == "true";
     if (sendKeepAlive)
     {
@@ -136,7 +146,7 @@ void TinyEmberPlus::rebuildTree(gadget::Node* root)
 
     if (root != nullptr)
     {
-        root->registerListener(m_proxy);
+        registerListeners(root);
 
         auto item = new QTreeWidgetItem(m_dialog.gadgetTreeView);
         item->setIcon(0, QIcon(":/image/resources/globe-medium.png"));
@@ -204,8 +214,32 @@ gadget::Node* TinyEmberPlus::root()
 
 void TinyEmberPlus::loadFile(QString const& filename)
 {
-    Archive archive;
-    auto root = archive.deserialize(filename.toStdString());
+    // The auto save contains the changes that have been made after the configuration
+    // has been saved the last time. Since the user chose to open the file, the changes
+    // are only restored on request.
+    auto const autoSave = autoSaveFilename(filename);
+    auto const lastChanged = AutoSave::lastModified(autoSave.toStdString());
+    auto const isRestoreRequested = lastChanged.isValid()
+        && lastChanged > QFileInfo(filename).lastModified()
+        && QMessageBox::question(
+            this,
+            "Restore Autosave",
+            QString("There are unsaved changes to %1 from %2. Do you want to restore them? Otherwise they are discarded.")
+                .arg(QFileInfo(filename).fileName())
+                .arg(lastChanged.toString()),
+            QMessageBox::Yes | QMessageBox::No,
+            QMessageBox::Yes) == QMessageBox::Yes;
+
+    auto root = isRestoreRequested
+        ? m_autoSave.restore(autoSave.toStdString())
+        : nullptr;
+    auto const isRestored = root != nullptr;
+
+    if (root == nullptr)
+    {
+        Archive archive;
+        root = archive.deserialize(filename.toStdString());
+    }
 
     if (root != nullptr)
     {
@@ -215,16 +249,37 @@ void TinyEmberPlus::loadFile(QString const& filename)
         m_dialog.configurationName->setText(info.fileName());
         m_settingsSerializer.setOption(ConfigurationName, info.fileName());
         m_settingsSerializer.save();
+        m_autoSaveFilename = autoSave;
+
+        if (isRestored)
+            statusBar()->showMessage("Restored the autosaved changes of " + info.fileName());
+
+        m_autoSave.reset(root, m_autoSaveFilename.toStdString());
     }
 }
 
+void TinyEmberPlus::registerListeners(gadget::Node* root)
+{
+    root->unregisterListener(m_proxy);
+    root->registerListener(&m_autoSave);
+    root->registerListener(m_proxy);
+}
+
+//static
+QString TinyEmberPlus::autoSaveFilename(QString const& configuration)
+{
+    return configuration.isEmpty()
+        ? QString()
+        : QFileInfo(configuration).absoluteFilePath() + ".autosave";
+}
+
 void TinyEmberPlus::loadFile()
 {
     auto const filename = QFileDialog::getOpenFileName(
         this,
         "Load EmBER File...",
         QString(),
-        "*.EmBER");
+        "EmBER Files (*.EmBER *.EmBERSnapshot)");
 
     if (filename.isEmpty() == false)
     {
@@ -236,7 +291,8 @@ void TinyEmberPlus::saveFile()
 {
     auto root = this->root();
     auto filename = m_dialog.configurationName->text();
-    if (filename.toLower().endsWith(".ember") == false)
+    auto const isSnapshot = filename.endsWith(QString::fromStdString(Archive::SnapshotExtension), Qt::CaseInsensitive);
+    if (filename.toLower().endsWith(".ember") == false && isSnapshot == false)
         filename += ".EmBER";
 
     Archive archive;
@@ -250,7 +306,7 @@ void TinyEmberPlus::saveFileAs()
         this,
         "Save EmBER Configuration...",
         QString(),
-        "*.EmBER");
+        "EmBER Files (*.EmBER);;EmBER Snapshots (*.EmBERSnapshot)");
 
     if (filename.isEmpty() == false && root != nullptr)
     {
@@ -261,6 +317,8 @@ void TinyEmberPlus::saveFileAs()
         m_dialog.configurationName->setText(info.fileName());
         m_settingsSerializer.setOption(ConfigurationName, info.fileName());
         m_settingsSerializer.save();
+        m_autoSaveFilename = autoSaveFilename(filename);
+        m_autoSave.reset(root, m_autoSaveFilename.toStdString());
     }
 }
 
@@ -289,7 +347,7 @@ void TinyEmberPlus::treeItemChanged(QTreeWidgetItem* item, QTreeWidgetItem*)
 
             if (node->parent() == nullptr)
             {
-                node->registerListener(m_proxy);
+                registerListeners(node);
             }
         }
         else if (type.value() == TreeWidgetItemDataType::Parameter)
@@ -307,6 +365,17 @@ void TinyEmberPlus::showContextMenu(QPoint cursor)
 {
     auto menu = GadgetViewContextMenu(m_proxy, m_dialog.gadgetTreeView, cursor);
     menu.exec();
+
+    // Nodes and parameters are only added or removed by the context menu. Since the
+    // change log doesn't contain structural changes, a new snapshot is written.
+    if (menu.isStructureChanged())
+    {
+        auto const root = this->root();
+        if (root != nullptr)
+            registerListeners(root);
+
+        m_autoSave.reset(root, m_autoSaveFilename.toStdString());
+    }
 }
 
 void TinyEmberPlus::notificationBehaviorChanged(int index)
@@ -355,39 +424,90 @@ void TinyEmberPlus::generateRandomValuesStateChanged(bool state)
 }
 
 void TinyEmberPlus::timer()
+{
+    auto const now = QDateTime::currentDateTimeUtc();
+    if (m_sendKeepAlive)
+    {
+        if (m_lastKeepAliveTransmitTime.msecsTo(now) > 4000)
+        {
+            m_lastKeepAliveTransmitTime = now;
+            m_proxy->writeRequestKeepAlive();
+        }
+    }
+
+    updateMetrics();
+}
+
+void TinyEmberPlus::updateMetrics()
+{
+    auto queued = net::TcpClient::QueueMetrics();
+    auto received = net::TcpClient::ReceiveMetrics();
+    std::memset(&queued, 0, sizeof(queued));
+    std::memset(&received, 0, sizeof(received));
+
+    auto const metrics = m_proxy->metrics();
+    for(auto const& client : metrics)
+    {
+        queued.queuedMessages += client.queuedMessages;
+        queued.queuedBytes += client.queuedBytes;
+        queued.peakQueuedBytes = std::max(queued.peakQueuedBytes, client.peakQueuedBytes);
+        queued.droppedStreamFrames += client.droppedStreamFrames;
+        queued.coalescedUpdates += client.coalescedUpdates;
+    }
+
+    for(auto const& client : m_proxy->receiveMetrics())
+    {
+        received.receivedBytes += client.receivedBytes;
+        received.reads += client.reads;
+    }
+
+    m_metricsLabel->setText(
+        QString("Consumers: %1 | Queued: %2 messages, %3 KiB (peak %4 KiB) | Dropped frames: %5 | Coalesced updates: %6 | Received: %7 KiB in %8 reads")
+            .arg(metrics.size())
+            .arg(queued.queuedMessages)
+            .arg(queued.queuedBytes / 1024)
+            .arg(queued.peakQueuedBytes / 1024)
+            .arg(queued.droppedStreamFrames)
+            .arg(queued.coalescedUpdates)
+            .arg(received.receivedBytes / 1024)
+            .arg(received.reads));
+}
+
+void TinyEmberPlus::sampleStreams()
 {
     auto& manager = gadget::StreamManager::instance();
+    auto root = static_cast<libember::glow::GlowStreamCollection*>(nullptr);
     if (manager.size() > 0)
     {
         if (m_generateRandomValues)
             manager.updateValues();
 
-        auto proxy = m_proxy;
-        auto root = libember::glow::GlowStreamCollection::create();
+        root = libember::glow::GlowStreamCollection::create();
         ::glow::util::StreamConverter::create(root, manager);
+    }
 
-        if (proxy != nullptr && root->size() > 0)
-            proxy->write(root);
+    // The scheduler expects an answer to each sample request, even if there is nothing to transmit.
+    m_streamScheduler.publish(root);
+}
 
-        delete root;
-    }
+void TinyEmberPlus::customEvent(QEvent* event)
+{
+    if (event->type() == ::glow::StreamScheduler::SampleEvent::eventType())
+        sampleStreams();
+    else
+        QMainWindow::customEvent(event);
+}
 
-    auto const now = QDateTime::currentDateTimeUtc();
-    if (m_sendKeepAlive)
-    {
-        if (m_lastKeepAliveTransmitTime.msecsTo(now) > 4000)
-        {
-            m_lastKeepAliveTransmitTime = now;
-            m_proxy->writeRequestKeepAlive();
-        }
-    }
+void TinyEmberPlus::stopStreams()
+{
+    m_streamScheduler.stop();
 }
 
 void TinyEmberPlus::updateStreamTimer()
 {
     auto const interval = m_dialog.streamIntervalBox->value();
 
-    m_timer->setInterval(interval);
+    m_streamScheduler.setInterval(interval);
     m_settingsSerializer.setOption(StreamTimerInterval, QVariant::fromValue(interval).toString());
     m_settingsSerializer.save();
 }
@@ -460,14 +580,15 @@ void TinyEmberPlus::synchronizedNotify(void* nodeptr, void* subscriberptr)
     auto node = reinterpret_cast<dom::Node*>(nodeptr);
     if (node != nullptr)
     {
-        auto const type = ber::Type::fromTag(node->typeTag());
+        auto const container = libember::glow::GlowContainer::fromNode(node);
         auto root = this->root();
-        if (type.value() == libember::glow::GlowType::RootElementCollection
+        if (container != nullptr
+        &&  container->type().value() == libember::glow::GlowType::RootElementCollection
         &&  root != nullptr)
         {
             auto transmit = false;
             auto response = libember::glow::GlowRootElementCollection::create();
-            auto collection = dynamic_cast<libember::glow::GlowRootElementCollection*>(node);
+            auto collection = static_cast<libember::glow::GlowRootElementCollection*>(container);
             auto proxy = m_proxy;
             ConsumerRequestProcessor::execute(collection, root, response, transmit, subscriber);
 
@@ -11,6 +11,8 @@
 #include <qdatetime.h>
 #include <qtimer.h>
 #include "glow/ProviderInterface.h"
+#include "glow/StreamScheduler.h"
+#include "serialization/AutoSave.h"
 #include "serialization/SettingsSerializer.h"
 #include "ui_TinyEmberPlus.h"
 
@@ -77,6 +79,13 @@ class TinyEmberPlus : public QMainWindow, public glow::ProviderInterface
          */
         void unregisterSubscriber(gadget::Subscriber* subscriber);
 
+    protected:
+        /**
+         * Handles the sample requests posted by the stream scheduler.
+         * @param event The event to handle.
+         */
+        virtual void customEvent(QEvent* event);
+
     private slots:
         /**
          * Loads a file that contains an ember tree which represents the data of the provider.
@@ -113,7 +122,8 @@ class TinyEmberPlus : public QMainWindow, public glow::ProviderInterface
         void showContextMenu(QPoint cursor);
 
         /**
-         * This timer is used to send keep alive requests to connected consumers.
+         * This timer is used to send keep alive requests to connected consumers and
+         * to update the connection metrics shown in the status bar.
          */
         void timer();
 
@@ -163,6 +173,11 @@ class TinyEmberPlus : public QMainWindow, public glow::ProviderInterface
          */
         void updateUseEnumMap(bool state);
 
+        /**
+         * Stops the stream scheduler before the consumer proxy is closed.
+         */
+        void stopStreams();
+
     private:
         /**
          * Gets the stored root node from the tree view.
@@ -195,11 +210,45 @@ class TinyEmberPlus : public QMainWindow, public glow::ProviderInterface
          */
         void loadFile(QString const& filename);
 
+        /**
+         * Registers the auto save and the consumer proxy as listeners of the root node.
+         * The auto save must be registered first, because the proxy clears the dirty
+         * journal after it has notified the consumers.
+         * @param root The root node of the current configuration.
+         */
+        void registerListeners(gadget::Node* root);
+
+        /**
+         * Returns the absolute path of the auto save snapshot that belongs to a
+         * configuration. The snapshot is stored next to the configuration file.
+         * @param configuration The name of the configuration file.
+         * @return The path of the auto save snapshot or an empty string, if the
+         *      configuration has no name.
+         */
+        static QString autoSaveFilename(QString const& configuration);
+
+        /**
+         * Collects the current values of all subscribed stream parameters and hands
+         * them over to the stream scheduler. When the 'Generate random values' option
+         * is active, new values are generated first.
+         */
+        void sampleStreams();
+
+        /**
+         * Shows the outbound queue and receive counters of all connected consumers,
+         * summed up, in the status bar.
+         */
+        void updateMetrics();
+
     private:
         Ui::TinyEmberPlusClass m_dialog;
         glow::ConsumerProxy *const m_proxy;
         serialization::SettingsSerializer m_settingsSerializer;
+        serialization::AutoSave m_autoSave;
+        QString m_autoSaveFilename;
+        glow::StreamScheduler m_streamScheduler;
         QTimer* m_timer;
+        QLabel* m_metricsLabel;
         QDateTime m_lastKeepAliveTransmitTime;
         bool m_generateRandomValues;
         bool m_sendKeepAlive;
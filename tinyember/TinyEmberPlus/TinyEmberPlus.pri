@@ -40,6 +40,7 @@ HEADERS += ./GadgetViewContextMenu.h \
     ./glow/Encoder.h \
     ./glow/ProviderInterface.h \
     ./glow/Settings.h \
+    ./glow/StreamScheduler.h \
     ./glow/util/NodeConverter.h \
     ./glow/util/ParameterConverter.h \
     ./glow/util/StreamConverter.h \
@@ -47,9 +48,16 @@ HEADERS += ./GadgetViewContextMenu.h \
     ./net/TcpServer.h \
     ./net/TcpClient.h \
     ./serialization/Archive.h \
+    ./serialization/AutoSave.h \
     ./serialization/SettingsSerializer.h \
+    ./serialization/detail/ChangeLogFormat.h \
+    ./serialization/detail/ChangeLogReader.h \
+    ./serialization/detail/ChangeLogWriter.h \
     ./serialization/detail/GadgetTreeReader.h \
     ./serialization/detail/GadgetTreeWriter.h \
+    ./serialization/detail/SnapshotFormat.h \
+    ./serialization/detail/SnapshotReader.h \
+    ./serialization/detail/SnapshotWriter.h \
     ./util/StringConverter.h \
     ./util/StreamFormatConverter.h \
     ./TinyEmberPlus.h \
@@ -79,15 +87,21 @@ SOURCES += ./GadgetViewContextMenu.cpp \
     ./glow/ConsumerProxy.cpp \
     ./glow/ConsumerRequestProcessor.cpp \
     ./glow/Encoder.cpp \
+    ./glow/StreamScheduler.cpp \
     ./glow/util/NodeConverter.cpp \
     ./glow/util/ParameterConverter.cpp \
     ./glow/util/StreamConverter.cpp \
     ./net/TcpClient.cpp \
     ./net/TcpServer.cpp \
     ./serialization/Archive.cpp \
+    ./serialization/AutoSave.cpp \
     ./serialization/SettingsSerializer.cpp \
+    ./serialization/detail/ChangeLogReader.cpp \
+    ./serialization/detail/ChangeLogWriter.cpp \
     ./serialization/detail/GadgetTreeReader.cpp \
     ./serialization/detail/GadgetTreeWriter.cpp \
+    ./serialization/detail/SnapshotReader.cpp \
+    ./serialization/detail/SnapshotWriter.cpp \
     ./util/StreamFormatConverter.cpp \
     ./CreateNodeDialog.cpp \
     ./CreateParameterDialog.cpp \
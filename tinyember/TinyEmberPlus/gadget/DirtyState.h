@@ -89,6 +89,12 @@ namespace gadget
              */
             DirtyState const join(DirtyState const& other) const;
 
+            /**
+             * Returns the bits of this instance.
+             * @return The bits of this instance.
+             */
+            value_type value() const;
+
         private:
             value_type m_state;
     };
@@ -146,6 +152,12 @@ namespace gadget
         return DirtyState<FlagType>(m_state | other.m_state);
     }
     
+    template<typename FlagType>
+    inline typename DirtyState<FlagType>::value_type DirtyState<FlagType>::value() const
+    {
+        return m_state;
+    }
+
     template<typename FlagType>
     inline bool operator ==(DirtyState<FlagType> const& x, DirtyState<FlagType> const& y)
     {
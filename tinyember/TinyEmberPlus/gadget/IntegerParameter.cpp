@@ -4,7 +4,6 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
-#include <formula/TermCompiler.hpp>
 #include <sstream>
 #include <cstdio>
 #include "IntegerParameter.h"
@@ -36,13 +35,10 @@ namespace gadget
 
     std::string IntegerParameter::toDisplayValue() const
     {
-        auto const& formula = this->formula();
+        auto const& term = providerToConsumerTerm();
         auto value = this->value();
-        if (formula.valid())
-        {
-            auto term = libformula::TermCompiler::compile(formula.providerToConsumer());
-            value = term.compute(value);
-        }
+        if (term != nullptr)
+            value = term->compute(value);
 
         if (m_format.size() > 0)
         {
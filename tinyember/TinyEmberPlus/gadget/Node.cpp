@@ -14,10 +14,13 @@ namespace gadget
         : m_identifier(identifier)
         , m_number(number)
         , m_parent(parent)
+        , m_largestChildNumber(0)
         , m_state(NodeField::All)
         , m_isOnline(true)
         , m_isMounted(true)
+        , m_isJournaled(false)
     {
+        appendToJournal(this);
     }
 
     Node::~Node()
@@ -28,13 +31,17 @@ namespace gadget
         if (parent != nullptr)
             parent->remove(this);
 
+        // The children are detached first so they do not remove themselves from
+        // this node one by one.
         for(auto item : parameters)
         {
+            item->m_parent = nullptr;
             delete item;
         }
 
         for(auto item : children)
         {
+            item->m_parent = nullptr;
             delete item;
         }
     }
@@ -73,6 +80,49 @@ namespace gadget
     {
         return m_parameters;
     }
+
+    Node* Node::findNode(int number) const
+    {
+        auto const result = m_nodeIndex.find(number);
+        return result != std::end(m_nodeIndex) ? result->second : nullptr;
+    }
+
+    Parameter* Node::findParameter(int number) const
+    {
+        auto const result = m_parameterIndex.find(number);
+        return result != std::end(m_parameterIndex) ? result->second : nullptr;
+    }
+
+    void Node::insert(Node* node)
+    {
+        m_children.insert(std::end(m_children), node);
+        m_nodeIndex[node->number()] = node;
+        m_largestChildNumber = std::max(m_largestChildNumber, node->number());
+    }
+
+    void Node::insert(Parameter* parameter)
+    {
+        m_parameters.insert(std::end(m_parameters), parameter);
+        m_parameterIndex[parameter->number()] = parameter;
+        m_largestChildNumber = std::max(m_largestChildNumber, parameter->number());
+    }
+
+    int Node::largestChildNumber() const
+    {
+        return m_largestChildNumber;
+    }
+
+    void Node::updateLargestChildNumber()
+    {
+        auto result = 0;
+        for(auto node : m_children)
+            result = std::max(result, node->number());
+
+        for(auto parameter : m_parameters)
+            result = std::max(result, parameter->number());
+
+        m_largestChildNumber = result;
+    }
         
     bool Node::isDirty() const
     {
@@ -204,12 +254,18 @@ namespace gadget
     }
 
     void Node::markDirty()
+    {
+        appendToJournal(this);
+        propagateDirtyState();
+    }
+
+    void Node::propagateDirtyState()
     {
         m_state.set(NodeField::DirtyChildEntity);
 
         if (m_parent != nullptr)
         {
-            m_parent->markDirty();
+            m_parent->propagateDirtyState();
         }
         else
         {
@@ -217,6 +273,111 @@ namespace gadget
         }
     }
 
+    Node::NodeJournal const& Node::dirtyNodes() const
+    {
+        return m_dirtyNodes;
+    }
+
+    Node::ParameterJournal const& Node::dirtyParameters() const
+    {
+        return m_dirtyParameters;
+    }
+
+    void Node::clearJournal() const
+    {
+        for(auto node : m_dirtyNodes)
+        {
+            node->m_isJournaled = false;
+            node->m_state.clear();
+            clearDirtyPath(node->m_parent);
+        }
+
+        for(auto parameter : m_dirtyParameters)
+        {
+            parameter->m_isJournaled = false;
+            parameter->clearDirtyState();
+            clearDirtyPath(parameter->m_parent);
+        }
+
+        m_dirtyNodes.clear();
+        m_dirtyParameters.clear();
+    }
+
+    void Node::appendToJournal(Node* node)
+    {
+        if (node->m_isJournaled == false)
+        {
+            node->m_isJournaled = true;
+            root()->m_dirtyNodes.push_back(node);
+        }
+    }
+
+    void Node::appendToJournal(Parameter* parameter)
+    {
+        if (parameter->m_isJournaled == false)
+        {
+            parameter->m_isJournaled = true;
+            root()->m_dirtyParameters.push_back(parameter);
+        }
+    }
+
+    void Node::removeFromJournal(Node const* node)
+    {
+        auto const owner = root();
+        auto& nodes = owner->m_dirtyNodes;
+        auto& parameters = owner->m_dirtyParameters;
+
+        auto const lastNode = std::remove_if(std::begin(nodes), std::end(nodes), [node](Node* journaled) -> bool
+        {
+            auto const result = node->contains(journaled);
+            if (result)
+                journaled->m_isJournaled = false;
+
+            return result;
+        });
+
+        auto const lastParameter = std::remove_if(std::begin(parameters), std::end(parameters), [node](Parameter* journaled) -> bool
+        {
+            auto const result = node->contains(journaled->m_parent);
+            if (result)
+                journaled->m_isJournaled = false;
+
+            return result;
+        });
+
+        nodes.erase(lastNode, std::end(nodes));
+        parameters.erase(lastParameter, std::end(parameters));
+    }
+
+    Node* Node::root()
+    {
+        auto node = this;
+        while(node->m_parent != nullptr)
+            node = node->m_parent;
+
+        return node;
+    }
+
+    bool Node::contains(Node const* node) const
+    {
+        for(/* Nothing */; node != nullptr; node = node->m_parent)
+        {
+            if (node == this)
+                return true;
+        }
+
+        return false;
+    }
+
+    //static
+    void Node::clearDirtyPath(Node const* node)
+    {
+        for(/* Nothing */; node != nullptr && node->m_state.isDirty(); node = node->m_parent)
+        {
+            node->m_state.clear();
+        }
+    }
+
     bool Node::remove(Node *const node)
     {
         auto const first = std::begin(m_children);
@@ -224,9 +385,19 @@ namespace gadget
         auto const where = std::find(first, last, node);
         auto const result = where != last;
         if (node)
+        {
+            removeFromJournal(node);
             node->m_parent = nullptr;
+        }
+
+        if (result)
+            m_nodeIndex.erase(node->number());
 
         m_children.remove(where);
+
+        if (result && node->number() == m_largestChildNumber)
+            updateLargestChildNumber();
+
         return result;
     }
 
@@ -237,9 +408,25 @@ namespace gadget
         auto const where = std::find(first, last, parameter);
         auto const result = where != last;
         if (parameter)
+        {
+            if (parameter->m_isJournaled)
+            {
+                auto& parameters = root()->m_dirtyParameters;
+                parameters.erase(std::remove(std::begin(parameters), std::end(parameters), parameter), std::end(parameters));
+                parameter->m_isJournaled = false;
+            }
+
             parameter->m_parent = nullptr;
+        }
+
+        if (result)
+            m_parameterIndex.erase(parameter->number());
 
         m_parameters.remove(where);
+
+        if (result && parameter->number() == m_largestChildNumber)
+            updateLargestChildNumber();
+
         return result;
     }
 }
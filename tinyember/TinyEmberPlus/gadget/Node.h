@@ -8,6 +8,8 @@
 #define __TINYEMBER_GADGET_NODE_H
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 #include "../Types.h"
 #include "Collection.h"
 #include "DirtyStateListener.h"
@@ -27,10 +29,13 @@ namespace gadget
     class Node
     {
         friend class NodeFactory;
+        friend class Parameter;
         friend class ParameterFactory;
         public:
             typedef Collection<Node*> NodeCollection;
             typedef Collection<gadget::Parameter*> ParameterCollection;
+            typedef std::vector<Node*> NodeJournal;
+            typedef std::vector<gadget::Parameter*> ParameterJournal;
             typedef DirtyStateListener<NodeFieldState::flag_type, Node const*> DirtyStateListenerT;
 
             /** Destructor */
@@ -86,6 +91,28 @@ namespace gadget
              */
             ParameterCollection const& parameters() const;
 
+            /**
+             * Looks up the child node with the specified number.
+             * @param number The number of the child node to look for.
+             * @return The child node with the specified number or nullptr, if this
+             *      node has no such child.
+             */
+            Node* findNode(int number) const;
+
+            /**
+             * Looks up the parameter with the specified number.
+             * @param number The number of the parameter to look for.
+             * @return The parameter with the specified number or nullptr, if this
+             *      node has no such parameter.
+             */
+            Parameter* findParameter(int number) const;
+
+            /**
+             * Returns the largest number used by a child node or parameter of this node.
+             * @return The largest number of all children, or 0 if this node has no children.
+             */
+            int largestChildNumber() const;
+
             /**
              * Returns true if at least one node property is marked dirty.
              * @return true if at least one node property is marked dirty.
@@ -156,10 +183,36 @@ namespace gadget
             void unregisterListener(DirtyStateListenerT* listener);
 
             /**
-             * Marks the node dirty by setting the DirtyChildEntity flag.
+             * Marks the node dirty by setting the DirtyChildEntity flag and appends it
+             * to the dirty journal of the root node, unless it is already contained.
              */
             void markDirty();
 
+            /**
+             * Returns the nodes that have been marked dirty since the journal has been
+             * cleared the last time. Only the root node keeps a journal, the journal
+             * of all other nodes is empty. Newly created nodes are contained as well.
+             * @return The nodes that have been marked dirty.
+             */
+            NodeJournal const& dirtyNodes() const;
+
+            /**
+             * Returns the parameters that have been marked dirty since the journal has been
+             * cleared the last time. Only the root node keeps a journal, the journal
+             * of all other nodes is empty. Newly created parameters are contained as well.
+             * @return The parameters that have been marked dirty.
+             */
+            ParameterJournal const& dirtyParameters() const;
+
+            /**
+             * Resets the dirty state of all journaled entities and of their parents and
+             * clears the journal. Since each dirty entity is either contained in the
+             * journal or is a parent of a journaled entity, this has the same effect as
+             * clearDirtyState(true) on the root node, but only visits the entities that
+             * have changed.
+             */
+            void clearJournal() const;
+
             /**
              * Removes the passed node from the collection of child nodes. The parent of the
              * removed node will be set to null.
@@ -193,12 +246,83 @@ namespace gadget
              */
             Node(Node* parent, String const& identifier, int number);
 
+            /**
+             * Appends a new child node to this node.
+             * @param node The node to append. Its number must not be used by any
+             *      other child of this node.
+             */
+            void insert(Node* node);
+
+            /**
+             * Appends a new parameter to this node.
+             * @param parameter The parameter to append. Its number must not be used
+             *      by any other child of this node.
+             */
+            void insert(Parameter* parameter);
+
+            /**
+             * Recomputes the largest number of all children. This method is called when
+             * the child with the largest number has been removed.
+             */
+            void updateLargestChildNumber();
+
             /**
              * Informs all registered state listeners about the dirty state of this node.
              */
             void notify() const;
 
+            /**
+             * Sets the DirtyChildEntity flag of this node and of all its parents and
+             * informs the listeners of the root node.
+             */
+            void propagateDirtyState();
+
+            /**
+             * Appends a node to the journal of the root node this node belongs to.
+             * @param node The node to append. Nothing happens if the node is already journaled.
+             */
+            void appendToJournal(Node* node);
+
+            /**
+             * Appends a parameter to the journal of the root node this node belongs to.
+             * @param parameter The parameter to append. Nothing happens if the parameter is
+             *      already journaled.
+             */
+            void appendToJournal(Parameter* parameter);
+
+            /**
+             * Removes all journaled entities that belong to the passed node, including the
+             * node itself, from the journal of the root node this node belongs to. This
+             * method must be called before the node is detached from its parent.
+             * @param node The node being removed.
+             */
+            void removeFromJournal(Node const* node);
+
+            /**
+             * Returns the root of the tree this node belongs to.
+             * @return The root node.
+             */
+            Node* root();
+
+            /**
+             * Returns true if the passed node is the node itself or one of its descendants.
+             * @param node The node to test.
+             * @return true if the passed node belongs to this node's subtree.
+             */
+            bool contains(Node const* node) const;
+
+            /**
+             * Clears the dirty state of the passed node and of all its parents. Stops
+             * at the first node which is not dirty, since its parents have already
+             * been cleared.
+             * @param node The first node to clear.
+             */
+            static void clearDirtyPath(Node const* node);
+
         private:
+            typedef std::unordered_map<int, Node*> NodeIndex;
+            typedef std::unordered_map<int, gadget::Parameter*> ParameterIndex;
+
             int const m_number;
             String m_description;
             String const m_identifier;
@@ -206,10 +330,16 @@ namespace gadget
             Node* m_parent;
             NodeCollection m_children;
             ParameterCollection m_parameters;
+            NodeIndex m_nodeIndex;
+            ParameterIndex m_parameterIndex;
+            int m_largestChildNumber;
             std::list<DirtyStateListenerT*> m_listeners;
             bool m_isOnline;
             bool m_isMounted;
+            mutable bool m_isJournaled;
             mutable NodeFieldState m_state;
+            mutable NodeJournal m_dirtyNodes;
+            mutable ParameterJournal m_dirtyParameters;
     };
 
     /**************************************************************************
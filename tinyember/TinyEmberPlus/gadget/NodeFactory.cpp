@@ -23,11 +23,21 @@ namespace gadget
         Node* node = nullptr;
         if (parent != nullptr)
         {
-            auto& collection = parent->m_children;
             auto const number = util::NumberFactory::create(parent);
-            auto const where = std::end(collection);
+            node = createNode(parent, number, identifier);
+        }
+
+        return node;
+    }
+
+    //static 
+    Node* NodeFactory::createNode(Node* parent, int number, String const& identifier)
+    {
+        Node* node = nullptr;
+        if (parent != nullptr)
+        {
             node = new Node(parent, identifier, number);
-            collection.insert(where, node);
+            parent->insert(node);
         }
 
         return node;
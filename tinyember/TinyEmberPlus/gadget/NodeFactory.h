@@ -36,6 +36,18 @@ namespace gadget
              *      node it must not necessarily be deleted manually.
              */
             static Node* createNode(Node* parent, String const& identifier);
+
+            /**
+             * Creates a new node with a predefined number and inserts it to the passed
+             * parent node. This is used to restore a tree with its original numbers.
+             * @param parent The parent node to attach the newly created node to.
+             * @param number The number of the new node. It must not be used by any other
+             *      child of the parent node.
+             * @param identifier The identifier of the new node.
+             * @return The newly created node. As long as this node is owned by a parent
+             *      node it must not necessarily be deleted manually.
+             */
+            static Node* createNode(Node* parent, int number, String const& identifier);
     };
 }
 
@@ -19,7 +19,10 @@ namespace gadget
         , m_streamIdentifier(-1)
         , m_access(gadget::Access::ReadWrite)
         , m_state(ParameterField::All)
+        , m_isJournaled(false)
     {
+        if (parent != nullptr)
+            parent->appendToJournal(this);
     }
 
     Parameter::~Parameter()
@@ -66,6 +69,11 @@ namespace gadget
         return m_formula;
     }
 
+    libformula::TermCache::TermHandle const& Parameter::providerToConsumerTerm() const
+    {
+        return m_providerToConsumerTerm;
+    }
+
     Access Parameter::access() const
     {
         return static_cast<Access::_Domain>(m_access);
@@ -127,6 +135,9 @@ namespace gadget
         if (m_formula != formula)
         {
             m_formula = formula;
+            m_providerToConsumerTerm = formula.valid()
+                ? libformula::TermCache::instance().get(formula.providerToConsumer())
+                : libformula::TermCache::TermHandle();
             markDirty(ParameterField::ValueFormula, true);
         }
     }
@@ -142,6 +153,8 @@ namespace gadget
                 subscribed();
             else
                 unsubscribed();
+
+            StreamManager::instance().updateParameter(this);
         }
     }
 
@@ -154,6 +167,8 @@ namespace gadget
             subscribed();
         else
             unsubscribed();
+
+        StreamManager::instance().updateParameter(this);
     }
 
     void Parameter::setStreamDescriptor(StreamFormat const& format, unsigned offset)
@@ -195,7 +210,10 @@ namespace gadget
             this->notify();
 
         if (m_parent != nullptr)
-            m_parent->markDirty();
+        {
+            m_parent->appendToJournal(this);
+            m_parent->propagateDirtyState();
+        }
     }
 
     void Parameter::notify() const
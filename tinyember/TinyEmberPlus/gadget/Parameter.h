@@ -9,6 +9,7 @@
 
 #include <list>
 #include <memory>
+#include <formula/TermCache.hpp>
 #include "../Types.h"
 #include "Access.h"
 #include "DirtyStateListener.h"
@@ -119,6 +120,14 @@ namespace gadget
              */
             Formula const& formula() const;
 
+            /**
+             * Returns the compiled provider-to-consumer term of the parameter's formula.
+             * The term is looked up in the process wide term cache when the formula
+             * is set, so parameters sharing a formula share the compiled term.
+             * @return The compiled term, or nullptr if the formula is not valid.
+             */
+            libformula::TermCache::TermHandle const& providerToConsumerTerm() const;
+
             /**
              * Returns the current dirty state of the parameter.
              * @return The current dirty state of the parameter.
@@ -223,7 +232,8 @@ namespace gadget
             Parameter(ParameterType const& type, Node* parent, String const& identifier, int number);
 
             /**
-             * Marks one or more properties as dirty.
+             * Marks one or more properties as dirty and appends the parameter to the
+             * dirty journal of the root node, unless it is already contained.
              * @param field The fields to mark dirty.
              * @param notify If set to true, the registered listeners will be informed
              *      about the state change.
@@ -264,7 +274,9 @@ namespace gadget
             String m_schema;
             Node* m_parent;
             Formula m_formula;
+            libformula::TermCache::TermHandle m_providerToConsumerTerm;
             ParameterFieldState m_state;
+            bool m_isJournaled;
             Access::value_type m_access;
             std::list<DirtyStateListenerT*> m_listeners;
             std::shared_ptr<StreamDescriptor> m_streamDescriptor;
@@ -17,50 +17,65 @@ namespace gadget
 {
     BooleanParameter* ParameterFactory::create(Node* parent, String const& identifier, bool value)
     {
-        auto const number = util::NumberFactory::create(parent);
-        auto const where = std::end(parent->m_parameters);
+        return create(parent, util::NumberFactory::create(parent), identifier, value);
+    }
+
+    IntegerParameter* ParameterFactory::create(Node* parent, String const& identifier, int minimum, int maximum, int value)
+    {
+        return create(parent, util::NumberFactory::create(parent), identifier, minimum, maximum, value);
+    }
+
+    RealParameter* ParameterFactory::create(Node* parent, String const& identifier, double minimum, double maximum, double value)
+    {
+        return create(parent, util::NumberFactory::create(parent), identifier, minimum, maximum, value);
+    }
+
+    StringParameter* ParameterFactory::create(Node* parent, String const& identifier, String const& value, std::size_t maxLength)
+    {
+        return create(parent, util::NumberFactory::create(parent), identifier, value, maxLength);
+    }
+
+    EnumParameter* ParameterFactory::create(Node* parent, String const& identifier)
+    {
+        return create(parent, util::NumberFactory::create(parent), identifier);
+    }
+
+    BooleanParameter* ParameterFactory::create(Node* parent, int number, String const& identifier, bool value)
+    {
         auto parameter = new BooleanParameter(parent, identifier, number, value);
-        parent->m_parameters.insert(where, parameter);
+        parent->insert(parameter);
 
         return parameter;
     }
 
-    IntegerParameter* ParameterFactory::create(Node* parent, String const& identifier, int minimum, int maximum, int value)
+    IntegerParameter* ParameterFactory::create(Node* parent, int number, String const& identifier, int minimum, int maximum, int value)
     {
-        auto const number = util::NumberFactory::create(parent);
-        auto const where = std::end(parent->m_parameters);
         auto parameter = new IntegerParameter(parent, identifier, number, minimum, maximum, value);
-        parent->m_parameters.insert(where, parameter);
+        parent->insert(parameter);
 
         return parameter;
     }
 
-    RealParameter* ParameterFactory::create(Node* parent, String const& identifier, double minimum, double maximum, double value)
+    RealParameter* ParameterFactory::create(Node* parent, int number, String const& identifier, double minimum, double maximum, double value)
     {
-        auto const number = util::NumberFactory::create(parent);
-        auto const where = std::end(parent->m_parameters);
         auto parameter = new RealParameter(parent, identifier, number, minimum, maximum, value);
-        parent->m_parameters.insert(where, parameter);
+        parent->insert(parameter);
 
         return parameter;
     }
 
-    StringParameter* ParameterFactory::create(Node* parent, String const& identifier, String const& value, std::size_t maxLength)
+    StringParameter* ParameterFactory::create(Node* parent, int number, String const& identifier, String const& value, std::size_t maxLength)
     {
-        auto const number = util::NumberFactory::create(parent);
-        auto const where = std::end(parent->m_parameters);
         auto parameter = new StringParameter(parent, identifier, number, value, maxLength);
-        parent->m_parameters.insert(where, parameter);
+        parent->insert(parameter);
 
         return parameter;
     }
 
-    EnumParameter* ParameterFactory::create(Node* parent, String const& identifier)
+    EnumParameter* ParameterFactory::create(Node* parent, int number, String const& identifier)
     {
-        auto const number = util::NumberFactory::create(parent);
-        auto const where = std::end(parent->m_parameters);
         auto parameter = new EnumParameter(parent, identifier, number);
-        parent->m_parameters.insert(where, parameter);
+        parent->insert(parameter);
 
         return parameter;
     }
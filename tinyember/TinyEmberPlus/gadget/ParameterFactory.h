@@ -72,6 +72,69 @@ namespace gadget
              * @return The new parameter instance.
              */
             static BooleanParameter* create(Node* parent, String const& identifier, bool value);
+
+            /**
+             * Creates a new integer parameter with a predefined number. This is used to
+             * restore a tree with its original numbers.
+             * @param parent The parameter's parent.
+             * @param number The parameter number, which must not be used by any other
+             *      child of the parent node.
+             * @param identifier The string identifier.
+             * @param minimum The smallest value accepted.
+             * @param maximum The largest value accepted.
+             * @param value The initial parameter value.
+             * @return The new parameter instance.
+             */
+            static IntegerParameter* create(Node* parent, int number, String const& identifier, int minimum, int maximum, int value);
+
+            /**
+             * Creates a new real parameter with a predefined number. This is used to
+             * restore a tree with its original numbers.
+             * @param parent The parameter's parent.
+             * @param number The parameter number, which must not be used by any other
+             *      child of the parent node.
+             * @param identifier The string identifier.
+             * @param minimum The smallest value accepted.
+             * @param maximum The largest value accepted.
+             * @param value The initial parameter value.
+             * @return The new parameter instance.
+             */
+            static RealParameter* create(Node* parent, int number, String const& identifier, double minimum, double maximum, double value);
+
+            /**
+             * Creates new string parameter with a predefined number. This is used to
+             * restore a tree with its original numbers.
+             * @param parent The parameter's parent.
+             * @param number The parameter number, which must not be used by any other
+             *      child of the parent node.
+             * @param identifier The string identifier.
+             * @param value The initial string value.
+             * @param maxLength The allowed length for the string value. If set to 0, the length is not limited.
+             * @return The new parameter instance.
+             */
+            static StringParameter* create(Node* parent, int number, String const& identifier, String const& value, std::size_t maxLength = 0);
+
+            /**
+             * Creates a new enumeration parameter with a predefined number. This is used
+             * to restore a tree with its original numbers.
+             * @param parent The parameter's parent.
+             * @param number The parameter number, which must not be used by any other
+             *      child of the parent node.
+             * @param identifier The string identifier.
+             * @return The new parameter instance.
+             */
+            static EnumParameter* create(Node* parent, int number, String const& identifier);
+
+            /**
+             * Creates a new boolean parameter with a predefined number. This is used to
+             * restore a tree with its original numbers.
+             * @param parent The parameter's parent.
+             * @param number The parameter number, which must not be used by any other
+             *      child of the parent node.
+             * @param identifier The string identifier.
+             * @return The new parameter instance.
+             */
+            static BooleanParameter* create(Node* parent, int number, String const& identifier, bool value);
     };
 }
 
@@ -69,6 +69,24 @@ namespace gadget
                 return size;
             }
 
+            /**
+             * Returns true if the stream value is encoded with the least significant byte first.
+             * @return true if the current format uses little endian byte order.
+             */
+            bool isLittleEndian() const
+            {
+                return (m_value & 1) != 0;
+            }
+
+            /**
+             * Returns true if the stream value is encoded as IEEE floating point number.
+             * @return true if the current format is one of the IeeeFloat formats.
+             */
+            bool isReal() const
+            {
+                return (m_value & 0x18) == 0x10;
+            }
+
         private:
             value_type m_value;
     };
@@ -17,6 +17,24 @@
 
 namespace gadget
 {
+    namespace
+    {
+        /**
+         * Returns the offset one past the last byte of a parameter's value in the octet
+         * stream of its group.
+         * @param parameter The parameter.
+         * @return The end of the value, or 0 if the parameter has no stream descriptor.
+         */
+        std::size_t streamEnd(Parameter const* parameter)
+        {
+            if (parameter->hasStreamDescriptor() == false)
+                return 0;
+
+            auto const descriptor = parameter->streamDescriptor();
+            return descriptor->offset() + descriptor->format().size();
+        }
+    }
+
     void StreamManager::RandomValueGenerator::visit(BooleanParameter* parameter)
     {
         auto const result = std::rand() % 100;
@@ -72,6 +90,53 @@ namespace gadget
     }
 
 
+    StreamManager::StreamGroup::StreamGroup(int identifier)
+        : m_identifier(identifier)
+        , m_size(0)
+    {}
+
+    int StreamManager::StreamGroup::identifier() const
+    {
+        return m_identifier;
+    }
+
+    StreamManager::ParameterCollection const& StreamManager::StreamGroup::parameters() const
+    {
+        return m_parameters;
+    }
+
+    std::size_t StreamManager::StreamGroup::size() const
+    {
+        return m_size;
+    }
+
+    StreamManager::StreamGroup::Buffer& StreamManager::StreamGroup::buffer() const
+    {
+        return m_buffer;
+    }
+
+    void StreamManager::StreamGroup::updateLayout()
+    {
+        auto size = std::size_t(0);
+        for(auto parameter : m_parameters)
+        {
+            size = std::max(size, streamEnd(parameter));
+        }
+
+        m_size = size;
+        m_buffer.assign(size, 0x00);
+    }
+
+    void StreamManager::StreamGroup::extendLayout(std::size_t end)
+    {
+        if (end > m_size)
+        {
+            m_size = end;
+            m_buffer.resize(end, 0x00);
+        }
+    }
+
+
     StreamManager& StreamManager::instance()
     {
         static StreamManager instance;
@@ -99,34 +164,108 @@ namespace gadget
 
     void StreamManager::registerParameter(Parameter* parameter)
     {
-        auto const first = std::begin(m_parameters);
-        auto const last = std::end(m_parameters);
-        auto const result = std::find_if(first, last, [&parameter](decltype(*first) entry) -> bool
+        if (m_registrations.find(parameter) == std::end(m_registrations))
         {
-            return entry == parameter;
-        });
+            auto registration = Registration();
+            registration.index = m_parameters.size();
 
-        if (result == last)
-        {
             m_parameters.push_back(parameter);
+            addToGroup(parameter, registration);
+            m_registrations.insert(std::make_pair(parameter, registration));
+        }
+        else
+        {
+            updateParameter(parameter);
         }
     }
 
     void StreamManager::unregisterParameter(Parameter* parameter)
     {
-        auto const first = std::begin(m_parameters);
-        auto const last = std::end(m_parameters);
-        auto const where = std::find_if(first, last, [&parameter](decltype(*first) entry) -> bool
+        auto const where = m_registrations.find(parameter);
+        if (where != std::end(m_registrations))
+        {
+            auto const registration = where->second;
+            m_registrations.erase(where);
+            removeFromGroup(parameter, registration);
+
+            // Move the last parameter into the gap to keep the removal O(1).
+            auto const last = m_parameters.back();
+            m_parameters[registration.index] = last;
+            m_parameters.pop_back();
+
+            if (last != parameter)
+                m_registrations[last].index = registration.index;
+        }
+    }
+
+    void StreamManager::updateParameter(Parameter* parameter)
+    {
+        auto const where = m_registrations.find(parameter);
+        if (where != std::end(m_registrations))
         {
-            return entry == parameter;
-        });
+            auto& registration = where->second;
+            auto const identifier = parameter->streamIdentifier();
+            if (registration.identifier != identifier)
+            {
+                removeFromGroup(parameter, registration);
+                addToGroup(parameter, registration);
+            }
+            else
+            {
+                auto& group = m_groups.find(identifier)->second;
+                auto const isLast = registration.end != 0 && registration.end >= group.size();
+                registration.end = streamEnd(parameter);
 
-        if (where != last)
+                if (isLast && registration.end < group.size())
+                    group.updateLayout();
+                else
+                    group.extendLayout(registration.end);
+            }
+        }
+    }
+
+    void StreamManager::removeFromGroup(Parameter* parameter, Registration const& registration)
+    {
+        auto const group = m_groups.find(registration.identifier);
+        if (group != std::end(m_groups))
         {
-            m_parameters.erase(where);
+            // Move the last parameter into the gap to keep the removal O(1).
+            auto& parameters = group->second.m_parameters;
+            auto const last = parameters.back();
+            parameters[registration.position] = last;
+            parameters.pop_back();
+
+            if (last != parameter)
+                m_registrations[last].position = registration.position;
+
+            if (parameters.empty())
+                m_groups.erase(group);
+            else if (registration.end != 0 && registration.end >= group->second.size())
+                group->second.updateLayout();
         }
     }
 
+    void StreamManager::addToGroup(Parameter* parameter, Registration& registration)
+    {
+        auto const identifier = parameter->streamIdentifier();
+        auto group = m_groups.find(identifier);
+        if (group == std::end(m_groups))
+            group = m_groups.insert(std::make_pair(identifier, StreamGroup(identifier))).first;
+
+        auto& parameters = group->second.m_parameters;
+        registration.identifier = identifier;
+        registration.position = parameters.size();
+        registration.end = streamEnd(parameter);
+
+        parameters.push_back(parameter);
+        group->second.extendLayout(registration.end);
+    }
+
+    StreamManager::GroupCollection const& StreamManager::groups() const
+    {
+        return m_groups;
+    }
+
     StreamManager::const_iterator StreamManager::begin() const
     {
         return m_parameters.begin();
@@ -7,6 +7,8 @@
 #ifndef __TINYEMBER_STREAMMANAGER_H
 #define __TINYEMBER_STREAMMANAGER_H
 
+#include <map>
+#include <unordered_map>
 #include <vector>
 #include "ParameterTypeVisitor.h"
 
@@ -18,6 +20,9 @@ namespace gadget
     /**
      * The StreamManager is a singleton which contains all parameters that have a valid streamIdentifier
      * set. The parameter register themseves as soon as there is at least one subscriber for a parameter.
+     * Registered parameters are grouped by their stream identifier. The groups and their byte layout
+     * are only updated when a parameter is registered, unregistered or changes its stream identifier
+     * or descriptor.
      */
     class StreamManager
     {
@@ -27,6 +32,71 @@ namespace gadget
             typedef ParameterCollection::const_iterator const_iterator;
             typedef ParameterCollection::size_type size_type;
 
+            /**
+             * Contains all registered parameters that share the same stream identifier.
+             */
+            class StreamGroup
+            {
+                friend class StreamManager;
+                public:
+                    typedef std::vector<unsigned char> Buffer;
+
+                    /**
+                     * Initializes a new, empty StreamGroup.
+                     * @param identifier The stream identifier of the group.
+                     */
+                    explicit StreamGroup(int identifier);
+
+                    /**
+                     * Returns the stream identifier shared by all parameters of this group.
+                     * @return The stream identifier of this group.
+                     */
+                    int identifier() const;
+
+                    /**
+                     * Returns the parameters of this group.
+                     * @return The parameters of this group.
+                     */
+                    ParameterCollection const& parameters() const;
+
+                    /**
+                     * Returns the number of bytes required to encode all parameters which have
+                     * a stream descriptor into a single octet stream. The size is determined by
+                     * the descriptor whose value ends last.
+                     * @return The size of the octet stream, or 0 if no parameter has a descriptor.
+                     */
+                    std::size_t size() const;
+
+                    /**
+                     * Returns the buffer used to encode the octet stream of this group. The buffer
+                     * is kept between encode passes and is only reallocated when the layout of the
+                     * group changes.
+                     * @return A buffer of size() bytes.
+                     */
+                    Buffer& buffer() const;
+
+                private:
+                    /**
+                     * Recomputes the size of the octet stream and resizes the buffer.
+                     */
+                    void updateLayout();
+
+                    /**
+                     * Grows the octet stream, if necessary, so that it contains a value
+                     * ending at the passed offset.
+                     * @param end The offset one past the last byte of the value.
+                     */
+                    void extendLayout(std::size_t end);
+
+                private:
+                    int m_identifier;
+                    ParameterCollection m_parameters;
+                    std::size_t m_size;
+                    mutable Buffer m_buffer;
+            };
+
+            typedef std::map<int, StreamGroup> GroupCollection;
+
             /**
              * Returns the singleton instance of the StreamManager.
              * @return The singleton instance of the StreamManager.
@@ -51,6 +121,12 @@ namespace gadget
              */
             size_type size() const;
 
+            /**
+             * Returns the registered parameters grouped by their stream identifier.
+             * @return The stream groups, ordered by stream identifier.
+             */
+            GroupCollection const& groups() const;
+
             /**
              * Generates a random value for all registered parameters.
              */
@@ -67,6 +143,19 @@ namespace gadget
             bool isParameterTransmittedViaStream(Parameter const* parameter) const;
 
         private:
+            /**
+             * Stores the position of a registered parameter in the list of all parameters
+             * and within its group, the identifier of the group and the offset at which
+             * the value of the parameter ends in the octet stream of the group.
+             */
+            struct Registration
+            {
+                size_type index;
+                size_type position;
+                int identifier;
+                std::size_t end;
+            };
+
             /**
              * Registers a parameter. This method is invoked by a parameter when
              * a consumer subscribes to it.
@@ -82,8 +171,38 @@ namespace gadget
              */
             void unregisterParameter(Parameter* parameter);
 
+            /**
+             * Moves a registered parameter to the group of its current stream identifier and
+             * updates the layout of the affected groups. This method is invoked by a parameter
+             * when its stream identifier or descriptor changes.
+             * @param parameter The parameter that changed.
+             */
+            void updateParameter(Parameter* parameter);
+
+            /**
+             * Removes a parameter from its group by moving the last parameter of the group
+             * into its place. The layout is only recomputed when the removed value ended
+             * the octet stream. The group is removed as well when it no longer contains
+             * any parameters.
+             * @param parameter The parameter to remove.
+             * @param registration The registration of the parameter.
+             */
+            void removeFromGroup(Parameter* parameter, Registration const& registration);
+
+            /**
+             * Appends a parameter to the group of its current stream identifier and
+             * stores its position within the group in the passed registration.
+             * @param parameter The parameter to add.
+             * @param registration The registration of the parameter.
+             */
+            void addToGroup(Parameter* parameter, Registration& registration);
+
         private:
+            typedef std::unordered_map<Parameter const*, Registration> RegistrationMap;
+
             ParameterCollection m_parameters;
+            RegistrationMap m_registrations;
+            GroupCollection m_groups;
 
         private:
             /**
@@ -77,7 +77,7 @@ namespace glow
 
     void Consumer::read(const_iterator first, const_iterator last, size_type size)
     {
-        m_decoder.read(first, last, Consumer::dispatch, this);
+        m_decoder.readSpan(first, last, Consumer::dispatch, this);
     }
 
     void Consumer::handleMessage(Decoder::const_iterator first, Decoder::const_iterator last)
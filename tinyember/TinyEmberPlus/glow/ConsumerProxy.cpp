@@ -52,46 +52,57 @@ namespace glow
 
     void ConsumerProxy::writeRequestKeepAlive()
     {
-        auto const result = Encoder::createRequestKeepAliveMessage();
         auto server = m_server;
         if (server != nullptr)
-        {
-            auto const last = result.end();
-            for(auto it = result.begin(); it != last; ++it)
-            {
-                server->write(it->begin(), it->end());
-            }
-        }
+            server->write(toByteArray(Encoder::createRequestKeepAliveMessage()));
     }
 
     void ConsumerProxy::writeProviderState(bool state)
     {
-        auto const result = Encoder::createProviderStateMessage(state);
         auto server = m_server;
         if (server != nullptr)
-        {
-            auto const last = result.end();
-            for(auto it = result.begin(); it != last; ++it)
-            {
-                server->write(it->begin(), it->end());
-            }
-        }
+            server->write(toByteArray(Encoder::createProviderStateMessage(state)));
     }
 
-    void ConsumerProxy::write(libember::glow::GlowContainer const* container)
+    void ConsumerProxy::write(libember::glow::GlowContainer const* container, net::TcpClient::MessageType::_Domain type, net::TcpClient::MessageKey const& key)
     {
-        // The createEmberMessage returns an Encoder which may contain several packets
-        // that need to be transmitted separately.
-        auto const result = Encoder::createEmberMessage(container);
         auto server = m_server;
         if (server != nullptr)
-        {
-            auto const last = result.end();
-            for(auto it = result.begin(); it != last; ++it)
-            {
-                server->write(it->begin(), it->end());
-            }
-        }
+            server->write(toByteArray(Encoder::createEmberMessage(container)), type, key);
+    }
+
+    std::vector<net::TcpClient::QueueMetrics> ConsumerProxy::metrics() const
+    {
+        auto server = m_server;
+        return server != nullptr
+            ? server->metrics()
+            : std::vector<net::TcpClient::QueueMetrics>();
+    }
+
+    std::vector<net::TcpClient::ReceiveMetrics> ConsumerProxy::receiveMetrics() const
+    {
+        auto server = m_server;
+        return server != nullptr
+            ? server->receiveMetrics()
+            : std::vector<net::TcpClient::ReceiveMetrics>();
+    }
+
+    //static
+    QByteArray ConsumerProxy::toByteArray(Encoder const& encoder)
+    {
+        // The createEmberMessage returns an Encoder which may contain several packets.
+        // They are queued as a single message, so that a message is either transmitted
+        // completely or dropped completely.
+        auto size = Encoder::Packet::size_type(0);
+        for(auto const& packet : encoder)
+            size += packet.size();
+
+        auto array = QByteArray();
+        array.reserve(static_cast<int>(size));
+        for(auto const& packet : encoder)
+            std::copy(packet.begin(), packet.end(), std::back_inserter(array));
+
+        return array;
     }
 
     void ConsumerProxy::notifyStateChanged(gadget::NodeFieldState const& state, gadget::Node const* object)
@@ -103,6 +114,7 @@ namespace glow
         {
             auto const root = GlowRootElementCollection::create();
             auto const behavior = settings().notificationBehavior().value();
+            auto const key = notificationKey(object);
 
             if (behavior == NotificationBehavior::UseExpandedContainer)
                 transform(root, object);
@@ -110,10 +122,10 @@ namespace glow
                 transformQualified(root, object);
 
             if (root->size() > 0)
-                write(root);
+                write(root, net::TcpClient::MessageType::Update, key);
             delete root;
 
-            object->clearDirtyState(true);
+            object->clearJournal();
         }
     }
 
@@ -121,85 +133,113 @@ namespace glow
     {
         if (node != nullptr)
         {
-            auto const nodeState = node->dirtyState().mask(~gadget::NodeField::DirtyChildEntity);
-            if (nodeState.isDirty())
+            auto const& nodes = node->dirtyNodes();
+            for(auto child : nodes)
             {
-                return true;
+                auto const state = child->dirtyState().mask(~gadget::NodeField::DirtyChildEntity);
+                if (state.isDirty())
+                    return true;
             }
-            else if(node->isDirty())
+
+            auto const& parameters = node->dirtyParameters();
+            for(auto parameter : parameters)
             {
-                auto const& manager = gadget::StreamManager::instance();
-                auto const& nodes = node->nodes();
-                auto const& parameters = node->parameters();
-                for(auto parameter : parameters)
-                {
-                    if (manager.isParameterTransmittedViaStream(parameter) && parameter->dirtyState().isSet(gadget::ParameterField::ForceUpdate) == false)
-                    {
-                        auto const state = parameter->dirtyState().mask(~gadget::ParameterField::Value);
-                        if (state.isDirty())
-                            return true;
-                    }
-                    else
-                    {
-                        auto const state = parameter->dirtyState();
-                        if (state.isDirty())
-                            return true;
-                    }
-                }
-
-                for(auto child : nodes)
-                {
-                    auto const isDirty = isNotificationRequired(child);
-                    if (isDirty)
-                        return true;
-                }
+                if (notificationState(parameter).isDirty())
+                    return true;
             }
         }
 
         return false;
     }
 
-    void ConsumerProxy::transformQualified(libember::glow::GlowRootElementCollection* root, gadget::Node const* node)
+    //static
+    net::TcpClient::MessageKey ConsumerProxy::notificationKey(gadget::Node const* node)
     {
-        auto const state = node->dirtyState().mask(~gadget::NodeField::DirtyChildEntity);
-        if (state.isDirty())
+        auto const& parameters = node->dirtyParameters();
+        if (parameters.size() != 1)
+            return net::TcpClient::MessageKey();
+
+        for(auto child : node->dirtyNodes())
+        {
+            auto const state = child->dirtyState().mask(~gadget::NodeField::DirtyChildEntity);
+            if (state.isDirty())
+                return net::TcpClient::MessageKey();
+        }
+
+        auto const parameter = parameters.front();
+        auto const state = notificationState(parameter).mask(~gadget::ParameterField::ForceUpdate);
+        return net::TcpClient::MessageKey(parameter, state.value());
+    }
+
+    //static
+    gadget::ParameterFieldState ConsumerProxy::notificationState(gadget::Parameter const* parameter)
+    {
+        auto const& manager = gadget::StreamManager::instance();
+        auto state = parameter->dirtyState();
+        if (manager.isParameterTransmittedViaStream(parameter) && state.isSet(gadget::ParameterField::ForceUpdate) == false)
         {
-            util::NodeConverter::createQualified(root, node, state);
+            /**
+             * Do not notify the value when it is already transmitted via a stream.
+             */
+            state = state.mask(~gadget::ParameterField::Value);
         }
 
-        auto const& nodes = node->nodes();
+        return state;
+    }
+
+    void ConsumerProxy::transformQualified(libember::glow::GlowRootElementCollection* root, gadget::Node const* node)
+    {
+        auto const& nodes = node->dirtyNodes();
         for(auto child : nodes)
         {
-            transformQualified(root, child);
+            auto const state = child->dirtyState().mask(~gadget::NodeField::DirtyChildEntity);
+            if (state.isDirty())
+            {
+                util::NodeConverter::createQualified(root, child, state);
+            }
         }
 
-        auto const& parameters = node->parameters();
+        auto const& parameters = node->dirtyParameters();
         for(auto parameter : parameters)
         {
             transformQualified(root, parameter);
         }
     }
 
-    void ConsumerProxy::transform(libember::glow::GlowContainer* parent, gadget::Node const* node) const
+    void ConsumerProxy::transform(libember::glow::GlowContainer* parent, gadget::Node const* root) const
     {
-        if (isNotificationRequired(node))
-        {
-            parent = util::NodeConverter::create(parent, node, node->dirtyState())->children();
+        auto containers = ContainerMap();
 
-            auto const& nodes = node->nodes();
-            for(auto child : nodes)
-            {
-                if (child->isDirty())
-                    transform(parent, child);
-            }
+        auto const& nodes = root->dirtyNodes();
+        for(auto node : nodes)
+        {
+            auto const state = node->dirtyState().mask(~gadget::NodeField::DirtyChildEntity);
+            if (state.isDirty())
+                containerOf(parent, node, containers);
+        }
 
-            auto const& parameters = node->parameters();
-            for(auto parameter : parameters)
-            {
-                transform(parent, parameter);
-            }
+        auto const& parameters = root->dirtyParameters();
+        for(auto parameter : parameters)
+        {
+            if (notificationState(parameter).isDirty())
+                transform(containerOf(parent, parameter->parent(), containers), parameter);
         }
     }
+
+    libember::glow::GlowContainer* ConsumerProxy::containerOf(libember::glow::GlowContainer* root, gadget::Node const* node, ContainerMap& containers) const
+    {
+        auto const result = containers.find(node);
+        if (result != containers.end())
+            return result->second;
+
+        auto const parent = node->parent() != nullptr
+            ? containerOf(root, node->parent(), containers)
+            : root;
+
+        auto const container = util::NodeConverter::create(parent, node, node->dirtyState())->children();
+        containers.insert(std::make_pair(node, container));
+        return container;
+    }
     
     void ConsumerProxy::transformQualified(libember::glow::GlowRootElementCollection* root, gadget::Parameter const* parameter)
     {
@@ -221,16 +261,7 @@ namespace glow
 
     void ConsumerProxy::transform(libember::glow::GlowContainer* parent, gadget::Parameter const* parameter) const
     {
-        auto const& manager = gadget::StreamManager::instance();
-        auto state = parameter->dirtyState();
-        if (manager.isParameterTransmittedViaStream(parameter) && state.isSet(gadget::ParameterField::ForceUpdate) == false)
-        {
-            /**
-             * Do not notify the value when it is already transmitted via a stream.
-             */
-            state = state.mask(~gadget::ParameterField::Value);
-        }
-
+        auto const state = notificationState(parameter);
         if (state.isDirty())
         {
             util::ParameterConverter::create(parent, parameter, state);
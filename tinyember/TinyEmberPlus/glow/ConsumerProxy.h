@@ -7,6 +7,7 @@
 #ifndef __TINYEMBER_GLOW_CONSUMERPROXY_H
 #define __TINYEMBER_GLOW_CONSUMERPROXY_H
 
+#include <unordered_map>
 #include "../net/TcpClientFactory.h"
 #include "../net/TcpServer.h"
 #include "../gadget/Node.h"
@@ -25,7 +26,8 @@ namespace libember { namespace glow
 
 namespace glow
 {
-    /** Forward declaration */
+    /** Forward declarations */
+    class Encoder;
     class ProviderInterface;
 
     /**
@@ -61,8 +63,25 @@ namespace glow
             /**
              * Encodes the passed tree and sends it to all currently connected consumers.
              * @param container The tree to encode and transmit.
+             * @param type The type of the message, which defines how it is queued for
+             *      consumers that cannot keep up.
+             * @param key Identifies update messages which supersede each other.
              */
-            void write(libember::glow::GlowContainer const* container);
+            void write(libember::glow::GlowContainer const* container,
+                net::TcpClient::MessageType::_Domain type = net::TcpClient::MessageType::Control,
+                net::TcpClient::MessageKey const& key = net::TcpClient::MessageKey());
+
+            /**
+             * Returns the queue metrics of all currently connected consumers.
+             * @return The queue metrics of all currently connected consumers.
+             */
+            std::vector<net::TcpClient::QueueMetrics> metrics() const;
+
+            /**
+             * Returns the counters of the data received from all currently connected consumers.
+             * @return The receive counters of all currently connected consumers.
+             */
+            std::vector<net::TcpClient::ReceiveMetrics> receiveMetrics() const;
 
             /**
              * Sends a keep-alive request message to all connected clients.
@@ -90,20 +109,25 @@ namespace glow
             
         private:
             /**
-             * This method is invoked when the root node or one of its children have changed. It then write
-             * the updated data to all consumers.
+             * This method is invoked when the root node or one of its children have changed. It then writes
+             * the entities contained in the dirty journal of the root node to all consumers and clears
+             * the journal.
              * @param state The dirty state of the node that changed.
              * @param object The node that has changed its state.
              */
             virtual void notifyStateChanged(gadget::NodeFieldState const &state, gadget::Node const* object);
 
         private:
+            typedef std::unordered_map<gadget::Node const*, libember::glow::GlowContainer*> ContainerMap;
+
             /**
-             * Transforms a node into a GlowNode. All children that are marked dirty will be appended as well.
-             * @param parent The container to append the node to.
-             * @param node The node to convert.
+             * Transforms all journaled entities of the root node into GlowNodes and GlowParameters.
+             * The nodes required to reach a journaled entity are created once and are shared by
+             * all entities having the same parent.
+             * @param parent The container to append the root node to.
+             * @param root The root node owning the journal.
              */
-            void transform(libember::glow::GlowContainer* parent, gadget::Node const* node) const;
+            void transform(libember::glow::GlowContainer* parent, gadget::Node const* root) const;
 
             /**
              * Transforms a parameter into a GlowParameter.
@@ -113,9 +137,20 @@ namespace glow
             void transform(libember::glow::GlowContainer* parent, gadget::Parameter const* parameter) const;
 
             /**
-             * Transforms a node into a GlowQualifiedNode.
-             * @param root The root element collection to append the node to.
-             * @param node The node to convert.
+             * Returns the children container of the GlowNode which represents the passed node. If the
+             * GlowNode does not exist yet, it is created along with the GlowNodes of all its parents.
+             * @param root The container to append the GlowNode of the root node to.
+             * @param node The node to look up.
+             * @param containers The GlowNodes that have already been created.
+             * @return The children container of the GlowNode.
+             */
+            libember::glow::GlowContainer* containerOf(libember::glow::GlowContainer* root, gadget::Node const* node, ContainerMap& containers) const;
+
+            /**
+             * Transforms all journaled entities of the root node into GlowQualifiedNodes and
+             * GlowQualifiedParameters.
+             * @param root The root element collection to append the elements to.
+             * @param node The root node owning the journal.
              */
             void transformQualified(libember::glow::GlowRootElementCollection* root, gadget::Node const* node);
 
@@ -127,14 +162,40 @@ namespace glow
             void transformQualified(libember::glow::GlowRootElementCollection* root, gadget::Parameter const* parameter);
 
             /**
-             * Tests whether a node needs to be transmitted or not. A node will not be transmitted when only the value of
-             * parameter which is transmitted via a stream is marked dirty.
-             * @param node The node to test.
-             * @return true if the node needs to be transmitted via the default mechanism, false if only a parameter
-             *      value is marked dirty which will be transmitted in a stream anyway.
+             * Tests whether the journal of the root node contains an entity that needs to be transmitted. No
+             * notification is required when only the values of parameters which are transmitted via a stream
+             * are marked dirty.
+             * @param node The root node owning the journal.
+             * @return true if at least one journaled entity needs to be transmitted via the default mechanism,
+             *      false if only parameter values are marked dirty which will be transmitted in a stream anyway.
              */
             bool isNotificationRequired(gadget::Node const* node) const;
 
+            /**
+             * Returns the dirty state of a parameter without the value flag, if the value is transmitted
+             * via a stream and no update has been forced.
+             * @param parameter The parameter to get the state of.
+             * @return The fields of the parameter that need to be transmitted.
+             */
+            static gadget::ParameterFieldState notificationState(gadget::Parameter const* parameter);
+
+            /**
+             * Returns the key of a notification which only contains a single parameter. Queued
+             * notifications with the same key are superseded by the new one.
+             * @param node The root node owning the journal.
+             * @return The key of the notification, or an invalid key if the journal contains
+             *      more than one entity that needs to be transmitted.
+             */
+            static net::TcpClient::MessageKey notificationKey(gadget::Node const* node);
+
+            /**
+             * Copies all packets of an encoded message into a single array, which is shared
+             * by the queues of all consumers.
+             * @param encoder The encoded message.
+             * @return The array containing all packets.
+             */
+            static QByteArray toByteArray(Encoder const& encoder);
+
         private:
             ProviderInterface *const m_provider;
             net::TcpServer* m_server;
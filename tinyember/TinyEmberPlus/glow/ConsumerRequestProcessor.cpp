@@ -29,15 +29,17 @@ namespace glow
         auto const last = request->end();
         for(auto it = first; it != last; ++it)
         {
-            auto const& node = *it;
-            auto const type = ber::Type::fromTag(node.typeTag());
+            auto const container = libember::glow::GlowContainer::fromNode(&*it);
+            if (container == nullptr)
+                continue;
 
-            switch(type.value())
+            auto const& node = *container;
+            switch(node.type().value())
             {
                 case libember::glow::GlowType::Command:
                 {
                     // Report root node
-                    auto const& glow = dynamic_cast<GlowCommand const&>(node);
+                    auto const& glow = static_cast<GlowCommand const&>(node);
                     if (glow.number().value() == libember::glow::CommandType::GetDirectory)
                     {
                         auto const& settings = ConsumerProxy::settings();
@@ -61,7 +63,7 @@ namespace glow
                 }
                 case libember::glow::GlowType::QualifiedNode:
                 {
-                    auto const& glow = dynamic_cast<libember::glow::GlowQualifiedNode const&>(node);
+                    auto const& glow = static_cast<libember::glow::GlowQualifiedNode const&>(node);
                     auto const oid = glow.path();
                     auto const path = EntityPath(oid.begin(), oid.end());
                     auto local = resolve_node(root, path.begin(), path.end());
@@ -74,7 +76,7 @@ namespace glow
                 }
                 case libember::glow::GlowType::QualifiedParameter:
                 {
-                    auto const& glow = dynamic_cast<libember::glow::GlowQualifiedParameter const&>(node);
+                    auto const& glow = static_cast<libember::glow::GlowQualifiedParameter const&>(node);
                     auto const oid = glow.path();
                     auto const path = EntityPath(oid.begin(), oid.end());
                     auto local = resolve_parameter(root, path.begin(), path.end());
@@ -88,7 +90,7 @@ namespace glow
                 case libember::glow::GlowType::Node:
                 {
                     context.setIsQualifiedRequest(false);
-                    auto const& glow = dynamic_cast<libember::glow::GlowNode const&>(node);
+                    auto const& glow = static_cast<libember::glow::GlowNode const&>(node);
                     auto const number = glow.number();
                     if (number == root->number())
                     {
@@ -118,47 +120,37 @@ namespace glow
             {
                 for(auto& child : *children)
                 {
-                    auto const type = libember::ber::Type::fromTag(child.typeTag());
-                    switch(type.value())
+                    auto const container = libember::glow::GlowContainer::fromNode(&child);
+                    if (container == nullptr)
+                        continue;
+
+                    switch(container->type().value())
                     {
                         case libember::glow::GlowType::Command:
                         {
-                            auto const& command = dynamic_cast<libember::glow::GlowCommand const&>(child);
+                            auto const& command = static_cast<libember::glow::GlowCommand const&>(*container);
                             executeCommand(&command, node, response, context);
                             break;
                         }
                         case libember::glow::GlowType::Node:
                         {
-                            auto const& glow = dynamic_cast<libember::glow::GlowNode const&>(child);
-                            auto const& nodes = node->nodes();
-                            auto const first = std::begin(nodes);
-                            auto const last = std::end(nodes);
-                            auto const number = glow.number();
-                            auto result = std::find_if(first, last, [&glow](Node const* child) -> bool
-                            {
-                                return glow.number() == child->number();
-                            });
+                            auto const& glow = static_cast<libember::glow::GlowNode const&>(*container);
+                            auto const result = node->findNode(glow.number());
 
-                            if (result != last)
+                            if (result != nullptr)
                             {
-                                executeNode(&glow, *result, response, context);
+                                executeNode(&glow, result, response, context);
                             }
                             break;
                         }
                         case libember::glow::GlowType::Parameter:
                         {
-                            auto const& glow = dynamic_cast<libember::glow::GlowParameter const&>(child);
-                            auto const& parameters = node->parameters();
-                            auto const first = std::begin(parameters);
-                            auto const last = std::end(parameters);
-                            auto result = std::find_if(first, last, [&glow](Parameter const* child) -> bool
-                            {
-                                return glow.number() == child->number();
-                            });
+                            auto const& glow = static_cast<libember::glow::GlowParameter const&>(*container);
+                            auto const result = node->findParameter(glow.number());
 
-                            if (result != last)
+                            if (result != nullptr)
                             {
-                                executeParameter(&glow, *result, response, context);
+                                executeParameter(&glow, result, response, context);
                             }
                             break;
                         }
@@ -246,31 +238,31 @@ namespace glow
                 {
                     case gadget::ParameterType::Boolean:
                     {
-                        auto boolean = dynamic_cast<gadget::BooleanParameter*>(parameter);
+                        auto boolean = static_cast<gadget::BooleanParameter*>(parameter);
                         boolean->setValue(value.toBoolean(), forceNotification);
                         break;
                     }
                     case gadget::ParameterType::Enum:
                     {
-                        auto enumeration = dynamic_cast<gadget::EnumParameter*>(parameter);
+                        auto enumeration = static_cast<gadget::EnumParameter*>(parameter);
                         enumeration->setIndex(static_cast<gadget::EnumParameter::size_type>(value.toInteger()), forceNotification);
                         break;
                     }
                     case gadget::ParameterType::Integer:
                     {
-                        auto integer = dynamic_cast<gadget::IntegerParameter*>(parameter);
+                        auto integer = static_cast<gadget::IntegerParameter*>(parameter);
                         integer->setValue(value.toInteger(), forceNotification);
                         break;
                     }
                     case gadget::ParameterType::Real:
                     {
-                        auto real = dynamic_cast<gadget::RealParameter*>(parameter);
+                        auto real = static_cast<gadget::RealParameter*>(parameter);
                         real->setValue(value.toReal(), forceNotification);
                         break;
                     }
                     case gadget::ParameterType::String:
                     {
-                        auto string = dynamic_cast<gadget::StringParameter*>(parameter);
+                        auto string = static_cast<gadget::StringParameter*>(parameter);
                         string->setValue(value.toString(), forceNotification);
                         break;
                     }
@@ -282,11 +274,14 @@ namespace glow
             {
                 for(auto& child : *children)
                 {
-                    auto const type = libember::ber::Type::fromTag(child.typeTag());
-                    switch(type.value())
+                    auto const container = libember::glow::GlowContainer::fromNode(&child);
+                    if (container == nullptr)
+                        continue;
+
+                    switch(container->type().value())
                     {
                         case libember::glow::GlowType::Command:
-                            auto const& command = dynamic_cast<libember::glow::GlowCommand const&>(child);
+                            auto const& command = static_cast<libember::glow::GlowCommand const&>(*container);
                             executeCommand(&command, parameter, response, context);
                             break;
                     }
@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <memory>
+#include <QtCore/qcoreapplication.h>
+#include <ember/Ember.hpp>
+#include "ConsumerProxy.h"
+#include "StreamScheduler.h"
+
+namespace glow
+{
+    StreamScheduler::SampleEvent::SampleEvent()
+        : QEvent(eventType())
+    {}
+
+    //static
+    QEvent::Type StreamScheduler::SampleEvent::eventType()
+    {
+        static auto const type = static_cast<QEvent::Type>(QEvent::registerEventType());
+        return type;
+    }
+
+
+    StreamScheduler::IntervalEvent::IntervalEvent(int interval)
+        : QEvent(eventType())
+        , m_interval(interval)
+    {}
+
+    int StreamScheduler::IntervalEvent::interval() const
+    {
+        return m_interval;
+    }
+
+    //static
+    QEvent::Type StreamScheduler::IntervalEvent::eventType()
+    {
+        static auto const type = static_cast<QEvent::Type>(QEvent::registerEventType());
+        return type;
+    }
+
+
+    StreamScheduler::StreamScheduler(ConsumerProxy* proxy, QObject* sampler)
+        : m_proxy(proxy)
+        , m_sampler(sampler)
+        , m_isSampleRequested(0)
+        , m_pending(nullptr)
+        , m_timerId(0)
+    {
+        moveToThread(&m_thread);
+    }
+
+    StreamScheduler::~StreamScheduler()
+    {
+        stop();
+        delete m_pending;
+    }
+
+    void StreamScheduler::setInterval(int interval)
+    {
+        if (interval > 0)
+        {
+            if (m_thread.isRunning() == false)
+                m_thread.start(QThread::TimeCriticalPriority);
+
+            QCoreApplication::postEvent(this, new IntervalEvent(interval));
+        }
+    }
+
+    void StreamScheduler::stop()
+    {
+        if (m_thread.isRunning())
+        {
+            // The timer must be killed by the scheduler thread, so the thread quits
+            // itself after it has handled this event.
+            QCoreApplication::postEvent(this, new IntervalEvent(0));
+            m_thread.wait();
+        }
+    }
+
+    void StreamScheduler::publish(libember::glow::GlowStreamCollection* collection)
+    {
+        if (collection != nullptr && collection->size() > 0)
+        {
+            QMutexLocker const lock(&m_mutex);
+            std::swap(m_pending, collection);
+        }
+
+        // Deletes either an empty collection or one that has been replaced before it
+        // could be transmitted.
+        delete collection;
+        m_isSampleRequested.storeRelease(0);
+    }
+
+    void StreamScheduler::customEvent(QEvent* event)
+    {
+        if (event->type() == IntervalEvent::eventType())
+        {
+            auto const interval = static_cast<IntervalEvent*>(event)->interval();
+            if (m_timerId != 0)
+            {
+                killTimer(m_timerId);
+                m_timerId = 0;
+            }
+
+            if (interval > 0)
+                m_timerId = startTimer(interval, Qt::PreciseTimer);
+            else
+                m_thread.quit();
+        }
+    }
+
+    void StreamScheduler::timerEvent(QTimerEvent* event)
+    {
+        if (event->timerId() == m_timerId)
+        {
+            auto collection = std::unique_ptr<libember::glow::GlowStreamCollection>();
+            {
+                QMutexLocker const lock(&m_mutex);
+                collection.reset(m_pending);
+                m_pending = nullptr;
+            }
+
+            if (collection)
+                m_proxy->write(collection.get(), net::TcpClient::MessageType::Stream);
+
+            // Only a single sample request may be pending, so that a busy ui thread
+            // doesn't accumulate requests.
+            if (m_isSampleRequested.testAndSetOrdered(0, 1))
+                QCoreApplication::postEvent(m_sampler, new SampleEvent());
+        }
+    }
+}
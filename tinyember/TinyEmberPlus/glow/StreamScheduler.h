@@ -0,0 +1,145 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_GLOW_STREAMSCHEDULER_H
+#define __TINYEMBER_GLOW_STREAMSCHEDULER_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qthread.h>
+
+/** Forward declarations */
+namespace libember { namespace glow
+{
+    class GlowStreamCollection;
+}
+}
+
+namespace glow
+{
+    /** Forward declaration */
+    class ConsumerProxy;
+
+    /**
+     * The StreamScheduler transmits the stream values on a dedicated thread, so that the
+     * interval between two stream messages doesn't depend on the load of the ui thread.
+     * The scheduler owns a precise periodic timer. On each tick, it encodes and transmits
+     * the stream collection that has been published since the previous tick and then posts
+     * a SampleEvent to the sampler, which lives on the ui thread. The sampler collects the
+     * current stream values and hands them over by calling publish. This way, the ui thread
+     * only has to collect the values, while the collection that has been sampled before is
+     * being encoded.
+     */
+    class StreamScheduler : public QObject
+    {
+        public:
+            /**
+             * This event is posted to the sampler when the next stream collection is required.
+             */
+            class SampleEvent : public QEvent
+            {
+                public:
+                    /** Initializes a new SampleEvent. */
+                    SampleEvent();
+
+                    /**
+                     * Returns the event type registered for SampleEvent objects.
+                     * @return The event type registered for SampleEvent objects.
+                     */
+                    static QEvent::Type eventType();
+            };
+
+        public:
+            /**
+             * Initializes a new StreamScheduler. The scheduler thread is started by the
+             * first call to setInterval.
+             * @param proxy The consumer proxy used to transmit the stream collections.
+             * @param sampler The object that receives the SampleEvents. It must publish
+             *      a stream collection for each SampleEvent it receives.
+             */
+            StreamScheduler(ConsumerProxy* proxy, QObject* sampler);
+
+            /** Destructor, stops the scheduler thread. */
+            virtual ~StreamScheduler();
+
+            /**
+             * Updates the interval of the stream timer and starts the scheduler thread if
+             * it is not running yet.
+             * @param interval The stream interval, in milliseconds.
+             */
+            void setInterval(int interval);
+
+            /**
+             * Stops the stream timer and waits until the scheduler thread has finished.
+             * Stream collections published afterwards are no longer transmitted.
+             */
+            void stop();
+
+            /**
+             * Hands over the stream collection sampled in response to a SampleEvent. The
+             * collection is transmitted with the next tick.
+             * @param collection The collection to transmit. The scheduler takes ownership.
+             *      Empty collections are discarded.
+             */
+            void publish(libember::glow::GlowStreamCollection* collection);
+
+        protected:
+            /**
+             * Applies a new interval on the scheduler thread.
+             * @param event The event to handle.
+             */
+            virtual void customEvent(QEvent* event);
+
+            /**
+             * Transmits the pending stream collection and requests the next one.
+             * @param event The timer event.
+             */
+            virtual void timerEvent(QTimerEvent* event);
+
+        private:
+            /**
+             * Carries a new stream interval to the scheduler thread. An interval of zero
+             * or less stops the timer and quits the thread.
+             */
+            class IntervalEvent : public QEvent
+            {
+                public:
+                    /**
+                     * Initializes a new IntervalEvent.
+                     * @param interval The new stream interval, in milliseconds.
+                     */
+                    explicit IntervalEvent(int interval);
+
+                    /**
+                     * Returns the new stream interval.
+                     * @return The new stream interval, in milliseconds.
+                     */
+                    int interval() const;
+
+                    /**
+                     * Returns the event type registered for IntervalEvent objects.
+                     * @return The event type registered for IntervalEvent objects.
+                     */
+                    static QEvent::Type eventType();
+
+                private:
+                    int m_interval;
+            };
+
+        private:
+            ConsumerProxy *const m_proxy;
+            QObject *const m_sampler;
+            QThread m_thread;
+            QMutex m_mutex;
+            QAtomicInt m_isSampleRequested;
+            libember::glow::GlowStreamCollection* m_pending;
+            int m_timerId;
+    };
+}
+
+#endif//__TINYEMBER_GLOW_STREAMSCHEDULER_H
@@ -6,9 +6,9 @@
 
 #include "../../gadget/ParameterTypeVisitor.h"
 #include "../../gadget/StreamFormat.h"
-#include <map>
-#include <memory>
-#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <ember/Ember.hpp>
 #include "StreamConverter.h"
 #include "../../gadget/BooleanParameter.h"
@@ -24,163 +24,49 @@
  **************************************************************************/
 
 template<typename OutputIterator>
-inline void glow::util::StreamConverter::encode(long long value, gadget::StreamFormat const& format, OutputIterator first, OutputIterator last)
+inline void glow::util::StreamConverter::store(unsigned long long bits, gadget::StreamFormat const& format, OutputIterator first)
 {
-    auto const type = format.value();
-    switch(type)
+    auto const size = format.size();
+    if (format.isLittleEndian())
     {
-        case gadget::StreamFormat::UnsignedInt8:
-            *first = (value & 0xFF);
-            break;
-
-        case gadget::StreamFormat::UnsignedInt16BigEndian:
-            *first++ = ((value >> 8) & 0xFF);
-            *first++ = ((value >> 0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::UnsignedInt16LittleEndian:
-            *first++ = ((value >> 0) & 0xFF);
-            *first++ = ((value >> 8) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::UnsignedInt32BigEndian:
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >>  0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::UnsignedInt32LittleEndian:
-            *first++ = ((value >>  0) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::UnsignedInt64BigEndian:
-            *first++ = ((value >> 56) & 0xFF);
-            *first++ = ((value >> 48) & 0xFF);
-            *first++ = ((value >> 40) & 0xFF);
-            *first++ = ((value >> 32) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >>  0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::UnsignedInt64LittleEndian:
-            *first++ = ((value >>  0) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 32) & 0xFF);
-            *first++ = ((value >> 40) & 0xFF);
-            *first++ = ((value >> 48) & 0xFF);
-            *first++ = ((value >> 56) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt8:
-            *first = (value & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt16BigEndian:
-            *first++ = ((value >> 8) & 0xFF);
-            *first++ = ((value >> 0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt16LittleEndian:
-            *first++ = ((value >> 0) & 0xFF);
-            *first++ = ((value >> 8) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt32BigEndian:
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >>  0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt32LittleEndian:
-            *first++ = ((value >>  0) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt64BigEndian:
-            *first++ = ((value >> 56) & 0xFF);
-            *first++ = ((value >> 48) & 0xFF);
-            *first++ = ((value >> 40) & 0xFF);
-            *first++ = ((value >> 32) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >>  0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::SignedInt64LittleEndian:
-            *first++ = ((value >>  0) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 32) & 0xFF);
-            *first++ = ((value >> 40) & 0xFF);
-            *first++ = ((value >> 48) & 0xFF);
-            *first++ = ((value >> 56) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::IeeeFloat32BigEndian:
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >>  0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::IeeeFloat32LittleEndian:
-            *first++ = ((value >>  0) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::IeeeFloat64BigEndian:
-            *first++ = ((value >> 56) & 0xFF);
-            *first++ = ((value >> 48) & 0xFF);
-            *first++ = ((value >> 40) & 0xFF);
-            *first++ = ((value >> 32) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >>  0) & 0xFF);
-            break;
-
-        case gadget::StreamFormat::IeeeFloat64LittleEndian:
-            *first++ = ((value >>  0) & 0xFF);
-            *first++ = ((value >>  8) & 0xFF);
-            *first++ = ((value >> 16) & 0xFF);
-            *first++ = ((value >> 24) & 0xFF);
-            *first++ = ((value >> 32) & 0xFF);
-            *first++ = ((value >> 40) & 0xFF);
-            *first++ = ((value >> 48) & 0xFF);
-            *first++ = ((value >> 56) & 0xFF);
-            break;
+        for(auto shift = std::size_t(0); shift < 8 * size; shift += 8)
+            *first++ = static_cast<unsigned char>((bits >> shift) & 0xFF);
+    }
+    else
+    {
+        for(auto shift = 8 * size; shift > 0; shift -= 8)
+            *first++ = static_cast<unsigned char>((bits >> (shift - 8)) & 0xFF);
     }
 }
 
+template<typename OutputIterator>
+inline void glow::util::StreamConverter::encode(long long value, gadget::StreamFormat const& format, OutputIterator first, OutputIterator last)
+{
+    if (format.isReal())
+        encode(static_cast<double>(value), format, first, last);
+    else
+        store(static_cast<unsigned long long>(value), format, first);
+}
+
 template<typename OutputIterator>
 inline void glow::util::StreamConverter::encode(double value, gadget::StreamFormat const& format, OutputIterator first, OutputIterator last)
 {
-    if (format.value() == gadget::StreamFormat::IeeeFloat64BigEndian
-    ||  format.value() == gadget::StreamFormat::IeeeFloat64LittleEndian)
+    if (format.isReal() == false)
+    {
+        encode(static_cast<long long>(value), format, first, last);
+    }
+    else if (format.size() == sizeof(std::uint64_t))
     {
-        long long transformed = *(reinterpret_cast<long long*>(&value));
-        encode(transformed, format, first, last);
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        store(bits, format, first);
     }
     else
     {
-        auto valueAsSingle = static_cast<float>(value);
-        long long transformed = *(reinterpret_cast<long*>(&valueAsSingle));
-        encode(transformed, format, first, last);
+        auto const valueAsSingle = static_cast<float>(value);
+        std::uint32_t bits;
+        std::memcpy(&bits, &valueAsSingle, sizeof(bits));
+        store(bits, format, first);
     }
 }
 
@@ -193,15 +79,24 @@ inline void glow::util::StreamConverter::encode(gadget::Parameter* parameter, Ou
 template<typename OutputIterator>
 inline void glow::util::StreamConverter::OctetStreamEntryEncoder<OutputIterator>::encode(gadget::Parameter* parameter, OutputIterator first, OutputIterator last)
 {
-    auto volatile encoder = OctetStreamEntryEncoder(parameter, first, last);
+    auto encoder = OctetStreamEntryEncoder(first, last);
+    parameter->accept(encoder);
+}
+
+template<typename OutputIterator>
+template<typename InputIterator>
+inline void glow::util::StreamConverter::OctetStreamEntryEncoder<OutputIterator>::encode(InputIterator parameters, InputIterator end, OutputIterator first, OutputIterator last)
+{
+    auto encoder = OctetStreamEntryEncoder(first, last);
+    for(/* Nothing */; parameters != end; ++parameters)
+        (*parameters)->accept(encoder);
 }
 
 template<typename OutputIterator>
-glow::util::StreamConverter::OctetStreamEntryEncoder<OutputIterator>::OctetStreamEntryEncoder(gadget::Parameter* parameter, OutputIterator first, OutputIterator last)
+glow::util::StreamConverter::OctetStreamEntryEncoder<OutputIterator>::OctetStreamEntryEncoder(OutputIterator first, OutputIterator last)
     : m_first(first)
     , m_last(last)
 {
-    parameter->accept(*this);
 }
 
 template<typename OutputIterator>
@@ -293,90 +188,52 @@ namespace glow { namespace util
         parameter->accept(*this);
     }
 
+    void StreamConverter::encode(gadget::StreamManager::StreamGroup const& group)
+    {
+        typedef gadget::StreamManager::StreamGroup::Buffer::iterator OutputIterator;
+        auto const& parameters = group.parameters();
+        auto& buffer = group.buffer();
 
-
+        OctetStreamEntryEncoder<OutputIterator>::encode(std::begin(parameters), std::end(parameters), std::begin(buffer), std::end(buffer));
+    }
 
     libember::glow::GlowStreamCollection* StreamConverter::create(libember::glow::GlowStreamCollection* root, gadget::StreamManager const& manager)
     {
-        typedef std::vector<gadget::Parameter*> ParameterCollection;
-        std::map<int, std::unique_ptr<ParameterCollection> > dic;
-
+        for(auto const& pair : manager.groups())
         {
-            auto it = std::begin(manager);
-            auto const last= std::end(manager);
-            for (; it != last; ++it)
-            {
-                auto& parameter = *it;
-                auto const identifier = parameter->streamIdentifier();
+            auto const& group = pair.second;
+            auto const& streams = group.parameters();
+            auto const identifier = group.identifier();
 
-                if (dic.find(identifier) == std::end(dic))
+            if (streams.size() == 1 && streams.front()->hasStreamDescriptor() == false)
+            {
+                auto parameter = streams.front();
+                if (parameter->isSubscribed() && parameter->isDirty())
                 {
-                    dic[identifier] = std::unique_ptr<ParameterCollection>(new ParameterCollection());
+                    auto entry = SingleStreamEntryFactory::create(parameter);
+                    root->insert(entry);
                 }
-
-                dic[identifier]->push_back(parameter);
             }
-        }
-
-        {
-            for(auto& pair : dic)
+            else if (group.size() > 0)
             {
-                auto& streams = *pair.second;
-                auto const identifier = pair.first;
-                auto const size = streams.size();
-
-                if (size == 1 && streams.front()->hasStreamDescriptor() == false)
-                {
-                    auto parameter = streams.front();
-                    if (parameter->isSubscribed() && parameter->isDirty())
-                    {
-                        auto entry = SingleStreamEntryFactory::create(parameter);
-                        root->insert(entry);
-                    }
-                }
-                else if (size >= 1)
+                auto const first = std::begin(streams);
+                auto const last = std::end(streams);
+                auto const isSubscribed = std::any_of(first, last, [](decltype(*first) stream) -> bool
                 {
-                    auto const first = std::begin(streams);
-                    auto const last = std::end(streams);
-                    auto const result = std::max_element(first, last, [](decltype(*first) max, decltype(*first) cur) -> bool
-                    {
-                        if (max->hasStreamDescriptor() && cur->hasStreamDescriptor())
-                        {
-                            return cur->streamDescriptor()->offset() > max->streamDescriptor()->offset();
-                        }
-                        else if (max->hasStreamDescriptor())
-                        {
-                            return false;
-                        }
-                        else if (cur->hasStreamDescriptor())
-                        {
-                            return true;
-                        }
+                    return stream->isSubscribed() && stream->isDirty();
+                });
 
-                        return false;
-                    });
-
-                    auto const isSubscribed = std::any_of(first, last, [](decltype(*first) stream) -> bool
-                    {
-                        return stream->isSubscribed() && stream->isDirty();
-                    });
-
-                    if (result != last && isSubscribed)
-                    {
-                        auto descriptor = (*result)->streamDescriptor();
-                        auto const format = descriptor->format();
-                        auto const offset = descriptor->offset();
-                        auto const size = offset + format.size();
+                if (isSubscribed)
+                {
+                    // All parameters are re-encoded, since the dirty state of a stream parameter
+                    // may also be reset when a consumer reports its value.
+                    auto const& buffer = group.buffer();
+                    encode(group);
 
-                        auto buffer = std::vector<unsigned char>(size, 0x00);
-                        for(auto parameter : streams)
-                        {
-                            encode(parameter, std::begin(buffer), std::end(buffer));
-                            parameter->clearDirtyState();
-                        }
+                    for(auto parameter : streams)
+                        parameter->clearDirtyState();
 
-                        root->insert(identifier, std::begin(buffer), std::end(buffer));
-                    }
+                    root->insert(identifier, std::begin(buffer), std::end(buffer));
                 }
             }
         }
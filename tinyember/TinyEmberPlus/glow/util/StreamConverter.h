@@ -13,6 +13,7 @@
 #include "../../gadget/EnumParameter.h"
 #include "../../gadget/IntegerParameter.h"
 #include "../../gadget/RealParameter.h"
+#include "../../gadget/StreamManager.h"
 
 /** Forward declarations */
 namespace libember { namespace glow
@@ -24,7 +25,6 @@ namespace libember { namespace glow
 
 namespace gadget
 {
-    class StreamManager;
     class Parameter;
 }
 
@@ -44,7 +44,25 @@ namespace glow { namespace util
              */
             static libember::glow::GlowStreamCollection* create(libember::glow::GlowStreamCollection* root, gadget::StreamManager const& manager);
 
+            /**
+             * Encodes the values of all parameters of a stream group into the buffer of the group.
+             * Each parameter is written at the offset of its stream descriptor, parameters without
+             * a descriptor are skipped.
+             * @param group The stream group to encode.
+             */
+            static void encode(gadget::StreamManager::StreamGroup const& group);
+
         private:
+            /**
+             * Writes the lower bytes of a value in the byte order of the passed format. The number
+             * of bytes written is determined by the size of the format.
+             * @param bits The bit pattern to write.
+             * @param format The stream format that determines the size and byte order.
+             * @param first Reference to the first element of the output buffer, where the encoded data shall be written to.
+             */
+            template<typename OutputIterator>
+            static void store(unsigned long long bits, gadget::StreamFormat const& format, OutputIterator first);
+
             /**
              * Encodes an integral stream value and appends it to the specified output stream.
              * @param value The value to encode.
@@ -150,6 +168,16 @@ namespace glow { namespace util
                      */
                     static void encode(gadget::Parameter* parameter, OutputIterator first, OutputIterator last);
 
+                    /**
+                     * Encodes the values of all passed parameters into the provided output stream.
+                     * @param parameters Reference to the first parameter whos stream value shall be added to the output stream.
+                     * @param end Reference to the first parameter one past the range of parameters to encode.
+                     * @param first Reference to the first element of the output buffer, where the encoded data shall be written to.
+                     * @param last Reference to the first element one past the valid output buffer range.
+                     */
+                    template<typename InputIterator>
+                    static void encode(InputIterator parameters, InputIterator end, OutputIterator first, OutputIterator last);
+
                 public:
                     /**
                      * Encodes and appends the currently selected index.
@@ -183,13 +211,12 @@ namespace glow { namespace util
 
                 private:
                     /**
-                     * Initializes a new OctetStreamEncoder instance which appends the value of the passed
-                     * parameter to the provided output stream.
-                     * @param parameter The parameter whos value shall be added to the output stream.
+                     * Initializes a new OctetStreamEncoder instance which writes parameter values
+                     * to the provided output stream.
                      * @param first Reference to the first element of the output buffer, where the encoded data shall be written to.
                      * @param last Reference to the first element one past the valid output buffer range.
                      */
-                    explicit OctetStreamEntryEncoder(gadget::Parameter* parameter, OutputIterator first, OutputIterator last);
+                    OctetStreamEntryEncoder(OutputIterator first, OutputIterator last);
 
                 private:
                     OutputIterator m_first;
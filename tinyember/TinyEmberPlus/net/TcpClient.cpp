@@ -4,25 +4,208 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <QtCore/qcoreapplication.h>
 #include "TcpClient.h"
 
 namespace net
 {
+    TcpClient::DrainEvent::DrainEvent()
+        : QEvent(eventType())
+    {}
+
+    //static
+    QEvent::Type TcpClient::DrainEvent::eventType()
+    {
+        static auto const type = static_cast<QEvent::Type>(QEvent::registerEventType());
+        return type;
+    }
+
     TcpClient::TcpClient(QTcpSocket* socket)
-        : m_socket(socket)
+        : m_receiveBuffer(DefaultReceiveBufferSize)
+        , m_socket(socket)
+        , m_isDrainRequested(0)
+        , m_queuedStreamFrame(std::end(m_queue))
+        , m_isOverflowed(false)
     {
+        std::memset(&m_metrics, 0, sizeof(m_metrics));
+        std::memset(&m_receiveMetrics, 0, sizeof(m_receiveMetrics));
+
         m_socket->connect(m_socket, SIGNAL(disconnected()), this, SLOT(onDisconnect()));
         m_socket->connect(m_socket, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+        m_socket->connect(m_socket, SIGNAL(bytesWritten(qint64)), this, SLOT(onBytesWritten(qint64)));
     }
 
     TcpClient::~TcpClient()
     {
         m_socket->disconnect(m_socket, SIGNAL(disconnected()), this, SLOT(onDisconnect()));
         m_socket->disconnect(m_socket, SIGNAL(readyRead()), this, SLOT(onReadyRead()));
+        m_socket->disconnect(m_socket, SIGNAL(bytesWritten(qint64)), this, SLOT(onBytesWritten(qint64)));
         m_socket->close();
         m_socket = nullptr;
     }
 
+    void TcpClient::write(QByteArray const& array, MessageType::_Domain type, MessageKey const& key)
+    {
+        if (array.isEmpty())
+            return;
+
+        {
+            QMutexLocker const lock(&m_queueMutex);
+            if (m_isOverflowed)
+                return;
+
+            if (removeSuperseded(type, key))
+            {
+                if (type == MessageType::Stream)
+                    ++m_metrics.droppedStreamFrames;
+                else
+                    ++m_metrics.coalescedUpdates;
+            }
+
+            auto message = Message();
+            message.array = array;
+            message.type = type;
+            message.key = key;
+            enqueue(message);
+            m_metrics.queuedBytes += static_cast<size_type>(array.size());
+            m_metrics.peakQueuedBytes = std::max(m_metrics.peakQueuedBytes, m_metrics.queuedBytes);
+
+            // The consumer doesn't read its data, so it is disconnected before it
+            // consumes an unbounded amount of memory.
+            if (m_metrics.queuedBytes > MaxQueuedBytes)
+            {
+                m_isOverflowed = true;
+                m_queue.clear();
+                m_queuedUpdates.clear();
+                m_queuedStreamFrame = std::end(m_queue);
+                m_metrics.queuedBytes = 0;
+            }
+        }
+
+        // The socket may only be accessed by its own thread, and writing to it directly
+        // could emit a disconnect while the server iterates its clients.
+        if (m_isDrainRequested.testAndSetOrdered(0, 1))
+            QCoreApplication::postEvent(this, new DrainEvent());
+    }
+
+    TcpClient::QueueMetrics TcpClient::metrics() const
+    {
+        QMutexLocker const lock(&m_queueMutex);
+        auto result = m_metrics;
+        result.queuedMessages = m_queue.size();
+        return result;
+    }
+
+    TcpClient::ReceiveMetrics TcpClient::receiveMetrics() const
+    {
+        QMutexLocker const lock(&m_queueMutex);
+        return m_receiveMetrics;
+    }
+
+    TcpClient::size_type TcpClient::receiveBufferSize() const
+    {
+        return m_receiveBuffer.size();
+    }
+
+    void TcpClient::setReceiveBufferSize(size_type value)
+    {
+        if (value > 0)
+            m_receiveBuffer.resize(value);
+    }
+
+    void TcpClient::customEvent(QEvent* event)
+    {
+        if (event->type() == DrainEvent::eventType())
+            drain();
+    }
+
+    bool TcpClient::removeSuperseded(MessageType::_Domain type, MessageKey const& key)
+    {
+        auto superseded = std::end(m_queue);
+        if (type == MessageType::Stream)
+        {
+            superseded = m_queuedStreamFrame;
+            m_queuedStreamFrame = std::end(m_queue);
+        }
+        else if (type == MessageType::Update && key.object != nullptr)
+        {
+            auto const where = m_queuedUpdates.find(key);
+            if (where != std::end(m_queuedUpdates))
+            {
+                superseded = where->second;
+                m_queuedUpdates.erase(where);
+            }
+        }
+
+        if (superseded == std::end(m_queue))
+            return false;
+
+        // The superseded message is removed instead of being replaced, so that the new
+        // message keeps its position relative to the responses queued in between.
+        m_metrics.queuedBytes -= static_cast<size_type>(superseded->array.size());
+        m_queue.erase(superseded);
+        return true;
+    }
+
+    void TcpClient::enqueue(Message const& message)
+    {
+        auto const where = m_queue.insert(std::end(m_queue), message);
+        if (message.type == MessageType::Stream)
+            m_queuedStreamFrame = where;
+        else if (message.type == MessageType::Update && message.key.object != nullptr)
+            m_queuedUpdates[message.key] = where;
+    }
+
+    void TcpClient::dequeue()
+    {
+        auto const first = std::begin(m_queue);
+        if (first == m_queuedStreamFrame)
+            m_queuedStreamFrame = std::end(m_queue);
+        else if (first->type == MessageType::Update && first->key.object != nullptr)
+            m_queuedUpdates.erase(first->key);
+
+        m_queue.pop_front();
+    }
+
+    void TcpClient::drain()
+    {
+        m_isDrainRequested.storeRelease(0);
+
+        auto socket = m_socket;
+        if (socket == nullptr)
+            return;
+
+        auto isOverflowed = false;
+        auto messages = std::vector<QByteArray>();
+        {
+            QMutexLocker const lock(&m_queueMutex);
+            auto buffered = socket->bytesToWrite();
+            while(m_queue.empty() == false && buffered < SocketBufferSize)
+            {
+                auto const& array = m_queue.front().array;
+                buffered += array.size();
+                m_metrics.queuedBytes -= static_cast<size_type>(array.size());
+                messages.push_back(array);
+                dequeue();
+            }
+
+            isOverflowed = m_isOverflowed;
+        }
+
+        if (isOverflowed)
+        {
+            socket->abort();
+        }
+        else
+        {
+            for(auto const& array : messages)
+                socket->write(array);
+        }
+    }
+
     void TcpClient::onDisconnect()
     {
         emit disconnected(this);
@@ -33,11 +216,32 @@ namespace net
         auto socket = m_socket;
         if (socket != nullptr)
         {
+            auto const buffer = m_receiveBuffer.data();
+            auto const capacity = static_cast<qint64>(m_receiveBuffer.size());
+            auto receivedBytes = size_type(0);
+            auto reads = size_type(0);
+
             while(socket->bytesAvailable() > 0)
             {
-                auto const size = socket->read(reinterpret_cast<char*>(m_buffer), RxBufferSize);
-                read(m_buffer, m_buffer + size, size);
+                auto const size = socket->read(reinterpret_cast<char*>(buffer), capacity);
+                if (size <= 0)
+                    break;
+
+                receivedBytes += static_cast<size_type>(size);
+                ++reads;
+                read(buffer, buffer + size, static_cast<size_type>(size));
             }
+
+            // The counters are updated once per notification, so the lock is not
+            // taken for each read.
+            QMutexLocker const lock(&m_queueMutex);
+            m_receiveMetrics.receivedBytes += receivedBytes;
+            m_receiveMetrics.reads += reads;
         }
     }
+
+    void TcpClient::onBytesWritten(qint64)
+    {
+        drain();
+    }
 }
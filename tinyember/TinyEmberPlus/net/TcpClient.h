@@ -7,7 +7,13 @@
 #ifndef __TINYEMBER_NET_TCPCLIENT_H
 #define __TINYEMBER_NET_TCPCLIENT_H
 
+#include <list>
+#include <unordered_map>
+#include <vector>
 #include <QTcpSocket>
+#include <QtCore/qatomic.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qmutex.h>
 
 namespace net
 {
@@ -16,6 +22,12 @@ namespace net
 
     /**
      * Base class for a tcp/ip client.
+     * Outgoing messages are not written to the socket directly. Instead, they are appended
+     * to a bounded queue, which is drained by the thread owning the socket whenever the
+     * socket's own buffer runs low. A consumer that doesn't read its data fast enough
+     * therefore only affects its own queue, which is kept small by the policy of each
+     * message type. When the queue exceeds MaxQueuedBytes nevertheless, the client is
+     * disconnected.
      */
     class TcpClient : public QObject
     {
@@ -25,6 +37,99 @@ namespace net
             typedef value_type const* const_iterator;
             typedef std::size_t size_type;
 
+            /**
+             * Scoped enumeration containing the message types, which define how a message
+             * is queued when the client cannot keep up.
+             */
+            struct MessageType
+            {
+                enum _Domain
+                {
+                    /** Responses and control messages, which are never dropped. */
+                    Control,
+
+                    /**
+                     * Parameter notifications. An update replaces a queued update with the
+                     * same key, since it carries the same properties of the same object.
+                     */
+                    Update,
+
+                    /** Stream frames. A new frame replaces a queued frame, which is stale. */
+                    Stream,
+                };
+            };
+
+            /**
+             * Identifies update messages that supersede each other. A key is only valid
+             * if an object has been assigned.
+             */
+            struct MessageKey
+            {
+                /** Initializes an invalid key. */
+                MessageKey()
+                    : object(nullptr)
+                    , properties(0)
+                {}
+
+                /**
+                 * Initializes a new MessageKey.
+                 * @param object The object the message refers to.
+                 * @param properties The set of properties contained in the message.
+                 */
+                MessageKey(void const* object, std::size_t properties)
+                    : object(object)
+                    , properties(properties)
+                {}
+
+                /**
+                 * Tests whether two keys identify the same object and properties.
+                 * @param other The key to compare to.
+                 * @return true if both keys are equal.
+                 */
+                bool operator==(MessageKey const& other) const
+                {
+                    return object == other.object && properties == other.properties;
+                }
+
+                void const* object;
+                std::size_t properties;
+            };
+
+            /**
+             * Contains the current state of the outbound queue and the number of messages
+             * that have been dropped due to the queue policies.
+             */
+            struct QueueMetrics
+            {
+                size_type queuedMessages;
+                size_type queuedBytes;
+                size_type peakQueuedBytes;
+                size_type droppedStreamFrames;
+                size_type coalescedUpdates;
+            };
+
+            /**
+             * Counts the data received from the connected client. The counters replace
+             * logging each read, which is too expensive on busy links.
+             */
+            struct ReceiveMetrics
+            {
+                size_type receivedBytes;
+                size_type reads;
+            };
+
+            enum
+            {
+                /** The default size of the buffer the socket is read into. */
+                DefaultReceiveBufferSize = 64 * 1024,
+
+                /** The maximum number of bytes a queue may contain before the client is disconnected. */
+                MaxQueuedBytes = 16 * 1024 * 1024,
+
+                /** The queue is drained until the socket buffers this number of bytes. */
+                SocketBufferSize = 64 * 1024,
+            };
+
             /** Destructor */
             virtual ~TcpClient();
 
@@ -37,10 +142,42 @@ namespace net
             void write(InputIterator first, InputIterator last);
 
             /**
-             * Sends the passed byte array to the connected client.
+             * Appends the passed byte array to the outbound queue of this client.
+             * This method may be called from any thread. The queue is drained by the
+             * thread owning the socket. Since the array is implicitly shared, a message
+             * that is sent to several clients is only stored once.
              * @param array The array to transmit.
+             * @param type The type of the message, which defines its queue policy.
+             * @param key Identifies update messages which supersede each other.
+             */
+            void write(QByteArray const& array, MessageType::_Domain type = MessageType::Control, MessageKey const& key = MessageKey());
+
+            /**
+             * Returns the current metrics of the outbound queue.
+             * @return The current metrics of the outbound queue.
+             */
+            QueueMetrics metrics() const;
+
+            /**
+             * Returns the counters of the data received from the connected client.
+             * This method may be called from any thread.
+             * @return The counters of the received data.
+             */
+            ReceiveMetrics receiveMetrics() const;
+
+            /**
+             * Returns the size of the buffer the socket is read into.
+             * @return The size of the receive buffer in bytes.
+             */
+            size_type receiveBufferSize() const;
+
+            /**
+             * Changes the size of the buffer the socket is read into, which limits
+             * the number of bytes passed to a single read call. Must be called by
+             * the thread owning the socket.
+             * @param value The new size in bytes, must not be zero.
              */
-            void write(QByteArray const& array);
+            void setReceiveBufferSize(size_type value);
 
         signals:
             /**
@@ -64,6 +201,12 @@ namespace net
              */
             virtual void read(const_iterator first, const_iterator last, size_type size) = 0;
 
+            /**
+             * Handles the drain requests posted by write.
+             * @param event The event to handle.
+             */
+            virtual void customEvent(QEvent* event);
+
         private slots:
             /**
              * Handles a socket disconnect event.
@@ -76,11 +219,93 @@ namespace net
              */
             void onReadyRead();
 
+            /**
+             * Continues draining the queue when the socket has transmitted data.
+             */
+            void onBytesWritten(qint64);
+
         private:
-            enum { RxBufferSize = 4096, };
+            /**
+             * This event is posted to the thread owning the socket when the queue
+             * contains new messages.
+             */
+            class DrainEvent : public QEvent
+            {
+                public:
+                    /** Initializes a new DrainEvent. */
+                    DrainEvent();
+
+                    /**
+                     * Returns the event type registered for DrainEvent objects.
+                     * @return The event type registered for DrainEvent objects.
+                     */
+                    static QEvent::Type eventType();
+            };
+
+            /**
+             * An entry of the outbound queue.
+             */
+            struct Message
+            {
+                QByteArray array;
+                MessageType::_Domain type;
+                MessageKey key;
+            };
+
+            /**
+             * Computes the hash value of a message key.
+             */
+            struct MessageKeyHash
+            {
+                std::size_t operator()(MessageKey const& key) const
+                {
+                    return std::hash<void const*>()(key.object) ^ (std::hash<std::size_t>()(key.properties) * 31);
+                }
+            };
+
+            typedef std::list<Message> MessageQueue;
+            typedef std::unordered_map<MessageKey, MessageQueue::iterator, MessageKeyHash> MessageIndex;
 
-            value_type m_buffer[RxBufferSize];
+            /**
+             * Removes the queued message that is superseded by a new message of the
+             * passed type and key. The message is looked up in the index, so the queue
+             * is not searched. Must be called while the queue is locked.
+             * @param type The type of the new message.
+             * @param key The key of the new message.
+             * @return true if a message has been removed.
+             */
+            bool removeSuperseded(MessageType::_Domain type, MessageKey const& key);
+
+            /**
+             * Appends a message to the queue and to the index, if it may be superseded.
+             * Must be called while the queue is locked.
+             * @param message The message to append.
+             */
+            void enqueue(Message const& message);
+
+            /**
+             * Removes the first message from the queue and from the index.
+             * Must be called while the queue is locked.
+             */
+            void dequeue();
+
+            /**
+             * Moves queued messages to the socket until its buffer is full. If the
+             * queue has overflowed, the connection is aborted instead.
+             */
+            void drain();
+
+        private:
+            std::vector<value_type> m_receiveBuffer;
             QTcpSocket* m_socket;
+            mutable QMutex m_queueMutex;
+            QAtomicInt m_isDrainRequested;
+            MessageQueue m_queue;
+            MessageIndex m_queuedUpdates;
+            MessageQueue::iterator m_queuedStreamFrame;
+            QueueMetrics m_metrics;
+            ReceiveMetrics m_receiveMetrics;
+            bool m_isOverflowed;
     };
 
     /**************************************************************************
@@ -94,13 +319,6 @@ namespace net
         std::copy(first, last, std::back_inserter(array));
         write(array);
     }
-
-    inline void TcpClient::write(QByteArray const& array)
-    {
-        auto socket = m_socket;
-        if (socket != nullptr)
-            socket->write(array);
-    }
 }
 
 #endif//__TINYEMBER_NET_TCPCLIENT_H
@@ -15,7 +15,6 @@ namespace net
     TcpServer::TcpServer(QApplication* app, TcpClientFactory* factory, short port)
         : QTcpServer(app)
         , m_factory(factory)
-        , m_mutex(QMutex::Recursive)
         , m_port(port)
     {
         connect(this, SIGNAL(newConnection()), this, SLOT(clientAccepted()));
@@ -26,7 +25,7 @@ namespace net
     {
         auto clients = ClientCollection();
         {
-            QMutexLocker const lock(&m_mutex);
+            QWriteLocker const lock(&m_lock);
             std::copy(m_clients.begin(), m_clients.end(), std::back_inserter(clients));
             m_clients.clear();
         }
@@ -38,14 +37,42 @@ namespace net
         }
     }
 
-    void TcpServer::write(QByteArray const& array)
+    void TcpServer::write(QByteArray const& array, TcpClient::MessageType::_Domain type, TcpClient::MessageKey const& key)
     {
-        QMutexLocker const lock(&m_mutex);
+        // Writing only appends the array to the client queues, so the stream thread
+        // and the ui thread may distribute their messages concurrently.
+        QReadLocker const lock(&m_lock);
         for(auto client : m_clients)
         {
-            client->write(array);
+            client->write(array, type, key);
         }
     }
+
+    std::vector<TcpClient::QueueMetrics> TcpServer::metrics() const
+    {
+        auto result = std::vector<TcpClient::QueueMetrics>();
+        QReadLocker const lock(&m_lock);
+        result.reserve(m_clients.size());
+        for(auto client : m_clients)
+        {
+            result.push_back(client->metrics());
+        }
+
+        return result;
+    }
+
+    std::vector<TcpClient::ReceiveMetrics> TcpServer::receiveMetrics() const
+    {
+        auto result = std::vector<TcpClient::ReceiveMetrics>();
+        QReadLocker const lock(&m_lock);
+        result.reserve(m_clients.size());
+        for(auto client : m_clients)
+        {
+            result.push_back(client->receiveMetrics());
+        }
+
+        return result;
+    }
      
     void TcpServer::clientAccepted()
     {
@@ -55,7 +82,7 @@ namespace net
             auto const client = m_factory->create(socket);
             connect(client, SIGNAL(disconnected(TcpClient*)), this, SLOT(clientDisconnected(TcpClient*)));
             {
-                QMutexLocker const lock(&m_mutex);
+                QWriteLocker const lock(&m_lock);
                 m_clients.push_back(client);
             }
         }
@@ -65,7 +92,7 @@ namespace net
     {
         disconnect(client, SIGNAL(disconnected(TcpClient*)), this, SLOT(clientDisconnected(TcpClient*)));
         {
-            QMutexLocker const lock(&m_mutex);
+            QWriteLocker const lock(&m_lock);
             auto const first = m_clients.begin();
             auto const last = m_clients.end();
             auto const result = std::find(first, last, client);
@@ -74,7 +101,9 @@ namespace net
                 m_clients.erase(result);
             }
 
-            delete client;
+            // A client may abort its own connection while it drains its queue, so it
+            // must not be deleted before it has returned to the event loop.
+            client->deleteLater();
         }
     }
 }
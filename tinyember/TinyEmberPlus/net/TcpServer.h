@@ -10,12 +10,12 @@
 #include <vector>
 #include <QTcpServer>
 #include <QApplication>
-#include <qmutex.h>
+#include <qreadwritelock.h>
 #include <qthread.h>
+#include "TcpClient.h"
 
 namespace net
 {
-    class TcpClient;
     class TcpClientFactory;
 
     /**
@@ -42,10 +42,25 @@ namespace net
             int port() const;
 
             /**
-             * Sends the passed data to all currently connected clients.
+             * Sends the passed data to all currently connected clients. The array is appended
+             * to the outbound queue of each client, so all clients share the same buffer.
              * @param array The array to transmit.
+             * @param type The type of the message, which defines its queue policy.
+             * @param key Identifies update messages which supersede each other.
              */
-            void write(QByteArray const& array);
+            void write(QByteArray const& array, TcpClient::MessageType::_Domain type = TcpClient::MessageType::Control, TcpClient::MessageKey const& key = TcpClient::MessageKey());
+
+            /**
+             * Returns the queue metrics of all currently connected clients.
+             * @return The queue metrics of all currently connected clients.
+             */
+            std::vector<TcpClient::QueueMetrics> metrics() const;
+
+            /**
+             * Returns the counters of the data received from all currently connected clients.
+             * @return The receive counters of all currently connected clients.
+             */
+            std::vector<TcpClient::ReceiveMetrics> receiveMetrics() const;
 
             /**
              * Sends the buffer defined by the iterators to all connected clients.
@@ -71,7 +86,7 @@ namespace net
             typedef std::vector<TcpClient*> ClientCollection;
             ClientCollection m_clients;
             TcpClientFactory *const m_factory;
-            QMutex m_mutex;
+            mutable QReadWriteLock m_lock;
             int m_port;
     };
 
@@ -10,21 +10,36 @@
 #include "Archive.h"
 #include "detail/GadgetTreeReader.h"
 #include "detail/GadgetTreeWriter.h"
+#include "detail/SnapshotReader.h"
+#include "detail/SnapshotWriter.h"
 
 namespace serialization
 {
+    String const Archive::SnapshotExtension = ".EmBERSnapshot";
+
     void Archive::serialize(gadget::Node const* root, String const& filename) const
     {
-        auto const writer = detail::GadgetTreeWriter(root);
-        auto& berstream = writer.m_stream;
+        auto const name = QString::fromStdString(filename);
+        auto const isSnapshot = name.endsWith(QString::fromStdString(SnapshotExtension), Qt::CaseInsensitive);
 
-        QFile file(QString::fromStdString(filename));
+        QFile file(name);
         if (file.open(QIODevice::WriteOnly))
         {
-            std::for_each(std::begin(berstream), std::end(berstream), [&file](unsigned char byte)
+            if (isSnapshot)
+            {
+                auto const writer = detail::SnapshotWriter(root);
+                file.write(writer.data(), writer.size());
+            }
+            else
             {
-                file.putChar(byte);
-            });
+                auto const writer = detail::GadgetTreeWriter(root);
+                auto& berstream = writer.m_stream;
+                auto buffer = QByteArray();
+
+                buffer.reserve(static_cast<int>(berstream.size()));
+                std::copy(std::begin(berstream), std::end(berstream), std::back_inserter(buffer));
+                file.write(buffer);
+            }
 
             file.flush();
             file.close();
@@ -39,12 +54,33 @@ namespace serialization
             QFile file(QString::fromStdString(filename));
             if (file.open(QIODevice::ReadOnly))
             {
-                auto bytearray = file.readAll();
-                auto stream = libember::util::OctetStream(0);
-                stream.append(bytearray.begin(), bytearray.end());
+                // Snapshots are read directly from the mapped file. If the file cannot be
+                // mapped, its content is read into memory instead.
+                auto const size = static_cast<std::size_t>(file.size());
+                auto const mapped = size > 0 ? file.map(0, file.size()) : nullptr;
+                auto bytearray = QByteArray();
+                if (mapped == nullptr)
+                    bytearray = file.readAll();
+
+                auto const data = mapped != nullptr ? reinterpret_cast<char const*>(mapped) : bytearray.constData();
+                auto const length = mapped != nullptr ? size : static_cast<std::size_t>(bytearray.size());
+                if (detail::SnapshotReader::isSnapshot(data, length))
+                {
+                    auto reader = detail::SnapshotReader(data, length);
+                    result = reader.m_root;
+                }
+                else
+                {
+                    auto stream = libember::util::OctetStream(0);
+                    stream.append(data, data + length);
+
+                    auto reader = detail::GadgetTreeReader(stream);
+                    result = reader.m_root;
+                }
+
+                if (mapped != nullptr)
+                    file.unmap(mapped);
 
-                auto reader = detail::GadgetTreeReader(stream);
-                result = reader.m_root;
                 file.close();
             }
         }
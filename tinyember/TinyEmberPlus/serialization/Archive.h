@@ -18,22 +18,27 @@ namespace gadget
 namespace serialization
 {
     /**
-     * The Archive provides method to store a gadget tree to a file or load it. The trees
-     * are converted into their glow representation and are then ber encoded and written
-     * to disk.
+     * The Archive provides method to store a gadget tree to a file or load it. By default,
+     * the trees are converted into their glow representation and are then ber encoded and
+     * written to disk. Files with the snapshot extension use a binary snapshot format
+     * instead, which can be loaded without decoding an intermediate glow tree.
      */
     class Archive
     {
         public:
+            /** The file extension which selects the snapshot format, including the dot. */
+            static String const SnapshotExtension;
+
             /**
-             * Writes the gadget tree to a file.
+             * Writes the gadget tree to a file. If the filename ends with the snapshot extension,
+             * the tree is stored in the snapshot format.
              * @param root The root node to serialize.
              * @param filename The name of the file where the encoded data will be written.
              */
             void serialize(gadget::Node const* root, String const& filename) const;
 
             /**
-             * Loads a gadget tree from a file.
+             * Loads a gadget tree from a file. The format of the file is detected from its content.
              * @param filename The name of the file containing the data.
              * @return The deserialized gadget tree.
              */
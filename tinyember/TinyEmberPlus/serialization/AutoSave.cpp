@@ -0,0 +1,276 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+#include "../gadget/Parameter.h"
+#include "../gadget/StreamManager.h"
+#include "detail/ChangeLogReader.h"
+#include "detail/ChangeLogWriter.h"
+#include "detail/SnapshotWriter.h"
+#include "Archive.h"
+#include "AutoSave.h"
+
+namespace serialization
+{
+    namespace
+    {
+        /** The node properties that are stored in the change log. */
+        gadget::NodeFieldState const PersistentNodeFields = gadget::NodeFieldState(
+            gadget::NodeField::Description | gadget::NodeField::Schema);
+
+        /** The parameter properties that are stored in the change log. */
+        gadget::ParameterFieldState const PersistentParameterFields = gadget::ParameterFieldState(
+            gadget::ParameterField::Description | gadget::ParameterField::Schema | gadget::ParameterField::Access |
+            gadget::ParameterField::ValueMin | gadget::ParameterField::ValueMax | gadget::ParameterField::ValueEnumeration |
+            gadget::ParameterField::Value | gadget::ParameterField::ValueFormula |
+            gadget::ParameterField::StreamIdentifier | gadget::ParameterField::StreamDescriptor);
+
+        /**
+         * Returns the properties of a parameter that have to be stored in the change log.
+         * The values of stream parameters are not logged, because they usually change with
+         * every stream tick. They are persisted with the next snapshot.
+         */
+        gadget::ParameterFieldState persistentState(gadget::Parameter const* parameter)
+        {
+            auto const& manager = gadget::StreamManager::instance();
+            auto state = parameter->dirtyState().mask(PersistentParameterFields);
+            if (manager.isParameterTransmittedViaStream(parameter))
+                state = state.mask(~gadget::ParameterField::Value);
+
+            return state;
+        }
+    }
+
+    //static
+    std::size_t const AutoSave::CompactionThreshold = 4 * 1024 * 1024;
+
+    AutoSave::FlushEvent::FlushEvent()
+        : QEvent(eventType())
+    {}
+
+    //static
+    QEvent::Type AutoSave::FlushEvent::eventType()
+    {
+        static auto const type = static_cast<QEvent::Type>(QEvent::registerEventType());
+        return type;
+    }
+
+
+    AutoSave::AutoSave()
+        : m_isFlushRequested(0)
+        , m_logSize(0)
+        , m_hasPendingSnapshot(false)
+    {
+        moveToThread(&m_thread);
+    }
+
+    AutoSave::~AutoSave()
+    {
+        if (m_thread.isRunning())
+        {
+            m_thread.quit();
+            m_thread.wait();
+        }
+
+        // The writer thread has stopped, so the remaining changes are written by the
+        // current thread.
+        flush();
+    }
+
+    void AutoSave::reset(gadget::Node const* root, String const& filename)
+    {
+        {
+            QMutexLocker const lock(&m_mutex);
+            m_filename = filename;
+            m_pendingFilename = filename;
+            m_pendingSnapshot.clear();
+            m_pendingChanges.clear();
+            m_hasPendingSnapshot = true;
+
+            if (root != nullptr && filename.empty() == false)
+                setPendingSnapshot(root);
+            else
+                m_filename.clear();
+        }
+
+        requestFlush();
+    }
+
+    gadget::Node* AutoSave::restore(String const& filename)
+    {
+        flush();
+
+        QMutexLocker const lock(&m_fileMutex);
+        auto const root = Archive().deserialize(filename);
+        if (root != nullptr)
+        {
+            QFile file(QString::fromStdString(filename));
+            QFile log(logFilename(filename));
+            if (file.open(QIODevice::ReadOnly) && log.open(QIODevice::ReadOnly))
+            {
+                auto const snapshot = file.readAll();
+                auto const checksum = detail::changelog::checksum(snapshot.constData(), static_cast<std::size_t>(snapshot.size()));
+                auto const data = log.readAll();
+                auto reader = detail::ChangeLogReader(root, checksum);
+                reader.apply(data.constData(), static_cast<std::size_t>(data.size()));
+            }
+        }
+
+        return root;
+    }
+
+    //static
+    QDateTime AutoSave::lastModified(String const& filename)
+    {
+        auto const snapshot = QFileInfo(QString::fromStdString(filename));
+        auto const log = QFileInfo(logFilename(filename));
+        if (snapshot.exists() == false)
+            return QDateTime();
+
+        return log.exists() && log.lastModified() > snapshot.lastModified()
+            ? log.lastModified()
+            : snapshot.lastModified();
+    }
+
+    void AutoSave::notifyStateChanged(gadget::NodeFieldState const&, gadget::Node const* object)
+    {
+        auto isFlushRequired = false;
+        if (object != nullptr && object->parent() == nullptr)
+        {
+            QMutexLocker const lock(&m_mutex);
+            if (m_filename.empty() == false)
+            {
+                auto const size = m_pendingChanges.size();
+                auto writer = detail::ChangeLogWriter(m_pendingChanges);
+                for(auto node : object->dirtyNodes())
+                {
+                    if (node->dirtyState().mask(PersistentNodeFields).isDirty())
+                        writer.write(node);
+                }
+
+                for(auto parameter : object->dirtyParameters())
+                {
+                    if (persistentState(parameter).isDirty())
+                        writer.write(parameter);
+                }
+
+                m_logSize += m_pendingChanges.size() - size;
+                isFlushRequired = m_pendingChanges.size() > size;
+
+                // The snapshot already contains all changes, so the log is truncated
+                // when the snapshot is written. The snapshot is encoded on this thread,
+                // which takes time proportional to the size of the tree.
+                if (m_logSize > CompactionThreshold)
+                    setPendingSnapshot(object);
+            }
+        }
+
+        if (isFlushRequired)
+            requestFlush();
+    }
+
+    void AutoSave::customEvent(QEvent* event)
+    {
+        if (event->type() == FlushEvent::eventType())
+            flush();
+    }
+
+    //static
+    QString AutoSave::logFilename(String const& filename)
+    {
+        return QString::fromStdString(filename) + ".log";
+    }
+
+    void AutoSave::setPendingSnapshot(gadget::Node const* root)
+    {
+        // The tree is encoded on the calling thread, because neither the tree nor the
+        // stream manager may be accessed by the writer thread.
+        auto const snapshot = detail::SnapshotWriter(root);
+        m_pendingSnapshot.assign(snapshot.data(), snapshot.data() + snapshot.size());
+        m_pendingFilename = m_filename;
+        m_hasPendingSnapshot = true;
+
+        m_pendingChanges.clear();
+        auto writer = detail::ChangeLogWriter(m_pendingChanges);
+        writer.writeHeader(detail::changelog::checksum(snapshot.data(), snapshot.size()));
+        m_logSize = m_pendingChanges.size();
+    }
+
+    void AutoSave::requestFlush()
+    {
+        if (m_thread.isRunning() == false)
+            m_thread.start(QThread::LowPriority);
+
+        if (m_isFlushRequested.testAndSetOrdered(0, 1))
+            QCoreApplication::postEvent(this, new FlushEvent());
+    }
+
+    void AutoSave::flush()
+    {
+        QMutexLocker const fileLock(&m_fileMutex);
+        auto hasSnapshot = false;
+        auto filename = String();
+        auto snapshot = Buffer();
+        auto changes = Buffer();
+        {
+            QMutexLocker const lock(&m_mutex);
+            std::swap(hasSnapshot, m_hasPendingSnapshot);
+            std::swap(snapshot, m_pendingSnapshot);
+            std::swap(changes, m_pendingChanges);
+            filename = m_pendingFilename;
+            m_isFlushRequested.storeRelease(0);
+        }
+
+        if (hasSnapshot)
+        {
+            m_log.close();
+
+            if (filename.empty() == false && snapshot.empty() == false)
+            {
+                // QSaveFile writes the snapshot to a temporary file and atomically
+                // replaces the previous snapshot on commit, so that a complete snapshot
+                // exists at any time. If the application stops before the log has been
+                // truncated, the old log remains next to the new snapshot. Its header
+                // names the previous snapshot, so it is ignored by restore; the new
+                // snapshot already contains all of its changes.
+                QSaveFile file(QString::fromStdString(filename));
+                auto const size = static_cast<qint64>(snapshot.size());
+                auto const isWritten = file.open(QIODevice::WriteOnly)
+                    && file.write(snapshot.data(), size) == size
+                    && file.commit();
+
+                if (isWritten == false)
+                {
+                    // The previous snapshot and its log are still valid, so they are
+                    // kept. The snapshot and the changes that belong to it are written
+                    // with the next flush, unless a newer snapshot has been requested.
+                    QMutexLocker const lock(&m_mutex);
+                    if (m_hasPendingSnapshot == false && m_pendingFilename == filename)
+                    {
+                        changes.insert(std::end(changes), std::begin(m_pendingChanges), std::end(m_pendingChanges));
+                        m_pendingSnapshot.swap(snapshot);
+                        m_pendingChanges.swap(changes);
+                        m_hasPendingSnapshot = true;
+                    }
+
+                    return;
+                }
+
+                m_log.setFileName(logFilename(filename));
+                m_log.open(QIODevice::WriteOnly | QIODevice::Truncate);
+            }
+        }
+
+        if (changes.empty() == false && m_log.isOpen())
+        {
+            m_log.write(changes.data(), static_cast<qint64>(changes.size()));
+            m_log.flush();
+        }
+    }
+}
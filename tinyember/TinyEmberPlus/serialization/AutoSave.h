@@ -0,0 +1,147 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_AUTOSAVE_H
+#define __TINYEMBER_SERIALIZATION_AUTOSAVE_H
+
+#include <vector>
+#include <QtCore/qatomic.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qthread.h>
+#include "../gadget/Node.h"
+
+namespace serialization
+{
+    /**
+     * The AutoSave continuously persists the local gadget tree. It consists of a snapshot,
+     * which contains the complete tree, and an append-only change log. The AutoSave has to
+     * be registered as dirty state listener of the root node before the consumer proxy,
+     * which clears the dirty journal. Whenever the tree changes, the entities contained in
+     * the journal are encoded into log records, which are written to disk on a dedicated
+     * thread. When the log exceeds a certain size, it is compacted by writing a new snapshot
+     * and truncating the log.
+     * Only the file operations of a compaction run in the background. The new snapshot is
+     * encoded on the thread that reports the change, usually the GUI thread, because the
+     * tree must not be accessed by the writer thread. Encoding visits the complete tree,
+     * so on very large trees the GUI stalls briefly once per CompactionThreshold bytes of
+     * logged changes.
+     * Structural changes, like adding or removing nodes, are not contained in the log, so
+     * reset has to be called when the structure of the tree has changed.
+     */
+    class AutoSave : public QObject, public gadget::Node::DirtyStateListenerT
+    {
+        public:
+            /** The size of the change log, in bytes, which triggers a compaction. */
+            static std::size_t const CompactionThreshold;
+
+            /**
+             * Initializes a new AutoSave. The writer thread is started when the first
+             * snapshot is requested.
+             */
+            AutoSave();
+
+            /** Destructor, writes all pending changes and stops the writer thread. */
+            virtual ~AutoSave();
+
+            /**
+             * Writes a new snapshot of the passed tree and truncates the change log. All
+             * subsequent changes are stored in the files belonging to the passed filename.
+             * @param root The root node of the tree to store.
+             * @param filename The name of the snapshot file. The change log is stored next
+             *      to it. If the name is empty, the automatic saving is disabled.
+             */
+            void reset(gadget::Node const* root, String const& filename);
+
+            /**
+             * Loads the snapshot with the passed name and applies the changes stored in
+             * its change log.
+             * @param filename The name of the snapshot file.
+             * @return The restored tree or nullptr, if the snapshot could not be loaded.
+             */
+            gadget::Node* restore(String const& filename);
+
+            /**
+             * Returns the time of the last modification of a snapshot or its change log.
+             * @param filename The name of the snapshot file.
+             * @return The time of the last modification or an invalid QDateTime if the
+             *      snapshot doesn't exist.
+             */
+            static QDateTime lastModified(String const& filename);
+
+            /** @see DirtyStateListener::notifyStateChanged() */
+            virtual void notifyStateChanged(gadget::NodeFieldState const& state, gadget::Node const* object);
+
+        protected:
+            /**
+             * Writes the pending snapshot and changes on the writer thread.
+             * @param event The event to handle.
+             */
+            virtual void customEvent(QEvent* event);
+
+        private:
+            typedef std::vector<char> Buffer;
+
+            /**
+             * This event is posted to the writer thread when new data is pending.
+             */
+            class FlushEvent : public QEvent
+            {
+                public:
+                    /** Initializes a new FlushEvent. */
+                    FlushEvent();
+
+                    /**
+                     * Returns the event type registered for FlushEvent objects.
+                     * @return The event type registered for FlushEvent objects.
+                     */
+                    static QEvent::Type eventType();
+            };
+
+            /**
+             * Returns the name of the change log belonging to a snapshot.
+             * @param filename The name of the snapshot file.
+             * @return The name of the change log.
+             */
+            static QString logFilename(String const& filename);
+
+            /**
+             * Encodes a snapshot of the tree, which replaces all pending changes.
+             * Must be called while m_mutex is locked.
+             * @param root The root node of the tree to store.
+             */
+            void setPendingSnapshot(gadget::Node const* root);
+
+            /**
+             * Posts a FlushEvent unless one is already pending.
+             */
+            void requestFlush();
+
+            /**
+             * Writes the pending snapshot and appends the pending changes to the change log.
+             * This method is usually called by the writer thread.
+             */
+            void flush();
+
+        private:
+            QThread m_thread;
+            QMutex m_mutex;
+            QMutex m_fileMutex;
+            QAtomicInt m_isFlushRequested;
+            String m_filename;
+            std::size_t m_logSize;
+            bool m_hasPendingSnapshot;
+            String m_pendingFilename;
+            Buffer m_pendingSnapshot;
+            Buffer m_pendingChanges;
+            QFile m_log;
+    };
+}
+
+#endif//__TINYEMBER_SERIALIZATION_AUTOSAVE_H
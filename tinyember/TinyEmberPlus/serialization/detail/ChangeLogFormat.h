@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGFORMAT_H
+#define __TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace serialization { namespace detail { namespace changelog
+{
+    /**
+     * The change log is an append-only file that contains the properties of nodes and
+     * parameters that have changed after the snapshot it belongs to has been written.
+     * A change log has the following layout:
+     *
+     *   Header
+     *   RecordHeader, payload
+     *   RecordHeader, payload
+     *   ...
+     *
+     * Each record contains the complete persistent state of a single entity, so replaying
+     * a record more than once has no effect. An entity is addressed by the numbers of the
+     * nodes on the path from the root, followed by its own number. These numbers are only
+     * valid for the snapshot the log belongs to, which stores the numbers of all entities.
+     * Therefore the header contains the checksum of that snapshot, and a log is only
+     * applied to the snapshot it has been written for. The payload of a record starts
+     * with the path:
+     *
+     *   uint32 depth, int32 numbers[depth]
+     *
+     * Node records continue with the description and the schema. Parameter records
+     * continue with the type, the description, the schema, the access, both formula terms,
+     * the stream identifier, the stream format and offset, followed by the type specific
+     * properties. Strings are stored as uint32 length followed by the characters. A record
+     * that extends beyond the end of the file has been interrupted while it was written and
+     * is ignored, as are all records following it.
+     */
+    enum
+    {
+        /** The version of the change log format. */
+        Version = 2,
+
+        /** The value of Header::byteOrder when the file has been written with the host byte order. */
+        ByteOrderMark = 0x01020304,
+    };
+
+    /**
+     * Scoped enumeration containing the types of the records stored in a change log.
+     */
+    struct RecordType
+    {
+        enum _Domain
+        {
+            Node = 1,
+            Parameter = 2,
+        };
+    };
+
+    /**
+     * Returns the eight characters that are stored at the beginning of each change log.
+     * @return The magic string of the change log format, including the terminating zero.
+     */
+    inline char const* magic()
+    {
+        return "EmBERLg";
+    }
+
+    /**
+     * Computes the checksum that identifies the snapshot a change log belongs to. This is
+     * the 64 bit FNV-1a hash of the snapshot file.
+     * @param data A pointer to the first byte of the snapshot.
+     * @param size The size of the snapshot, in bytes.
+     * @return The checksum of the snapshot.
+     */
+    inline std::uint64_t checksum(char const* data, std::size_t size)
+    {
+        auto result = std::uint64_t(0xcbf29ce484222325ULL);
+        for(auto last = data + size; data != last; ++data)
+        {
+            result ^= static_cast<unsigned char>(*data);
+            result *= std::uint64_t(0x100000001b3ULL);
+        }
+
+        return result;
+    }
+
+    /**
+     * The header at the beginning of a change log.
+     */
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t byteOrder;
+        std::uint32_t version;
+        std::uint64_t snapshot;
+    };
+
+    /**
+     * Precedes the payload of each record.
+     */
+    struct RecordHeader
+    {
+        std::uint32_t size;
+        std::uint32_t type;
+    };
+
+    static_assert(sizeof(Header) == 24, "Unexpected size of the change log header");
+    static_assert(sizeof(RecordHeader) == 8, "Unexpected size of the change log record header");
+}
+}
+}
+
+#endif//__TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGFORMAT_H
@@ -0,0 +1,262 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <vector>
+#include "ChangeLogReader.h"
+#include "../../gadget/BooleanParameter.h"
+#include "../../gadget/EnumParameter.h"
+#include "../../gadget/IntegerParameter.h"
+#include "../../gadget/RealParameter.h"
+#include "../../gadget/StreamFormat.h"
+#include "../../gadget/StringParameter.h"
+
+namespace serialization { namespace detail
+{
+    ChangeLogReader::ValueReader::ValueReader(ChangeLogReader& reader)
+        : m_reader(reader)
+        , m_isValid(false)
+    {}
+
+    bool ChangeLogReader::ValueReader::isValid() const
+    {
+        return m_isValid;
+    }
+
+    void ChangeLogReader::ValueReader::visit(gadget::EnumParameter* parameter)
+    {
+        auto count = std::uint32_t(0);
+        auto index = std::uint64_t(0);
+        if (m_reader.read(count) == false)
+            return;
+
+        auto entries = std::vector<String>(count);
+        for(auto& entry : entries)
+        {
+            if (m_reader.read(entry) == false)
+                return;
+        }
+
+        if (m_reader.read(index))
+        {
+            parameter->assign(std::begin(entries), std::end(entries));
+            parameter->setIndex(static_cast<gadget::EnumParameter::size_type>(index));
+            m_isValid = true;
+        }
+    }
+
+    void ChangeLogReader::ValueReader::visit(gadget::StringParameter* parameter)
+    {
+        auto maxLength = std::uint64_t(0);
+        auto value = String();
+        if (m_reader.read(maxLength) && m_reader.read(value))
+        {
+            parameter->setMaxLength(static_cast<gadget::StringParameter::size_type>(maxLength));
+            parameter->setValue(value);
+            m_isValid = true;
+        }
+    }
+
+    void ChangeLogReader::ValueReader::visit(gadget::IntegerParameter* parameter)
+    {
+        auto minimum = std::int64_t(0);
+        auto maximum = std::int64_t(0);
+        auto value = std::int64_t(0);
+        if (m_reader.read(minimum) && m_reader.read(maximum) && m_reader.read(value))
+        {
+            parameter->setMin(static_cast<gadget::IntegerParameter::value_type>(minimum));
+            parameter->setMax(static_cast<gadget::IntegerParameter::value_type>(maximum));
+            parameter->setValue(static_cast<gadget::IntegerParameter::value_type>(value));
+            m_isValid = true;
+        }
+    }
+
+    void ChangeLogReader::ValueReader::visit(gadget::RealParameter* parameter)
+    {
+        auto minimum = 0.0;
+        auto maximum = 0.0;
+        auto value = 0.0;
+        if (m_reader.read(minimum) && m_reader.read(maximum) && m_reader.read(value))
+        {
+            parameter->setMin(minimum);
+            parameter->setMax(maximum);
+            parameter->setValue(value);
+            m_isValid = true;
+        }
+    }
+
+    void ChangeLogReader::ValueReader::visit(gadget::BooleanParameter* parameter)
+    {
+        auto value = std::uint32_t(0);
+        if (m_reader.read(value))
+        {
+            parameter->setValue(value != 0);
+            m_isValid = true;
+        }
+    }
+
+
+    ChangeLogReader::ChangeLogReader(gadget::Node* root, std::uint64_t snapshot)
+        : m_root(root)
+        , m_snapshot(snapshot)
+        , m_first(nullptr)
+        , m_last(nullptr)
+    {}
+
+    //static
+    bool ChangeLogReader::isChangeLog(char const* data, std::size_t size)
+    {
+        if (size < sizeof(changelog::Header))
+            return false;
+
+        auto header = changelog::Header();
+        std::memcpy(&header, data, sizeof(header));
+        return std::memcmp(header.magic, changelog::magic(), sizeof(header.magic)) == 0
+            && header.byteOrder == changelog::ByteOrderMark
+            && header.version == changelog::Version;
+    }
+
+    std::size_t ChangeLogReader::apply(char const* data, std::size_t size)
+    {
+        auto count = std::size_t(0);
+        if (m_root == nullptr || isChangeLog(data, size) == false)
+            return count;
+
+        auto header = changelog::Header();
+        std::memcpy(&header, data, sizeof(header));
+        if (header.snapshot != m_snapshot)
+            return count;
+
+        auto first = data + sizeof(changelog::Header);
+        auto const last = data + size;
+        while(static_cast<std::size_t>(last - first) >= sizeof(changelog::RecordHeader))
+        {
+            auto header = changelog::RecordHeader();
+            std::memcpy(&header, first, sizeof(header));
+
+            auto const payload = first + sizeof(header);
+            if (static_cast<std::size_t>(last - payload) < header.size)
+                break;
+
+            m_first = payload;
+            m_last = payload + header.size;
+
+            auto isValid = false;
+            if (header.type == changelog::RecordType::Node)
+                isValid = readNode();
+            else if (header.type == changelog::RecordType::Parameter)
+                isValid = readParameter();
+
+            if (isValid == false)
+                break;
+
+            first = m_last;
+            ++count;
+        }
+
+        return count;
+    }
+
+    bool ChangeLogReader::readNode()
+    {
+        auto parent = static_cast<gadget::Node*>(nullptr);
+        auto number = 0;
+        auto description = String();
+        auto schema = String();
+        if (readPath(parent, number) == false || read(description) == false || read(schema) == false)
+            return false;
+
+        auto const node = parent != nullptr ? parent->findNode(number) : (number == 0 ? m_root : nullptr);
+        if (node != nullptr)
+        {
+            node->setDescription(description);
+            node->setSchema(schema);
+        }
+
+        return true;
+    }
+
+    bool ChangeLogReader::readParameter()
+    {
+        auto parent = static_cast<gadget::Node*>(nullptr);
+        auto number = 0;
+        auto type = std::uint32_t(0);
+        auto description = String();
+        auto schema = String();
+        auto access = std::uint32_t(0);
+        auto providerToConsumer = String();
+        auto consumerToProvider = String();
+        auto streamIdentifier = std::int32_t(0);
+        auto streamFormat = std::uint32_t(0);
+        auto streamOffset = std::uint32_t(0);
+        if (readPath(parent, number) == false
+        ||  read(type) == false
+        ||  read(description) == false
+        ||  read(schema) == false
+        ||  read(access) == false
+        ||  read(providerToConsumer) == false
+        ||  read(consumerToProvider) == false
+        ||  read(streamIdentifier) == false
+        ||  read(streamFormat) == false
+        ||  read(streamOffset) == false)
+            return false;
+
+        // Changes of entities that have been removed before the snapshot was written
+        // are skipped.
+        auto const parameter = parent != nullptr ? parent->findParameter(number) : nullptr;
+        if (parameter == nullptr || static_cast<std::uint32_t>(parameter->type().value()) != type)
+            return true;
+
+        parameter->setDescription(description);
+        parameter->setSchema(schema);
+        parameter->setAccess(static_cast<gadget::Access::_Domain>(access));
+        parameter->setFormula(gadget::Formula(providerToConsumer, consumerToProvider));
+        parameter->setStreamIdentifier(streamIdentifier);
+
+        if (streamFormat != static_cast<std::uint32_t>(gadget::StreamFormat::Invalid))
+            parameter->setStreamDescriptor(static_cast<gadget::StreamFormat::_Domain>(streamFormat), streamOffset);
+        else
+            parameter->setStreamDescriptor(nullptr);
+
+        auto reader = ValueReader(*this);
+        parameter->accept(reader);
+        return reader.isValid();
+    }
+
+    bool ChangeLogReader::readPath(gadget::Node*& parent, int& number)
+    {
+        auto depth = std::uint32_t(0);
+        if (read(depth) == false || depth > static_cast<std::size_t>(m_last - m_first) / sizeof(std::int32_t))
+            return false;
+
+        parent = depth > 0 ? m_root : nullptr;
+        number = 0;
+
+        for(auto index = std::uint32_t(0); index < depth; ++index)
+        {
+            auto item = std::int32_t(0);
+            read(item);
+
+            if (index + 1 < depth)
+                parent = parent != nullptr ? parent->findNode(item) : nullptr;
+            else
+                number = item;
+        }
+
+        return true;
+    }
+
+    bool ChangeLogReader::read(String& value)
+    {
+        auto length = std::uint32_t(0);
+        if (read(length) == false || static_cast<std::size_t>(m_last - m_first) < length)
+            return false;
+
+        value.assign(m_first, length);
+        m_first += length;
+        return true;
+    }
+}
+}
@@ -0,0 +1,152 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGREADER_H
+#define __TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGREADER_H
+
+#include <cstddef>
+#include <cstring>
+#include "../../gadget/Node.h"
+#include "../../gadget/ParameterTypeVisitor.h"
+#include "ChangeLogFormat.h"
+
+namespace serialization { namespace detail
+{
+    /**
+     * The change log reader applies the records of a change log to a gadget tree, which
+     * has been loaded from the snapshot the log belongs to. A log that has been written for
+     * another snapshot is not applied. Records referring to entities that don't exist in
+     * the tree are skipped.
+     */
+    class ChangeLogReader
+    {
+        public:
+            /**
+             * Initializes a new ChangeLogReader.
+             * @param root The root node of the tree to apply the changes to.
+             * @param snapshot The checksum of the snapshot the tree has been loaded from.
+             */
+            ChangeLogReader(gadget::Node* root, std::uint64_t snapshot);
+
+            /**
+             * Returns true if the passed buffer starts with a valid change log header.
+             * @param data The buffer to examine.
+             * @param size The size of the buffer, in bytes.
+             * @return true if the buffer contains a change log.
+             */
+            static bool isChangeLog(char const* data, std::size_t size);
+
+            /**
+             * Applies all complete records of a change log. Nothing is applied if the log
+             * belongs to another snapshot. Reading stops at the first record that is
+             * truncated or malformed.
+             * @param data A pointer to the first byte of the change log, including its header.
+             * @param size The size of the change log, in bytes.
+             * @return The number of records that have been read.
+             */
+            std::size_t apply(char const* data, std::size_t size);
+
+        private:
+            /**
+             * Assigns the properties of a parameter that depend on its type.
+             */
+            class ValueReader : public gadget::ParameterTypeVisitor
+            {
+                public:
+                    /**
+                     * Initializes a new ValueReader.
+                     * @param reader The reader providing the record data.
+                     */
+                    explicit ValueReader(ChangeLogReader& reader);
+
+                    /**
+                     * Returns false if the record ended before all properties could be read.
+                     * @return true if all properties have been read.
+                     */
+                    bool isValid() const;
+
+                    /** @see ParameterTypeVisitor::visit() */
+                    virtual void visit(gadget::EnumParameter* parameter);
+
+                    /** @see ParameterTypeVisitor::visit() */
+                    virtual void visit(gadget::StringParameter* parameter);
+
+                    /** @see ParameterTypeVisitor::visit() */
+                    virtual void visit(gadget::IntegerParameter* parameter);
+
+                    /** @see ParameterTypeVisitor::visit() */
+                    virtual void visit(gadget::RealParameter* parameter);
+
+                    /** @see ParameterTypeVisitor::visit() */
+                    virtual void visit(gadget::BooleanParameter* parameter);
+
+                private:
+                    ChangeLogReader& m_reader;
+                    bool m_isValid;
+            };
+
+        private:
+            /**
+             * Applies a node record.
+             * @return false if the record is malformed.
+             */
+            bool readNode();
+
+            /**
+             * Applies a parameter record.
+             * @return false if the record is malformed.
+             */
+            bool readParameter();
+
+            /**
+             * Reads the path at the beginning of a record and looks up the parent of the
+             * addressed entity.
+             * @param parent Receives the parent node, or nullptr if it doesn't exist.
+             * @param number Receives the number of the entity. The root node has the number 0.
+             * @return false if the record is malformed.
+             */
+            bool readPath(gadget::Node*& parent, int& number);
+
+            /**
+             * Reads a string that is prefixed with its length.
+             * @param value Receives the string.
+             * @return false if the record ends before the string.
+             */
+            bool read(String& value);
+
+            /**
+             * Reads the bytes of a trivial value.
+             * @param value Receives the value.
+             * @return false if the record ends before the value.
+             */
+            template<typename ValueType>
+            bool read(ValueType& value);
+
+        private:
+            gadget::Node *const m_root;
+            std::uint64_t const m_snapshot;
+            char const* m_first;
+            char const* m_last;
+    };
+
+    /**************************************************************************
+     * Inline implementation                                                  *
+     **************************************************************************/
+
+    template<typename ValueType>
+    inline bool ChangeLogReader::read(ValueType& value)
+    {
+        if (static_cast<std::size_t>(m_last - m_first) < sizeof(value))
+            return false;
+
+        std::memcpy(&value, m_first, sizeof(value));
+        m_first += sizeof(value);
+        return true;
+    }
+}
+}
+
+#endif//__TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGREADER_H
@@ -0,0 +1,153 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "ChangeLogWriter.h"
+#include "../../gadget/BooleanParameter.h"
+#include "../../gadget/EnumParameter.h"
+#include "../../gadget/IntegerParameter.h"
+#include "../../gadget/RealParameter.h"
+#include "../../gadget/StreamFormat.h"
+#include "../../gadget/StringParameter.h"
+
+namespace serialization { namespace detail
+{
+    ChangeLogWriter::ValueWriter::ValueWriter(ChangeLogWriter& writer)
+        : m_writer(writer)
+    {}
+
+    void ChangeLogWriter::ValueWriter::visit(gadget::EnumParameter const* parameter) const
+    {
+        m_writer.append(static_cast<std::uint32_t>(parameter->size()));
+        for(auto const& entry : *parameter)
+            m_writer.append(entry);
+
+        m_writer.append(static_cast<std::uint64_t>(parameter->index()));
+    }
+
+    void ChangeLogWriter::ValueWriter::visit(gadget::StringParameter const* parameter) const
+    {
+        m_writer.append(static_cast<std::uint64_t>(parameter->maxLength()));
+        m_writer.append(parameter->value());
+    }
+
+    void ChangeLogWriter::ValueWriter::visit(gadget::IntegerParameter const* parameter) const
+    {
+        m_writer.append(static_cast<std::int64_t>(parameter->minimum()));
+        m_writer.append(static_cast<std::int64_t>(parameter->maximum()));
+        m_writer.append(static_cast<std::int64_t>(parameter->value()));
+    }
+
+    void ChangeLogWriter::ValueWriter::visit(gadget::RealParameter const* parameter) const
+    {
+        m_writer.append(static_cast<double>(parameter->minimum()));
+        m_writer.append(static_cast<double>(parameter->maximum()));
+        m_writer.append(static_cast<double>(parameter->value()));
+    }
+
+    void ChangeLogWriter::ValueWriter::visit(gadget::BooleanParameter const* parameter) const
+    {
+        m_writer.append(static_cast<std::uint32_t>(parameter->value() ? 1 : 0));
+    }
+
+
+    ChangeLogWriter::ChangeLogWriter(Buffer& buffer)
+        : m_buffer(buffer)
+    {}
+
+    void ChangeLogWriter::writeHeader(std::uint64_t snapshot)
+    {
+        auto header = changelog::Header();
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, changelog::magic(), sizeof(header.magic));
+        header.byteOrder = changelog::ByteOrderMark;
+        header.version = changelog::Version;
+        header.snapshot = snapshot;
+        append(header);
+    }
+
+    void ChangeLogWriter::write(gadget::Node const* node)
+    {
+        auto const offset = beginRecord(changelog::RecordType::Node);
+        writePath(node->parent(), node->number());
+        append(node->description());
+        append(node->schema());
+        endRecord(offset);
+    }
+
+    void ChangeLogWriter::write(gadget::Parameter const* parameter)
+    {
+        auto const descriptor = parameter->streamDescriptor();
+        auto const& formula = parameter->formula();
+        auto const offset = beginRecord(changelog::RecordType::Parameter);
+        writePath(parameter->parent(), parameter->number());
+        append(static_cast<std::uint32_t>(parameter->type().value()));
+        append(parameter->description());
+        append(parameter->schema());
+        append(static_cast<std::uint32_t>(parameter->access().value()));
+        append(formula.providerToConsumer());
+        append(formula.consumerToProvider());
+        append(static_cast<std::int32_t>(parameter->streamIdentifier()));
+        append(descriptor != nullptr
+            ? static_cast<std::uint32_t>(descriptor->format().value())
+            : static_cast<std::uint32_t>(gadget::StreamFormat::Invalid));
+        append(static_cast<std::uint32_t>(descriptor != nullptr ? descriptor->offset() : 0));
+
+        parameter->accept(ValueWriter(*this));
+        endRecord(offset);
+    }
+
+    ChangeLogWriter::Buffer::size_type ChangeLogWriter::beginRecord(changelog::RecordType::_Domain type)
+    {
+        auto const offset = m_buffer.size();
+        auto header = changelog::RecordHeader();
+        header.size = 0;
+        header.type = static_cast<std::uint32_t>(type);
+        append(header);
+        return offset;
+    }
+
+    void ChangeLogWriter::endRecord(Buffer::size_type offset)
+    {
+        auto const size = static_cast<std::uint32_t>(m_buffer.size() - offset - sizeof(changelog::RecordHeader));
+        std::memcpy(m_buffer.data() + offset, &size, sizeof(size));
+    }
+
+    void ChangeLogWriter::writePath(gadget::Node const* parent, int number)
+    {
+        auto depth = std::uint32_t(parent != nullptr ? 1 : 0);
+        for(auto node = parent; node != nullptr && node->parent() != nullptr; node = node->parent())
+            ++depth;
+
+        // The numbers are written backwards, starting with the entity itself, so that the
+        // path doesn't have to be collected in a temporary container.
+        append(depth);
+        auto const offset = m_buffer.size();
+        m_buffer.resize(offset + depth * sizeof(std::int32_t));
+
+        auto output = m_buffer.data() + m_buffer.size();
+        auto write = [&output](int value)
+        {
+            auto const item = static_cast<std::int32_t>(value);
+            output -= sizeof(item);
+            std::memcpy(output, &item, sizeof(item));
+        };
+
+        if (depth > 0)
+        {
+            write(number);
+            for(auto node = parent; node->parent() != nullptr; node = node->parent())
+                write(node->number());
+        }
+    }
+
+    void ChangeLogWriter::append(String const& value)
+    {
+        auto const length = static_cast<std::uint32_t>(value.size());
+        append(length);
+        m_buffer.insert(std::end(m_buffer), std::begin(value), std::end(value));
+    }
+}
+}
@@ -0,0 +1,137 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGWRITER_H
+#define __TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGWRITER_H
+
+#include <cstring>
+#include <vector>
+#include "../../gadget/Node.h"
+#include "../../gadget/ParameterTypeVisitor.h"
+#include "ChangeLogFormat.h"
+
+namespace serialization { namespace detail
+{
+    /**
+     * The change log writer appends the records described in ChangeLogFormat.h to a buffer.
+     * The cost of a record only depends on the size of the entity it describes, not on
+     * the size of the tree.
+     */
+    class ChangeLogWriter
+    {
+        public:
+            typedef std::vector<char> Buffer;
+
+            /**
+             * Initializes a new ChangeLogWriter.
+             * @param buffer The buffer to append the records to.
+             */
+            explicit ChangeLogWriter(Buffer& buffer);
+
+            /**
+             * Appends the header of a new change log.
+             * @param snapshot The checksum of the snapshot the log belongs to.
+             */
+            void writeHeader(std::uint64_t snapshot);
+
+            /**
+             * Appends a record containing the persistent properties of a node.
+             * @param node The node to store.
+             */
+            void write(gadget::Node const* node);
+
+            /**
+             * Appends a record containing the persistent properties of a parameter.
+             * @param parameter The parameter to store.
+             */
+            void write(gadget::Parameter const* parameter);
+
+        private:
+            /**
+             * Appends the properties of a parameter that depend on its type.
+             */
+            class ValueWriter : public gadget::ParameterTypeVisitorConst
+            {
+                public:
+                    /**
+                     * Initializes a new ValueWriter.
+                     * @param writer The writer to append the properties to.
+                     */
+                    explicit ValueWriter(ChangeLogWriter& writer);
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::EnumParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::StringParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::IntegerParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::RealParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::BooleanParameter const* parameter) const;
+
+                private:
+                    ChangeLogWriter& m_writer;
+            };
+
+        private:
+            /**
+             * Appends a record header and returns its position, so that its size can be
+             * updated when the record is complete.
+             * @param type The type of the record.
+             * @return The offset of the record header within the buffer.
+             */
+            Buffer::size_type beginRecord(changelog::RecordType::_Domain type);
+
+            /**
+             * Updates the size of a record that has been started with beginRecord.
+             * @param offset The offset of the record header within the buffer.
+             */
+            void endRecord(Buffer::size_type offset);
+
+            /**
+             * Appends the path of an entity.
+             * @param parent The parent of the entity or nullptr if the entity is the root node.
+             * @param number The number of the entity.
+             */
+            void writePath(gadget::Node const* parent, int number);
+
+            /**
+             * Appends a string, prefixed with its length.
+             * @param value The string to append.
+             */
+            void append(String const& value);
+
+            /**
+             * Appends the bytes of a trivial value.
+             * @param value The value to append.
+             */
+            template<typename ValueType>
+            void append(ValueType value);
+
+        private:
+            Buffer& m_buffer;
+    };
+
+    /**************************************************************************
+     * Inline implementation                                                  *
+     **************************************************************************/
+
+    template<typename ValueType>
+    inline void ChangeLogWriter::append(ValueType value)
+    {
+        auto const offset = m_buffer.size();
+        m_buffer.resize(offset + sizeof(value));
+        std::memcpy(m_buffer.data() + offset, &value, sizeof(value));
+    }
+}
+}
+
+#endif//__TINYEMBER_SERIALIZATION_DETAIL_CHANGELOGWRITER_H
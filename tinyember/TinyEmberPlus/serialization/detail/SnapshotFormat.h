@@ -0,0 +1,142 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_DETAIL_SNAPSHOTFORMAT_H
+#define __TINYEMBER_SERIALIZATION_DETAIL_SNAPSHOTFORMAT_H
+
+#include <cstdint>
+
+namespace serialization { namespace detail { namespace snapshot
+{
+    /**
+     * The snapshot format stores a gadget tree in flat tables, so that it can be mapped
+     * into memory and read without decoding an intermediate dom. A snapshot file has the
+     * following layout:
+     *
+     *   Header
+     *   StringRecord    strings[Header::stringCount]
+     *   NodeRecord      nodes[Header::nodeCount]
+     *   ParameterRecord parameters[Header::parameterCount]
+     *   uint32          enumEntries[Header::enumEntryCount]
+     *   char            stringData[Header::stringDataSize]
+     *
+     * All strings are stored once in the string table and are referenced by their index.
+     * The nodes are stored in pre-order, so a parent always precedes its children. The
+     * parameters of a node are stored consecutively. Each node and parameter record
+     * contains the number of the entity, so a restored tree uses the same Ember+ paths
+     * as the tree that has been saved, even if its numbering contains gaps. Since all
+     * records are multiples of eight bytes, every table is properly aligned within the
+     * mapped file. The records are written in the byte order of the host, which is
+     * recorded in the header.
+     */
+    enum
+    {
+        /** The version of the snapshot format. */
+        Version = 2,
+
+        /** The value of Header::byteOrder when the file has been written with the host byte order. */
+        ByteOrderMark = 0x01020304,
+
+        /** The index that is used when a record doesn't refer to a parent node. */
+        NoParent = -1,
+    };
+
+    /**
+     * Returns the eight characters that are stored at the beginning of each snapshot file.
+     * @return The magic string of the snapshot format, including the terminating zero.
+     */
+    inline char const* magic()
+    {
+        return "EmBERSn";
+    }
+
+    /**
+     * The header at the beginning of a snapshot file.
+     */
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t byteOrder;
+        std::uint32_t version;
+        std::uint32_t stringCount;
+        std::uint32_t nodeCount;
+        std::uint32_t parameterCount;
+        std::uint32_t enumEntryCount;
+        std::uint64_t stringDataSize;
+    };
+
+    /**
+     * Locates a string within the string data block.
+     */
+    struct StringRecord
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    /**
+     * Contains the properties of a single node.
+     */
+    struct NodeRecord
+    {
+        std::int32_t parent;
+        std::int32_t number;
+        std::uint32_t identifier;
+        std::uint32_t description;
+        std::uint32_t schema;
+        std::uint32_t firstParameter;
+        std::uint32_t parameterCount;
+        std::uint32_t reserved;
+    };
+
+    /**
+     * Stores either an integer or a real value, depending on the type of the parameter.
+     * For string parameters, the integer refers to the string table, for enumerations
+     * it contains the selected index and for booleans it is either 0 or 1.
+     */
+    union Value
+    {
+        std::int64_t integer;
+        double real;
+    };
+
+    /**
+     * Contains the properties of a single parameter. The type is one of the values
+     * defined in gadget::ParameterType. The stream format is set to StreamFormat::Invalid
+     * if the parameter has no stream descriptor. The maximum of a string parameter
+     * contains its maximum length. The reserved field keeps the values aligned and is
+     * always zero.
+     */
+    struct ParameterRecord
+    {
+        std::uint32_t type;
+        std::int32_t number;
+        std::uint32_t identifier;
+        std::uint32_t description;
+        std::uint32_t schema;
+        std::uint32_t access;
+        std::uint32_t providerToConsumer;
+        std::uint32_t consumerToProvider;
+        std::int32_t streamIdentifier;
+        std::uint32_t streamFormat;
+        std::uint32_t streamOffset;
+        std::uint32_t firstEnumEntry;
+        std::uint32_t enumEntryCount;
+        std::uint32_t reserved;
+        Value minimum;
+        Value maximum;
+        Value value;
+    };
+
+    static_assert(sizeof(Header) == 40, "Unexpected size of the snapshot header");
+    static_assert(sizeof(StringRecord) == 8, "Unexpected size of the snapshot string record");
+    static_assert(sizeof(NodeRecord) == 32, "Unexpected size of the snapshot node record");
+    static_assert(sizeof(ParameterRecord) == 80, "Unexpected size of the snapshot parameter record");
+}
+}
+}
+
+#endif//__TINYEMBER_SERIALIZATION_DETAIL_SNAPSHOTFORMAT_H
@@ -0,0 +1,257 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <cstring>
+#include <vector>
+#include "SnapshotReader.h"
+#include "../../gadget/BooleanParameter.h"
+#include "../../gadget/EnumParameter.h"
+#include "../../gadget/IntegerParameter.h"
+#include "../../gadget/RealParameter.h"
+#include "../../gadget/StreamFormat.h"
+#include "../../gadget/StringParameter.h"
+#include "../../gadget/NodeFactory.h"
+#include "../../gadget/ParameterFactory.h"
+
+namespace serialization { namespace detail
+{
+    bool SnapshotReader::isSnapshot(char const* data, std::size_t size)
+    {
+        return size >= sizeof(snapshot::Header)
+            && std::memcmp(data, snapshot::magic(), sizeof(snapshot::Header::magic)) == 0;
+    }
+
+    SnapshotReader::SnapshotReader(char const* data, std::size_t size)
+        : m_root(nullptr)
+        , m_header(nullptr)
+        , m_strings(nullptr)
+        , m_nodes(nullptr)
+        , m_parameters(nullptr)
+        , m_enumEntries(nullptr)
+        , m_stringData(nullptr)
+    {
+        if (load(data, size) && m_header->nodeCount > 0)
+        {
+            auto const count = m_header->nodeCount;
+            auto nodes = std::vector<gadget::Node*>(count, nullptr);
+            auto isValid = true;
+            for(auto index = std::uint32_t(0); index < count && isValid; ++index)
+            {
+                auto const& record = m_nodes[index];
+                auto const parent = index == 0 ? nullptr : nodes[record.parent];
+                if (parent != nullptr && isNumberUsed(parent, record.number))
+                {
+                    isValid = false;
+                    break;
+                }
+
+                auto node = parent == nullptr
+                    ? gadget::NodeFactory::createRoot(string(record.identifier))
+                    : gadget::NodeFactory::createNode(parent, record.number, string(record.identifier));
+
+                node->setDescription(string(record.description));
+                node->setSchema(string(record.schema));
+                nodes[index] = node;
+
+                auto const first = m_parameters + record.firstParameter;
+                auto const last = first + record.parameterCount;
+                for(auto parameter = first; parameter != last; ++parameter)
+                {
+                    if (isNumberUsed(node, parameter->number))
+                    {
+                        isValid = false;
+                        break;
+                    }
+
+                    create(node, *parameter);
+                }
+            }
+
+            // A snapshot that uses a number twice within the same node is malformed, so
+            // the partially restored tree is discarded.
+            if (isValid)
+                m_root = nodes.front();
+            else
+                delete nodes.front();
+        }
+    }
+
+    //static
+    bool SnapshotReader::isNumberUsed(gadget::Node const* parent, std::int32_t number)
+    {
+        return parent->findNode(number) != nullptr || parent->findParameter(number) != nullptr;
+    }
+
+    bool SnapshotReader::load(char const* data, std::size_t size)
+    {
+        if (isSnapshot(data, size) == false)
+            return false;
+
+        auto const header = reinterpret_cast<snapshot::Header const*>(data);
+        if (header->byteOrder != snapshot::ByteOrderMark || header->version != snapshot::Version)
+            return false;
+
+        auto const stringOffset = std::uint64_t(sizeof(snapshot::Header));
+        auto const nodeOffset = stringOffset + std::uint64_t(header->stringCount) * sizeof(snapshot::StringRecord);
+        auto const parameterOffset = nodeOffset + std::uint64_t(header->nodeCount) * sizeof(snapshot::NodeRecord);
+        auto const enumOffset = parameterOffset + std::uint64_t(header->parameterCount) * sizeof(snapshot::ParameterRecord);
+        auto const stringDataOffset = enumOffset + std::uint64_t(header->enumEntryCount) * sizeof(std::uint32_t);
+        if (stringDataOffset + header->stringDataSize > size)
+            return false;
+
+        m_header = header;
+        m_strings = reinterpret_cast<snapshot::StringRecord const*>(data + stringOffset);
+        m_nodes = reinterpret_cast<snapshot::NodeRecord const*>(data + nodeOffset);
+        m_parameters = reinterpret_cast<snapshot::ParameterRecord const*>(data + parameterOffset);
+        m_enumEntries = reinterpret_cast<std::uint32_t const*>(data + enumOffset);
+        m_stringData = data + stringDataOffset;
+
+        auto const stringCount = header->stringCount;
+        for(auto index = std::uint32_t(0); index < stringCount; ++index)
+        {
+            auto const& record = m_strings[index];
+            if (std::uint64_t(record.offset) + record.length > header->stringDataSize)
+                return false;
+        }
+
+        for(auto index = std::uint32_t(0); index < header->enumEntryCount; ++index)
+        {
+            if (m_enumEntries[index] >= stringCount)
+                return false;
+        }
+
+        // The nodes are stored in pre-order, so each node must refer to a parent
+        // that has been read before.
+        for(auto index = std::uint32_t(0); index < header->nodeCount; ++index)
+        {
+            auto const& record = m_nodes[index];
+            auto const isValidParent = index == 0
+                ? record.parent == snapshot::NoParent
+                : record.parent >= 0 && std::uint32_t(record.parent) < index;
+
+            if (isValidParent == false
+            ||  (index > 0 && record.number <= 0)
+            ||  record.identifier >= stringCount
+            ||  record.description >= stringCount
+            ||  record.schema >= stringCount
+            ||  std::uint64_t(record.firstParameter) + record.parameterCount > header->parameterCount)
+                return false;
+        }
+
+        for(auto index = std::uint32_t(0); index < header->parameterCount; ++index)
+        {
+            auto const& record = m_parameters[index];
+            if (record.number <= 0
+            ||  record.identifier >= stringCount
+            ||  record.description >= stringCount
+            ||  record.schema >= stringCount
+            ||  record.providerToConsumer >= stringCount
+            ||  record.consumerToProvider >= stringCount)
+                return false;
+
+            if (record.type == gadget::ParameterType::String
+            &&  (record.value.integer < 0 || record.value.integer >= stringCount))
+                return false;
+
+            if (record.type == gadget::ParameterType::Enum
+            &&  std::uint64_t(record.firstEnumEntry) + record.enumEntryCount > header->enumEntryCount)
+                return false;
+        }
+
+        return true;
+    }
+
+    String SnapshotReader::string(std::uint32_t index) const
+    {
+        auto const& record = m_strings[index];
+        return String(m_stringData + record.offset, record.length);
+    }
+
+    void SnapshotReader::create(gadget::Node* parent, snapshot::ParameterRecord const& record) const
+    {
+        auto const identifier = string(record.identifier);
+        switch(record.type)
+        {
+            case gadget::ParameterType::Boolean:
+            {
+                auto parameter = gadget::ParameterFactory::create(parent, record.number, identifier, record.value.integer != 0);
+                transformBase(parameter, record);
+                break;
+            }
+
+            case gadget::ParameterType::Enum:
+            {
+                auto parameter = gadget::ParameterFactory::create(parent, record.number, identifier);
+                auto entries = std::vector<String>();
+                auto const first = m_enumEntries + record.firstEnumEntry;
+                auto const last = first + record.enumEntryCount;
+
+                entries.reserve(record.enumEntryCount);
+                for(auto entry = first; entry != last; ++entry)
+                    entries.push_back(string(*entry));
+
+                transformBase(parameter, record);
+                parameter->assign(std::begin(entries), std::end(entries));
+                parameter->setIndex(static_cast<gadget::EnumParameter::size_type>(record.value.integer));
+                break;
+            }
+
+            case gadget::ParameterType::Integer:
+            {
+                auto parameter = gadget::ParameterFactory::create(parent, record.number, identifier, 0, 1000, 0);
+                transformBase(parameter, record);
+                parameter->setMin(static_cast<gadget::IntegerParameter::value_type>(record.minimum.integer));
+                parameter->setMax(static_cast<gadget::IntegerParameter::value_type>(record.maximum.integer));
+                parameter->setValue(static_cast<gadget::IntegerParameter::value_type>(record.value.integer));
+                break;
+            }
+
+            case gadget::ParameterType::Real:
+            {
+                auto parameter = gadget::ParameterFactory::create(parent, record.number, identifier, 0.0, 1000.0, 0.0);
+                transformBase(parameter, record);
+                parameter->setMin(record.minimum.real);
+                parameter->setMax(record.maximum.real);
+                parameter->setValue(record.value.real);
+                break;
+            }
+
+            case gadget::ParameterType::String:
+            {
+                auto const value = string(static_cast<std::uint32_t>(record.value.integer));
+                auto const maxLength = static_cast<std::size_t>(record.maximum.integer);
+                auto parameter = gadget::ParameterFactory::create(parent, record.number, identifier, value, maxLength);
+                transformBase(parameter, record);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    void SnapshotReader::transformBase(gadget::Parameter* parameter, snapshot::ParameterRecord const& record) const
+    {
+        parameter->setDescription(string(record.description));
+        parameter->setSchema(string(record.schema));
+        parameter->setAccess(static_cast<gadget::Access::_Domain>(record.access));
+
+        auto const providerToConsumer = string(record.providerToConsumer);
+        auto const consumerToProvider = string(record.consumerToProvider);
+        if (providerToConsumer.empty() == false || consumerToProvider.empty() == false)
+            parameter->setFormula(gadget::Formula(providerToConsumer, consumerToProvider));
+
+        if (record.streamFormat != static_cast<std::uint32_t>(gadget::StreamFormat::Invalid))
+        {
+            auto const format = static_cast<gadget::StreamFormat::_Domain>(record.streamFormat);
+            parameter->setStreamDescriptor(format, record.streamOffset);
+        }
+
+        if (record.streamIdentifier > -1)
+            parameter->setStreamIdentifier(record.streamIdentifier);
+    }
+}
+}
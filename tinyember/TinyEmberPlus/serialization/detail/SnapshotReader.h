@@ -0,0 +1,104 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_SNAPSHOTREADER_H
+#define __TINYEMBER_SERIALIZATION_SNAPSHOTREADER_H
+
+#include <cstddef>
+#include "../../gadget/Node.h"
+#include "SnapshotFormat.h"
+
+/** Forward declarations */
+namespace gadget
+{
+    class Parameter;
+}
+
+namespace serialization
+{
+    class Archive;
+}
+
+namespace serialization { namespace detail
+{
+    /**
+     * This reader creates a gadget tree directly from the tables of a snapshot, which
+     * is usually mapped into memory. If the snapshot is malformed, no tree is created.
+     */
+    class SnapshotReader
+    {
+        friend class serialization::Archive;
+        public:
+            /**
+             * Returns true if the passed buffer starts with the magic string of the
+             * snapshot format.
+             * @param data The buffer to examine.
+             * @param size The size of the buffer, in bytes.
+             * @return true if the buffer contains a snapshot.
+             */
+            static bool isSnapshot(char const* data, std::size_t size);
+
+        private:
+            /**
+             * Initializes a new reader and creates the gadget tree stored in the snapshot.
+             * @param data A pointer to the first byte of the snapshot. The buffer must be
+             *      aligned to an eight byte boundary.
+             * @param size The size of the snapshot, in bytes.
+             */
+            SnapshotReader(char const* data, std::size_t size);
+
+            /**
+             * Locates the tables of the snapshot and verifies that all records only refer
+             * to data contained in the snapshot.
+             * @param data A pointer to the first byte of the snapshot.
+             * @param size The size of the snapshot, in bytes.
+             * @return true if the snapshot is valid.
+             */
+            bool load(char const* data, std::size_t size);
+
+            /**
+             * Returns true if the passed node already contains a child node or parameter
+             * with the specified number.
+             * @param parent The node to examine.
+             * @param number The number to look for.
+             * @return true if the number is already in use.
+             */
+            static bool isNumberUsed(gadget::Node const* parent, std::int32_t number);
+
+            /**
+             * Returns the string with the specified index.
+             * @param index The index of the string within the string table.
+             * @return The requested string.
+             */
+            String string(std::uint32_t index) const;
+
+            /**
+             * Creates the parameter described by the passed record.
+             * @param parent The node that owns the new parameter.
+             * @param record The record describing the parameter.
+             */
+            void create(gadget::Node* parent, snapshot::ParameterRecord const& record) const;
+
+            /**
+             * Assigns the properties shared by all parameter types.
+             * @param parameter The parameter to assign the properties to.
+             * @param record The record to read the properties from.
+             */
+            void transformBase(gadget::Parameter* parameter, snapshot::ParameterRecord const& record) const;
+
+        private:
+            gadget::Node* m_root;
+            snapshot::Header const* m_header;
+            snapshot::StringRecord const* m_strings;
+            snapshot::NodeRecord const* m_nodes;
+            snapshot::ParameterRecord const* m_parameters;
+            std::uint32_t const* m_enumEntries;
+            char const* m_stringData;
+    };
+}
+}
+
+#endif//__TINYEMBER_SERIALIZATION_SNAPSHOTREADER_H
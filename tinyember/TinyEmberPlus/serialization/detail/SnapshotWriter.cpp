@@ -0,0 +1,180 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <cstring>
+#include "SnapshotWriter.h"
+#include "../../gadget/BooleanParameter.h"
+#include "../../gadget/EnumParameter.h"
+#include "../../gadget/IntegerParameter.h"
+#include "../../gadget/RealParameter.h"
+#include "../../gadget/StreamFormat.h"
+#include "../../gadget/StringParameter.h"
+
+namespace serialization { namespace detail
+{
+    SnapshotWriter::ValueWriter::ValueWriter(SnapshotWriter& writer, snapshot::ParameterRecord& record)
+        : m_writer(writer)
+        , m_record(record)
+    {}
+
+    void SnapshotWriter::ValueWriter::visit(gadget::EnumParameter const* parameter) const
+    {
+        m_record.firstEnumEntry = static_cast<std::uint32_t>(m_writer.m_enumEntries.size());
+        m_record.enumEntryCount = static_cast<std::uint32_t>(parameter->size());
+        m_record.value.integer = parameter->index();
+
+        for(auto const& entry : *parameter)
+            m_writer.m_enumEntries.push_back(m_writer.intern(entry));
+    }
+
+    void SnapshotWriter::ValueWriter::visit(gadget::StringParameter const* parameter) const
+    {
+        m_record.maximum.integer = parameter->maxLength();
+        m_record.value.integer = m_writer.intern(parameter->value());
+    }
+
+    void SnapshotWriter::ValueWriter::visit(gadget::IntegerParameter const* parameter) const
+    {
+        m_record.minimum.integer = parameter->minimum();
+        m_record.maximum.integer = parameter->maximum();
+        m_record.value.integer = parameter->value();
+    }
+
+    void SnapshotWriter::ValueWriter::visit(gadget::RealParameter const* parameter) const
+    {
+        m_record.minimum.real = parameter->minimum();
+        m_record.maximum.real = parameter->maximum();
+        m_record.value.real = parameter->value();
+    }
+
+    void SnapshotWriter::ValueWriter::visit(gadget::BooleanParameter const* parameter) const
+    {
+        m_record.value.integer = parameter->value() ? 1 : 0;
+    }
+
+
+    SnapshotWriter::SnapshotWriter(gadget::Node const* node)
+    {
+        if (node != nullptr)
+            write(node, snapshot::NoParent);
+
+        finish();
+    }
+
+    SnapshotWriter::size_type SnapshotWriter::size() const
+    {
+        return m_buffer.size();
+    }
+
+    char const* SnapshotWriter::data() const
+    {
+        return m_buffer.data();
+    }
+
+    void SnapshotWriter::write(gadget::Node const* node, std::int32_t parent)
+    {
+        auto const index = static_cast<std::int32_t>(m_nodes.size());
+        auto record = snapshot::NodeRecord();
+        record.parent = parent;
+        record.number = node->number();
+        record.identifier = intern(node->identifier());
+        record.description = intern(node->description());
+        record.schema = intern(node->schema());
+        record.firstParameter = static_cast<std::uint32_t>(m_parameters.size());
+        record.parameterCount = static_cast<std::uint32_t>(node->parameters().size());
+        m_nodes.push_back(record);
+
+        // The parameters are written first, so that they are created before the child
+        // nodes just like when they are loaded from a glow tree.
+        for(auto parameter : node->parameters())
+            write(parameter);
+
+        for(auto child : node->nodes())
+            write(child, index);
+    }
+
+    void SnapshotWriter::write(gadget::Parameter const* parameter)
+    {
+        auto const descriptor = parameter->streamDescriptor();
+        auto const& formula = parameter->formula();
+        auto record = snapshot::ParameterRecord();
+        std::memset(&record, 0, sizeof(record));
+
+        record.type = static_cast<std::uint32_t>(parameter->type().value());
+        record.number = parameter->number();
+        record.identifier = intern(parameter->identifier());
+        record.description = intern(parameter->description());
+        record.schema = intern(parameter->schema());
+        record.access = static_cast<std::uint32_t>(parameter->access().value());
+        record.providerToConsumer = intern(formula.providerToConsumer());
+        record.consumerToProvider = intern(formula.consumerToProvider());
+        record.streamIdentifier = parameter->streamIdentifier();
+        record.streamFormat = descriptor != nullptr
+            ? static_cast<std::uint32_t>(descriptor->format().value())
+            : static_cast<std::uint32_t>(gadget::StreamFormat::Invalid);
+        record.streamOffset = descriptor != nullptr ? descriptor->offset() : 0;
+
+        parameter->accept(ValueWriter(*this, record));
+        m_parameters.push_back(record);
+    }
+
+    std::uint32_t SnapshotWriter::intern(String const& value)
+    {
+        auto const result = m_stringIndex.find(value);
+        if (result != std::end(m_stringIndex))
+            return result->second;
+
+        auto const index = static_cast<std::uint32_t>(m_strings.size());
+        auto record = snapshot::StringRecord();
+        record.offset = static_cast<std::uint32_t>(m_stringData.size());
+        record.length = static_cast<std::uint32_t>(value.size());
+
+        m_strings.push_back(record);
+        m_stringData.append(value);
+        m_stringIndex.insert(std::make_pair(value, index));
+        return index;
+    }
+
+    void SnapshotWriter::finish()
+    {
+        auto header = snapshot::Header();
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, snapshot::magic(), sizeof(header.magic));
+        header.byteOrder = snapshot::ByteOrderMark;
+        header.version = snapshot::Version;
+        header.stringCount = static_cast<std::uint32_t>(m_strings.size());
+        header.nodeCount = static_cast<std::uint32_t>(m_nodes.size());
+        header.parameterCount = static_cast<std::uint32_t>(m_parameters.size());
+        header.enumEntryCount = static_cast<std::uint32_t>(m_enumEntries.size());
+        header.stringDataSize = m_stringData.size();
+
+        auto const size = sizeof(header)
+            + m_strings.size() * sizeof(snapshot::StringRecord)
+            + m_nodes.size() * sizeof(snapshot::NodeRecord)
+            + m_parameters.size() * sizeof(snapshot::ParameterRecord)
+            + m_enumEntries.size() * sizeof(std::uint32_t)
+            + m_stringData.size();
+
+        m_buffer.resize(size);
+        auto output = m_buffer.data();
+        auto append = [&output](void const* data, std::size_t length)
+        {
+            if (length > 0)
+            {
+                std::memcpy(output, data, length);
+                output += length;
+            }
+        };
+
+        append(&header, sizeof(header));
+        append(m_strings.data(), m_strings.size() * sizeof(snapshot::StringRecord));
+        append(m_nodes.data(), m_nodes.size() * sizeof(snapshot::NodeRecord));
+        append(m_parameters.data(), m_parameters.size() * sizeof(snapshot::ParameterRecord));
+        append(m_enumEntries.data(), m_enumEntries.size() * sizeof(std::uint32_t));
+        append(m_stringData.data(), m_stringData.size());
+    }
+}
+}
@@ -0,0 +1,129 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBER_SERIALIZATION_SNAPSHOTWRITER_H
+#define __TINYEMBER_SERIALIZATION_SNAPSHOTWRITER_H
+
+#include <unordered_map>
+#include <vector>
+#include "../../gadget/Node.h"
+#include "../../gadget/ParameterTypeVisitor.h"
+#include "SnapshotFormat.h"
+
+/** Forward declarations */
+namespace serialization
+{
+    class Archive;
+    class AutoSave;
+}
+
+namespace serialization { namespace detail
+{
+    /**
+     * The snapshot writer stores the local gadget tree in the binary snapshot format
+     * described in SnapshotFormat.h. The complete file is generated in a single buffer.
+     */
+    class SnapshotWriter
+    {
+        friend class serialization::Archive;
+        friend class serialization::AutoSave;
+        typedef std::vector<char> Buffer;
+        public:
+            typedef Buffer::size_type size_type;
+
+            /**
+             * Returns the number of bytes of the snapshot.
+             * @return The number of bytes of the snapshot.
+             */
+            size_type size() const;
+
+            /**
+             * Returns a pointer to the first byte of the snapshot.
+             * @return A pointer to the first byte of the snapshot.
+             */
+            char const* data() const;
+
+        private:
+            /**
+             * Initializes a new SnapshotWriter.
+             * @param node The root node of the tree to store.
+             */
+            explicit SnapshotWriter(gadget::Node const* node);
+
+            /**
+             * Appends a node record and recursively adds the node's parameters and child nodes.
+             * @param node The node to add.
+             * @param parent The index of the parent's record or snapshot::NoParent.
+             */
+            void write(gadget::Node const* node, std::int32_t parent);
+
+            /**
+             * Appends a parameter record.
+             * @param parameter The parameter to add.
+             */
+            void write(gadget::Parameter const* parameter);
+
+            /**
+             * Returns the index of a string within the string table. The string is added
+             * to the table if it is not contained yet.
+             * @param value The string to look up.
+             * @return The index of the string within the string table.
+             */
+            std::uint32_t intern(String const& value);
+
+            /**
+             * Concatenates the header and all tables.
+             */
+            void finish();
+
+        private:
+            /**
+             * Copies the type specific properties of a parameter into its record.
+             */
+            class ValueWriter : public gadget::ParameterTypeVisitorConst
+            {
+                public:
+                    /**
+                     * Initializes a new ValueWriter.
+                     * @param writer The writer owning the string and enumeration tables.
+                     * @param record The record to fill.
+                     */
+                    ValueWriter(SnapshotWriter& writer, snapshot::ParameterRecord& record);
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::EnumParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::StringParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::IntegerParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::RealParameter const* parameter) const;
+
+                    /** @see ParameterTypeVisitorConst::visit() */
+                    virtual void visit(gadget::BooleanParameter const* parameter) const;
+
+                private:
+                    SnapshotWriter& m_writer;
+                    snapshot::ParameterRecord& m_record;
+            };
+
+            typedef std::unordered_map<String, std::uint32_t> StringIndex;
+
+            StringIndex m_stringIndex;
+            std::vector<snapshot::StringRecord> m_strings;
+            std::vector<snapshot::NodeRecord> m_nodes;
+            std::vector<snapshot::ParameterRecord> m_parameters;
+            std::vector<std::uint32_t> m_enumEntries;
+            String m_stringData;
+            Buffer m_buffer;
+    };
+}
+}
+
+#endif//__TINYEMBER_SERIALIZATION_SNAPSHOTWRITER_H
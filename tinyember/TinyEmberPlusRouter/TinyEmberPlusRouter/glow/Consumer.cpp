@@ -5,12 +5,11 @@
 */
 
 #include <iostream>
-#include <QtCore/QtCore>
+#include <memory>
 #include <ember/glow/GlowNodeFactory.hpp>
 #include <s101/CommandType.hpp>
 #include <s101/Dtd.hpp>
 #include <s101/PackageFlag.hpp>
-#include <s101/StreamEncoder.hpp>
 #include <s101/MessageType.hpp>
 #include "Dispatcher.h"
 #include "Encoder.h"
@@ -45,27 +44,37 @@ namespace glow
    //
    // ========================================================
 
-   Consumer::Consumer(QTcpSocket* socket, Dispatcher* dispatcher)
-      : TcpClient(socket)
+   Consumer::Consumer(libs101net::EventLoop& loop, int fd, Dispatcher* dispatcher)
+      : libs101net::Connection(loop, fd)
       , m_dispatcher(dispatcher)
       , m_reader(this)
    {}
 
    void Consumer::writeGlow(libember::glow::GlowContainer const* glow)
    {
-      auto encoder = Encoder::createEmberMessage(glow);
+      auto const encoder = Encoder::createEmberMessage(glow);
 
-      for(auto packet : encoder)
-         write(packet.begin(), packet.end());
+      write(std::make_shared<Buffer const>(encoder.toBytes()));
    }
 
-   void Consumer::read(const_iterator first, const_iterator last, size_type size)
+   void Consumer::addInterest(util::Oid const& path)
    {
-      std::cout << "received " << size << " bytes" << std::endl;
-      m_decoder.read(first, last, Consumer::onS101Message, this);
+      m_interests.insert(path);
    }
 
-   void Consumer::handleS101Message(Decoder::const_iterator first, Decoder::const_iterator last)
+   bool Consumer::isInterestedIn(util::Oid const& path) const
+   {
+      if(m_interests.empty())
+         return false;
+
+      if(m_interests.count(path) > 0)
+         return true;
+
+      return path.empty() == false
+          && m_interests.count(util::Oid(path.begin(), path.end() - 1)) > 0;
+   }
+
+   void Consumer::handleMessage(const_iterator first, const_iterator last)
    {
       first++;                                                   // Slot
       auto const message = *first++;                             // Message
@@ -95,35 +104,33 @@ namespace glow
                std::cerr << ex.what();
             }
          }
-         else if(command == libs101::CommandType::KeepAliveRequest)
-         {
-            auto encoder = libs101::StreamEncoder<unsigned char>();
-            encoder.encode(0x00);                                       // Slot
-            encoder.encode(libs101::MessageType::EmBER);                // Message Type
-            encoder.encode(libs101::CommandType::KeepAliveResponse);    // Command
-            encoder.encode(0x01);                                       // Framing Version (1)
-            encoder.finish();
-            write(encoder.begin(), encoder.end());
-         }
       }
    }
 
+   void Consumer::handleDisconnect()
+   {
+      auto const& metrics = receiveMetrics();
+
+      std::cout << "Consumer disconnected after receiving "
+                << metrics.bytes << " bytes in "
+                << metrics.reads << " reads and "
+                << metrics.messages << " messages" << std::endl;
+   }
+
    void Consumer::rootReady(libember::dom::Node* root)
    {
       m_reader.detachRoot();
 
-      auto glow = dynamic_cast<libember::glow::GlowContainer*>(root);
+      auto glow = libember::glow::GlowContainer::fromNode(root);
 
       if(glow != nullptr)
       {
          std::cout << "Received Glow" << std::endl;
-         m_dispatcher->receiveGlow(glow, this);
+         m_dispatcher->postGlow(glow, this);
+      }
+      else
+      {
+         delete root;
       }
-   }
-
-   //static 
-   void Consumer::onS101Message(Decoder::const_iterator first, Decoder::const_iterator last, Consumer* state)
-   {
-      state->handleS101Message(first, last);
    }
 }
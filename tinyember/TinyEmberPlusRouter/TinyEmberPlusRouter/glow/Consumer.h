@@ -7,19 +7,24 @@
 #ifndef __TINYEMBERROUTER_GLOW_CONSUMER_H
 #define __TINYEMBERROUTER_GLOW_CONSUMER_H
 
+#include <unordered_set>
 #include <ember/dom/AsyncDomReader.hpp>
 #include <ember/glow/GlowContainer.hpp>
-#include <s101/StreamDecoder.hpp>
-#include "../net/TcpClient.h"
+#include <s101net/Connection.hpp>
+#include "../util/Types.h"
 
 namespace glow
 {
    class Dispatcher;
 
-   class Consumer : public net::TcpClient
+   /**
+     * A connection to a remote consumer. The s101 framing and keep-alive
+     * handling is done by libs101net::Connection, inbound EmBER messages
+     * are decoded on the I/O thread and the decoded Glow trees are passed
+     * to the dispatcher.
+     */
+   class Consumer : public libs101net::Connection
    {
-      Q_OBJECT;
-
       /**
       * Implementation of an async DomReader which forwards decoded ember trees
       * to the consumer.
@@ -48,53 +53,68 @@ namespace glow
          Consumer *const m_consumer;
       };
 
-      typedef libs101::StreamDecoder<unsigned char> Decoder;
-
    public:
-      explicit Consumer(QTcpSocket* socket, Dispatcher* dispatcher);
+      /**
+        * Creates a new instance of Consumer.
+        * @param loop The event loop handling the socket.
+        * @param fd The accepted socket.
+        * @param dispatcher The dispatcher to pass the decoded trees to.
+        */
+      Consumer(libs101net::EventLoop& loop, int fd, Dispatcher* dispatcher);
 
       /**
         * Encode the passed Glow tree and write the encoded EmBER
-        * to the remote consumer.
+        * to the remote consumer. May be called from any thread.
         * @param glow The root of the Glow tree to encode.
         */
       void writeGlow(libember::glow::GlowContainer const* glow);
 
-   private:
       /**
-         * This method is called by the TcpClient when several bytes have been received. All bytes are
-         * forwarded to the s101 decoder.
-         * @param first Reference to the first byte that has been received.
-         * @param last Points the the first element beyond the rx buffer.
-         * @param size The number of bytes that have been received.
-         */
-      virtual void read(const_iterator first, const_iterator last, size_type size);
+        * Records that the consumer has issued a GetDirectory or Subscribe
+        * command on the element at @p path. Interests are kept until the
+        * consumer disconnects.
+        * @param path The path of the element.
+        */
+      void addInterest(util::Oid const& path);
 
       /**
-         * This method is called by the DomReader when a tree has been decoded.
-         * @param root The decoded tree.
-         */
-      void rootReady(libember::dom::Node* root);
+        * Returns true if the consumer knows the element at @p path, i.e. if
+        * it has issued a GetDirectory or Subscribe command on the element
+        * itself or on its parent.
+        * @param path The path of the element to test.
+        * @return True if notifications about the element must be sent to
+        *     the consumer.
+        */
+      bool isInterestedIn(util::Oid const& path) const;
 
+   protected:
       /**
-        * This method is called when a s101 message has been decoded.
+        * This method is called by the connection when a s101 message has been decoded.
+        * EmBER packages are forwarded to the DomReader.
         * @param first Reference to the first byte of the decoded s101 message.
         * @param last Points the the first element beyond the s101 message buffer.
         */
-      void handleS101Message(Decoder::const_iterator first, Decoder::const_iterator last);
+      virtual void handleMessage(const_iterator first, const_iterator last);
 
       /**
-        * Static callback for the s101 decoder.
-        * @param first Reference to the first byte that has been received.
-        * @param last Points the the first element beyond the rx buffer.
-        * @param state A pointer to the consumer that received the bytes passed.
+        * This method is called by the connection when the consumer has disconnected.
+        * Logs the receive counters of the connection.
         */
-      static void onS101Message(Decoder::const_iterator first, Decoder::const_iterator last, Consumer* state);
+      virtual void handleDisconnect();
+
+   private:
+      /**
+         * This method is called by the DomReader when a tree has been decoded.
+         * @param root The decoded tree.
+         */
+      void rootReady(libember::dom::Node* root);
 
    private:
+      typedef std::unordered_set<util::Oid, util::OidHash> OidSet;
+
       Dispatcher* m_dispatcher;
       DomReader m_reader;
-      Decoder m_decoder;
+      OidSet m_interests;
    };
 }
 
@@ -4,6 +4,7 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include <memory>
 #include "../model/model.h"
 #include "Consumer.h"
 #include "Encoder.h"
@@ -31,41 +32,44 @@ namespace glow
       {
          if(glow->number().value() == libember::glow::CommandType::GetDirectory)
          {
+            m_source->addInterest(path);
+
             auto glowRoot = libember::glow::GlowRootElementCollection::create();
 
-            if(dynamic_cast<model::ParameterBase*>(parent) != nullptr
-            || dynamic_cast<model::Function*>(parent) != nullptr)
+            auto const classifier = ElementClassifier(parent);
+
+            if(classifier.integerParameter != nullptr
+            || classifier.stringParameter != nullptr
+            || classifier.function != nullptr)
             {
                auto glowElement = m_dispatcher->elementToGlow(parent, glow->dirFieldMask().value(), false);
                glowRoot->insert(glowRoot->end(), glowElement);
             }
-            else if(dynamic_cast<model::matrix::Matrix*>(parent) != nullptr)
+            else if(classifier.matrix != nullptr)
             {
                auto glowElement = m_dispatcher->elementToGlow(parent, glow->dirFieldMask().value(), true);
                glowRoot->insert(glowRoot->end(), glowElement);
             }
-            else if(dynamic_cast<model::Node*>(parent) != nullptr)
+            else if(classifier.node != nullptr)
             {
                if(parent->empty())
-               {
                   glowRoot->insert(glowRoot->end(), new libember::glow::GlowQualifiedNode(parent->path())); // empty node
-               }
                else
-               {
-                  for(auto child : *parent)
-                  {
-                     auto glowElement = m_dispatcher->elementToGlow(child, glow->dirFieldMask().value(), false);
-                     glowRoot->insert(glowRoot->end(), glowElement);
-                  }
-               }
+                  writeChildren(parent, glow->dirFieldMask().value());
             }
 
-            m_source->writeGlow(glowRoot);
+            if(glowRoot->empty() == false)
+               m_source->writeGlow(glowRoot);
+
             delete glowRoot;
          }
+         else if(glow->number().value() == libember::glow::CommandType::Subscribe)
+         {
+            m_source->addInterest(path);
+         }
          else if(glow->number().value() == libember::glow::CommandType::Invoke)
          {
-            auto const function = dynamic_cast<model::Function*>(parent);
+            auto const function = ElementClassifier(parent).function;
             auto const invocation = glow->invocation();
 
             if(function != nullptr
@@ -95,6 +99,26 @@ namespace glow
       }
    }
 
+   void Dispatcher::GlowWalker::writeChildren(model::Element* parent, int dirFieldMask)
+   {
+      auto first = parent->begin();
+      auto const last = parent->end();
+
+      while(first != last)
+      {
+         auto glowRoot = libember::glow::GlowRootElementCollection::create();
+
+         for(auto count = 0; count < GetDirectoryChunkSize && first != last; count++, first++)
+         {
+            auto glowElement = m_dispatcher->elementToGlow(*first, dirFieldMask, false);
+            glowRoot->insert(glowRoot->end(), glowElement);
+         }
+
+         m_source->writeGlow(glowRoot);
+         delete glowRoot;
+      }
+   }
+
    void Dispatcher::GlowWalker::handleParameter(libember::glow::GlowParameterBase const* glow, libember::ber::ObjectIdentifier const& path)
    {
       auto lookup = model::Element::Lookup(m_dispatcher->m_root, path);
@@ -110,7 +134,7 @@ namespace glow
             {
                case libember::glow::ParameterType::Integer:
                {
-                  auto integerParameter = dynamic_cast<model::IntegerParameter*>(parent);
+                  auto integerParameter = ElementClassifier(parent).integerParameter;
 
                   if(integerParameter != nullptr)
                      integerParameter->setValue(glowValue.toInteger());
@@ -120,7 +144,7 @@ namespace glow
 
                case libember::glow::ParameterType::String:
                {
-                  auto stringParameter = dynamic_cast<model::StringParameter*>(parent);
+                  auto stringParameter = ElementClassifier(parent).stringParameter;
 
                   if(stringParameter != nullptr)
                      stringParameter->setValue(glowValue.toString());
@@ -139,7 +163,7 @@ namespace glow
 
       if(parent != nullptr)
       {
-         auto matrix = dynamic_cast<model::matrix::Matrix*>(parent);
+         auto matrix = ElementClassifier(parent).matrix;
 
          if(matrix != nullptr)
          {
@@ -147,12 +171,16 @@ namespace glow
 
             if(connections != nullptr)
             {
+               auto salvo = std::vector<model::matrix::Matrix::SalvoEntry>();
+
                for(libember::dom::Node const& ember : *connections)
                {
-                  auto connection = dynamic_cast<libember::glow::GlowConnection const*>(&ember);
+                  auto glowContainer = libember::glow::GlowContainer::fromNode(&ember);
 
-                  if(connection != nullptr)
+                  if(glowContainer != nullptr
+                  && glowContainer->type().value() == libember::glow::GlowType::Connection)
                   {
+                     auto connection = static_cast<libember::glow::GlowConnection const*>(glowContainer);
                      auto target = matrix->getTarget(connection->target());
 
                      if(target != nullptr)
@@ -168,16 +196,99 @@ namespace glow
                               sources.insert(sources.end(), source);
                         }
 
-                        matrix->connect(target, sources.begin(), sources.end(), m_source, connection->operation());
+                        salvo.push_back(model::matrix::Matrix::SalvoEntry(target, sources, connection->operation()));
                      }
                   }
                }
+
+               matrix->connect(salvo.begin(), salvo.end(), m_source);
             }
          }
       }
    }
 
 
+   // ========================================================
+   //
+   // Dispatcher::InterestFilter Definitions
+   //
+   // ========================================================
+
+   Dispatcher::InterestFilter::InterestFilter(std::vector<util::Oid> const& paths)
+      : m_paths(paths)
+   {}
+
+   bool Dispatcher::InterestFilter::operator()(libs101net::Connection* connection) const
+   {
+      auto consumer = static_cast<Consumer*>(connection);
+
+      for(auto const& path : m_paths)
+      {
+         if(consumer->isInterestedIn(path))
+            return true;
+      }
+
+      return false;
+   }
+
+
+   // ========================================================
+   //
+   // Dispatcher::ElementClassifier Definitions
+   //
+   // ========================================================
+
+   Dispatcher::ElementClassifier::ElementClassifier(model::Element* element)
+      : node(nullptr)
+      , integerParameter(nullptr)
+      , stringParameter(nullptr)
+      , function(nullptr)
+      , matrix(nullptr)
+   {
+      element->accept(this);
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::Node* element)
+   {
+      node = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::IntegerParameter* element)
+   {
+      integerParameter = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::StringParameter* element)
+   {
+      stringParameter = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::Function* element)
+   {
+      function = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::matrix::OneToNLinearMatrix* element)
+   {
+      matrix = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::matrix::NToNLinearMatrix* element)
+   {
+      matrix = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::matrix::NToNNonlinearMatrix* element)
+   {
+      matrix = element;
+   }
+
+   void Dispatcher::ElementClassifier::visit(model::matrix::DynamicNToNLinearMatrix* element)
+   {
+      matrix = element;
+   }
+
+
    // ========================================================
    //
    // Dispatcher::ElementToGlowConverter Definitions
@@ -314,14 +425,17 @@ namespace glow
 
          if(m_isCompleteMatrixEnquired)
          {
-            auto glowTargets = glow->targets();
-            auto glowSources = glow->sources();
+            auto glowTargets = glow->compactTargets();
+            auto glowSources = glow->compactSources();
+
+            glowTargets->reserve(element->targets().size());
+            glowSources->reserve(element->sources().size());
 
             for(auto signal : element->targets())
-               glowTargets->insert(glowTargets->end(), new libember::glow::GlowTarget(signal->number()));
+               glowTargets->insert(signal->number());
 
             for(auto signal : element->sources())
-               glowSources->insert(glowSources->end(), new libember::glow::GlowSource(signal->number()));
+               glowSources->insert(signal->number());
          }
       }
    }
@@ -363,23 +477,19 @@ namespace glow
       if(hasDirField(libember::glow::DirFieldMask::Connections)
       && m_isCompleteMatrixEnquired)
       {
-         auto glowConnections = glow->connections();
+         auto glowConnections = glow->compactConnections();
+         auto sourceNumbers = std::vector<int>();
+
+         glowConnections->reserve(element->targets().size(), 0);
 
          for(auto signal : element->targets())
          {
-            auto glowConnection = new libember::glow::GlowConnection(signal->number());
-
-            if(signal->connectedSources().empty() == false)
-            {
-               auto sourceNumbers = std::vector<int>();
+            sourceNumbers.clear();
 
-               for(auto source : signal->connectedSources())
-                  sourceNumbers.insert(sourceNumbers.end(), source->number());
+            for(auto source : signal->connectedSources())
+               sourceNumbers.push_back(source->number());
 
-               glowConnection->setSources(libember::ber::ObjectIdentifier(sourceNumbers.begin(), sourceNumbers.end()));
-            }
-
-            glowConnections->insert(glowConnections->end(), glowConnection);
+            glowConnections->insert(signal->number(), sourceNumbers.begin(), sourceNumbers.end());
          }
       }
 
@@ -393,58 +503,83 @@ namespace glow
    //
    // ========================================================
 
-   Dispatcher::Dispatcher(QObject* parent, int port)
-      : m_server(parent, this, port)
+   Dispatcher::Dispatcher(libs101net::EventLoop& loop, int port, int notificationInterval)
+      : m_worker(this)
+      , m_notifications(m_worker.loop(), this, notificationInterval)
+      , m_server(loop, this, static_cast<unsigned short>(port))
+      , m_root(nullptr)
    {}
 
-   void Dispatcher::notifyMatrixConnection(model::matrix::Matrix* matrix, model::matrix::Signal* target, void* state)
+   Dispatcher::~Dispatcher()
+   {
+      stop();
+   }
+
+   void Dispatcher::start()
+   {
+      m_worker.start();
+   }
+
+   void Dispatcher::stop()
+   {
+      m_worker.stop();
+   }
+
+   void Dispatcher::notifyMatrixConnection(model::matrix::Matrix* matrix, model::matrix::Signal* target, model::matrix::Signal::Vector const& previousSources, void* state)
+   {
+      auto changes = std::vector<model::matrix::ConnectionChange>();
+      changes.push_back(model::matrix::ConnectionChange(target, previousSources));
+
+      notifyMatrixConnections(matrix, changes, state);
+   }
+
+   void Dispatcher::notifyMatrixConnections(model::matrix::Matrix* matrix, std::vector<model::matrix::ConnectionChange> const& changes, void* /*state*/)
    {
       auto glow = libember::glow::GlowRootElementCollection::create();
       auto glowMatrix = new libember::glow::GlowQualifiedMatrix(matrix->path());
-      auto glowConnection = new libember::glow::GlowConnection(target->number());
 
-      auto sourceNumbers = std::vector<int>();
-      for(auto source : target->connectedSources())
-         sourceNumbers.insert(sourceNumbers.end(), source->number());
+      for(auto const& change : changes)
+      {
+         auto previousSourceNumbers = libember::ber::ObjectIdentifier();
+         for(auto source : change.previousSources)
+            previousSourceNumbers.push_back(source->number());
 
-      glowConnection->setSources(libember::ber::ObjectIdentifier(sourceNumbers.begin(), sourceNumbers.end()));
-      glowConnection->setDisposition(libember::glow::ConnectionDisposition::Modified);
+         auto sourceNumbers = libember::ber::ObjectIdentifier();
+         for(auto source : change.target->connectedSources())
+            sourceNumbers.push_back(source->number());
+
+         glowMatrix->insertConnectionChange(change.target->number(), previousSourceNumbers, sourceNumbers, libember::glow::ConnectionDisposition::Modified);
+      }
 
-      auto glowConnections = glowMatrix->connections();
-      glowConnections->insert(glowConnections->end(), glowConnection);
       glow->insert(glow->end(), glowMatrix);
 
-      writeGlow(glow);
+      writeGlow(glow, std::vector<util::Oid>(1, matrix->path()));
       delete glow;
    }
 
    void Dispatcher::notifyParameterValueChanged(util::Oid const& parameterPath, int value)
    {
-      auto glow = libember::glow::GlowRootElementCollection::create();
-      auto glowParam = new libember::glow::GlowQualifiedParameter(parameterPath);
-      glowParam->setValue(value);
-
-      glow->insert(glow->end(), glowParam);
-
-      writeGlow(glow);
-      delete glow;
+      m_notifications.enqueue(parameterPath, util::VariantValue(static_cast<long>(value)));
    }
 
    void Dispatcher::notifyParameterValueChanged(util::Oid const& parameterPath, std::string const& value)
    {
-      auto glow = libember::glow::GlowRootElementCollection::create();
-      auto glowParam = new libember::glow::GlowQualifiedParameter(parameterPath);
-      glowParam->setValue(value);
+      m_notifications.enqueue(parameterPath, util::VariantValue(value));
+   }
 
-      glow->insert(glow->end(), glowParam);
+   libs101net::Connection* Dispatcher::create(libs101net::EventLoop& loop, int fd)
+   {
+      return new Consumer(loop, fd, this);
+   }
 
-      writeGlow(glow);
-      delete glow;
+   void Dispatcher::release(libs101net::Connection* connection)
+   {
+      m_worker.postRelease(connection);
    }
 
-   net::TcpClient* Dispatcher::create(QTcpSocket* socket)
+   void Dispatcher::postGlow(libember::glow::GlowContainer* glow, Consumer* source)
    {
-      return new Consumer(socket, this);
+      m_worker.postGlow(glow, source);
    }
 
    void Dispatcher::receiveGlow(libember::glow::GlowContainer const* glow, Consumer* source)
@@ -461,11 +596,11 @@ namespace glow
       return converter.detachResult();
    }
 
-   void Dispatcher::writeGlow(libember::glow::GlowContainer const* glow)
+   void Dispatcher::writeGlow(libember::glow::GlowContainer const* glow, std::vector<util::Oid> const& paths)
    {
-      auto encoder = Encoder::createEmberMessage(glow);
+      auto const encoder = Encoder::createEmberMessage(glow);
+      auto const buffer = std::make_shared<libs101net::Connection::Buffer const>(encoder.toBytes());
 
-      for(auto packet : encoder)
-         m_server.write(packet.begin(), packet.end());
+      m_server.write(buffer, InterestFilter(paths));
    }
 }
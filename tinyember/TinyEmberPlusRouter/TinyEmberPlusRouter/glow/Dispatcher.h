@@ -7,10 +7,11 @@
 #ifndef __TINYEMBERROUTER_GLOW_DISPATCHER_H
 #define __TINYEMBERROUTER_GLOW_DISPATCHER_H
 
-#include <QtCore/QtCore>
+#include <s101net/EventLoop.hpp>
+#include <s101net/Server.hpp>
 #include "../model/NotificationSink.h"
-#include "../net/TcpClientFactory.h"
-#include "../net/TcpServer.h"
+#include "ModelWorker.h"
+#include "NotificationQueue.h"
 #include "Walker.h"
 #include "../model/Element.h"
 #include "../model/ElementVisitor.h"
@@ -20,14 +21,21 @@ namespace glow
     class Consumer;
    /**
      * The application's Ember+ front-end.
-     * Aggregates net::TcpServer to listen for inbound connections from consumers.
+     * Aggregates libs101net::Server to listen for inbound connections from consumers.
      * Handles inbound Ember+ packages.
      * Creates and dispatches spontaneous Ember+ updates to consumers.
-     * Implements two interfaces: model::NotificationSink and net::TcpClientFactory.
+     * Implements two interfaces: model::NotificationSink and libs101net::ConnectionFactory.
+     * Once started, the DOM is owned by a dedicated model thread. The sockets,
+     * the s101 framing and the decoding of inbound Ember+ packages remain on
+     * the thread running the server's event loop, decoded Glow trees are
+     * handed over to the model thread, and the packages encoded there are
+     * posted back to the consumers.
      */
-   class Dispatcher : public model::NotificationSink, public net::TcpClientFactory
+   class Dispatcher : public model::NotificationSink, public libs101net::ConnectionFactory
    {
       friend class glow::Consumer;
+      friend class glow::ModelWorker;
+      friend class glow::NotificationQueue;
       friend class glow::Walker;
 
 
@@ -68,12 +76,105 @@ namespace glow
            */
          virtual void handleMatrix(libember::glow::GlowMatrixBase const* glow, libember::ber::ObjectIdentifier const& path);
 
+      private:
+         /**
+           * The maximum number of children encoded into a single
+           * GetDirectory response message.
+           */
+         enum { GetDirectoryChunkSize = 64 };
+
+         /**
+           * Responds to a GetDirectory command on @p parent by sending the
+           * children of @p parent in messages of at most GetDirectoryChunkSize
+           * elements each. Each message is converted, encoded and written
+           * before the next one is created, which bounds the size of the
+           * Glow tree held in memory and lets the consumer process the first
+           * children while the remaining ones are still being encoded.
+           * @param parent The element whose children to send.
+           * @param dirFieldMask The EmberPlus-Glow.FieldFlags values
+           *     indicating the fields to send.
+           */
+         void writeChildren(model::Element* parent, int dirFieldMask);
+
       private:
          Dispatcher* m_dispatcher;
          Consumer* m_source;
       };
 
 
+   // ========================================================
+   //
+   // Dispatcher::InterestFilter Declaration
+   //
+   // ========================================================
+
+   private:
+      /**
+        * Function object passed to libs101net::Server::write which accepts all
+        * consumers that are interested in at least one of the elements
+        * a notification refers to.
+        */
+      class InterestFilter
+      {
+      public:
+         /**
+           * Creates a new instance of InterestFilter.
+           * @param paths The paths of the elements contained in the notification.
+           */
+         explicit InterestFilter(std::vector<util::Oid> const& paths);
+
+         /**
+           * Returns true if @p connection is interested in the notification.
+           * @param connection A connection created by Dispatcher::create.
+           */
+         bool operator()(libs101net::Connection* connection) const;
+
+      private:
+         std::vector<util::Oid> const& m_paths;
+      };
+
+   // ========================================================
+   //
+   // Dispatcher::ElementClassifier Declaration
+   //
+   // ========================================================
+
+   private:
+      /**
+        * Implements interface ElementVisitor to determine the concrete
+        * type of an Element object without using dynamic_cast.
+        * After construction, exactly one of the public members that
+        * matches the visited element is set, while all others are nullptr.
+        */
+      class ElementClassifier : public model::ElementVisitor
+      {
+      public:
+         /**
+           * Creates a new instance of ElementClassifier and visits
+           * the passed @p element.
+           * @param element The element to classify.
+           */
+         explicit ElementClassifier(model::Element* element);
+
+      public:
+         virtual void visit(model::Node* element);
+         virtual void visit(model::IntegerParameter* element);
+         virtual void visit(model::StringParameter* element);
+         virtual void visit(model::Function* element);
+         virtual void visit(model::matrix::OneToNLinearMatrix* element);
+         virtual void visit(model::matrix::NToNLinearMatrix* element);
+         virtual void visit(model::matrix::NToNNonlinearMatrix* element);
+         virtual void visit(model::matrix::DynamicNToNLinearMatrix* element);
+
+      public:
+         model::Node* node;
+         model::IntegerParameter* integerParameter;
+         model::StringParameter* stringParameter;
+         model::Function* function;
+         model::matrix::Matrix* matrix;
+      };
+
+
    // ========================================================
    //
    // Dispatcher::ElementToGlowConverter Declaration
@@ -183,12 +284,32 @@ namespace glow
 
    public:
       /**
-        * Creates a new instance of Dispatcher, starting a TcpServer
+        * Creates a new instance of Dispatcher, starting a Server
         * on the passed @p port.
-        * @param parent The Qt object to parent the aggregated TcpServer.
-        * @param port The port the aggregated TcpServer should listen on.
+        * @param loop The event loop handling the sockets of the aggregated Server.
+        * @param port The port the aggregated Server should listen on.
+        * @param notificationInterval The interval in milliseconds to collect
+        *     parameter value changes before they are sent to the consumers.
+        *     If zero, each change is sent immediately.
         */
-      Dispatcher(QObject* parent, int port);
+      Dispatcher(libs101net::EventLoop& loop, int port, int notificationInterval);
+
+      /** Destructor, stops the model thread. */
+      virtual ~Dispatcher();
+
+      /**
+        * Starts the model thread. From then on, the DOM must only be
+        * accessed by the model thread, which is why the tree must have
+        * been created and passed to setRoot before.
+        */
+      void start();
+
+      /**
+        * Stops the model thread and waits until it has finished. After
+        * this method returns, the DOM may be accessed (and deleted) by the
+        * calling thread again.
+        */
+      void stop();
 
       // --------------------- properties
       /**
@@ -211,36 +332,70 @@ namespace glow
       /**
         * Implemented to send GlowConnection objects to all connected consumers
         * when a matrix connection has changed in the DOM.
+        * The change is reported either as absolute connection or as
+        * connect/disconnect delta, whichever encodes to fewer bytes.
+        */
+      virtual void notifyMatrixConnection(model::matrix::Matrix* matrix, model::matrix::Signal* target, model::matrix::Signal::Vector const& previousSources, void* state);
+
+      /**
+        * Implemented to send the GlowConnection objects of all targets
+        * changed by a salvo to all connected consumers in a single message.
+        * Each change is reported as in notifyMatrixConnection.
         */
-      virtual void notifyMatrixConnection(model::matrix::Matrix* matrix, model::matrix::Signal* target, void* state);
+      virtual void notifyMatrixConnections(model::matrix::Matrix* matrix, std::vector<model::matrix::ConnectionChange> const& changes, void* state);
 
       /**
         * Implemented to send GlowQualifiedParameter objects to all connected consumers
         * when a parameter value has changed in the DOM.
+        * The value is enqueued in the notification queue, which only sends
+        * the latest value of each parameter per flush interval.
         */
       virtual void notifyParameterValueChanged(util::Oid const& parameterPath, int value);
 
       /**
         * Implemented to send GlowQualifiedParameter objects to all connected consumers
         * when a parameter value has changed in the DOM.
+        * The value is enqueued in the notification queue, which only sends
+        * the latest value of each parameter per flush interval.
         */
       virtual void notifyParameterValueChanged(util::Oid const& parameterPath, std::string const& value);
 
 
-      // --------------------- net::TcpClientFactory implementation
+      // --------------------- libs101net::ConnectionFactory implementation
       /**
-        * Implemented to create Consumer objects when a new TcpClient has connected.
+        * Implemented to create Consumer objects when a new connection has been accepted.
         */
-      virtual net::TcpClient* create(QTcpSocket* socket);
+      virtual libs101net::Connection* create(libs101net::EventLoop& loop, int fd);
+
+      /**
+        * Implemented to delete the Consumer on its own thread after the model
+        * thread has handled all trees the consumer has sent.
+        */
+      virtual void release(libs101net::Connection* connection);
 
    private:
+      /**
+        * Hands a decoded Glow tree over to the model thread.
+        * @param glow The decoded Glow tree. The dispatcher takes ownership.
+        * @param source The consumer that sent the tree.
+        */
+      void postGlow(libember::glow::GlowContainer* glow, Consumer* source);
+
       void receiveGlow(libember::glow::GlowContainer const* glow, Consumer* source);
       libember::glow::GlowElement* elementToGlow(model::Element* element, int dirFieldMask, bool isCompleteMatrixEnquired) const;
 
-      void writeGlow(libember::glow::GlowContainer const* glow);
+      /**
+        * Encodes @p glow once and sends the encoded packets to all consumers
+        * which are interested in at least one of the passed @p paths.
+        * @param glow The notification to send.
+        * @param paths The paths of the elements contained in @p glow.
+        */
+      void writeGlow(libember::glow::GlowContainer const* glow, std::vector<util::Oid> const& paths);
 
    private:
-      net::TcpServer m_server;
+      ModelWorker m_worker;
+      NotificationQueue m_notifications;
+      libs101net::Server m_server;
       model::Element* m_root;
    };
 }
@@ -85,4 +85,19 @@ namespace glow
    {
       return m_packets.size();
    }
+
+   std::vector<unsigned char> Encoder::toBytes() const
+   {
+      auto length = Packet::size_type(0);
+      for(auto const& packet : m_packets)
+         length += packet.size();
+
+      auto bytes = std::vector<unsigned char>();
+      bytes.reserve(length);
+
+      for(auto const& packet : m_packets)
+         bytes.insert(bytes.end(), packet.begin(), packet.end());
+
+      return bytes;
+   }
 }
@@ -108,6 +108,13 @@ namespace glow
              */
             size_type size() const;
 
+            /**
+             * Concatenates all s101 packets into a single buffer, which can be written
+             * to the socket at once.
+             * @return A buffer containing the bytes of all packets in their order.
+             */
+            std::vector<unsigned char> toBytes() const;
+
         private:
             /**
              * Initializes a new Encoder instance and generates the s101 packets from the
@@ -0,0 +1,56 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <memory>
+#include "Consumer.h"
+#include "Dispatcher.h"
+#include "ModelWorker.h"
+
+namespace glow
+{
+   ModelWorker::ModelWorker(Dispatcher* dispatcher)
+      : m_dispatcher(dispatcher)
+   {}
+
+   ModelWorker::~ModelWorker()
+   {
+      stop();
+   }
+
+   void ModelWorker::start()
+   {
+      if(m_thread.joinable() == false)
+         m_thread = std::thread([this] { m_loop.run(); });
+   }
+
+   void ModelWorker::stop()
+   {
+      if(m_thread.joinable())
+      {
+         m_loop.stop();
+         m_thread.join();
+      }
+   }
+
+   void ModelWorker::postGlow(libember::glow::GlowContainer* glow, Consumer* source)
+   {
+      auto const tree = std::shared_ptr<libember::glow::GlowContainer>(glow);
+      auto const dispatcher = m_dispatcher;
+
+      m_loop.post([dispatcher, tree, source]
+      {
+         dispatcher->receiveGlow(tree.get(), source);
+      });
+   }
+
+   void ModelWorker::postRelease(libs101net::Connection* connection)
+   {
+      m_loop.post([connection]
+      {
+         connection->loop().post([connection] { delete connection; });
+      });
+   }
+}
@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBERROUTER_GLOW_MODELWORKER_H
+#define __TINYEMBERROUTER_GLOW_MODELWORKER_H
+
+#include <thread>
+#include <ember/glow/GlowContainer.hpp>
+#include <s101net/Connection.hpp>
+#include <s101net/EventLoop.hpp>
+
+namespace glow
+{
+   class Consumer;
+   class Dispatcher;
+
+   /**
+     * Runs the model thread and receives the work items handed over to it.
+     * Everything the posted work items call - walking inbound Glow trees,
+     * changing the DOM, encoding responses and notifications - runs on the
+     * model thread, while the sockets, the s101 framing and the decoding of
+     * inbound trees stay on the I/O thread.
+     * Work items are posted to the worker's event loop, which executes them
+     * in the order they have been posted.
+     */
+   class ModelWorker
+   {
+   public:
+      /**
+        * Creates a new instance of ModelWorker.
+        * @param dispatcher The dispatcher which handles the work items.
+        */
+      explicit ModelWorker(Dispatcher* dispatcher);
+
+      /** Destructor, stops the model thread. */
+      ~ModelWorker();
+
+      /**
+        * Returns the event loop of the model thread.
+        * @return The event loop of the model thread.
+        */
+      inline libs101net::EventLoop& loop() { return m_loop; }
+
+      /**
+        * Starts the model thread.
+        */
+      void start();
+
+      /**
+        * Stops the model thread and waits until it has finished.
+        * Work items that have not been handled yet are discarded.
+        */
+      void stop();
+
+      /**
+        * Hands a decoded Glow tree over to the model thread.
+        * May be called from any thread.
+        * @param glow The decoded Glow tree. The worker takes ownership.
+        * @param source The consumer that sent the tree.
+        */
+      void postGlow(libember::glow::GlowContainer* glow, Consumer* source);
+
+      /**
+        * Hands a disconnected connection over to the model thread. Since the
+        * connection does not decode any trees after it has disconnected, all
+        * trees it has sent are handled before the release. The connection is
+        * then deleted by the thread that runs its event loop, after the data
+        * the model thread has written to it.
+        * May be called from any thread.
+        * @param connection The disconnected connection.
+        */
+      void postRelease(libs101net::Connection* connection);
+
+   private:
+      Dispatcher* const m_dispatcher;
+      libs101net::EventLoop m_loop;
+      std::thread m_thread;
+   };
+}
+
+#endif//__TINYEMBERROUTER_GLOW_MODELWORKER_H
@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <ember/Ember.hpp>
+#include "Dispatcher.h"
+#include "NotificationQueue.h"
+
+namespace glow
+{
+   NotificationQueue::NotificationQueue(libs101net::EventLoop& loop, Dispatcher* dispatcher, int flushInterval)
+      : m_loop(loop)
+      , m_dispatcher(dispatcher)
+      , m_timer(0)
+      , m_flushInterval(flushInterval)
+   {}
+
+   NotificationQueue::~NotificationQueue()
+   {
+      if(m_timer != 0)
+         m_loop.stopTimer(m_timer);
+   }
+
+   void NotificationQueue::setFlushInterval(int value)
+   {
+      m_flushInterval = value;
+
+      if(value <= 0)
+         flush();
+   }
+
+   void NotificationQueue::enqueue(util::Oid const& parameterPath, util::VariantValue const& value)
+   {
+      auto const result = m_indices.find(parameterPath);
+
+      if(result != m_indices.end())
+      {
+         m_entries[result->second].second = value;
+      }
+      else
+      {
+         m_indices.insert(std::make_pair(parameterPath, m_entries.size()));
+         m_entries.push_back(std::make_pair(parameterPath, value));
+      }
+
+      if(m_flushInterval <= 0)
+         flush();
+      else if(m_timer == 0)
+         m_timer = m_loop.startTimer(m_flushInterval, [this]
+         {
+            m_timer = 0;
+            flush();
+         });
+   }
+
+   void NotificationQueue::flush()
+   {
+      if(m_timer != 0)
+      {
+         m_loop.stopTimer(m_timer);
+         m_timer = 0;
+      }
+
+      if(m_entries.empty())
+         return;
+
+      auto glow = libember::glow::GlowRootElementCollection::create();
+      auto paths = std::vector<util::Oid>();
+
+      paths.reserve(m_entries.size());
+
+      for(auto const& entry : m_entries)
+      {
+         paths.push_back(entry.first);
+
+         auto glowParam = new libember::glow::GlowQualifiedParameter(entry.first);
+
+         if(entry.second.type().value() == libember::glow::ParameterType::String)
+            glowParam->setValue(entry.second.toString());
+         else
+            glowParam->setValue(entry.second.toInteger());
+
+         glow->insert(glow->end(), glowParam);
+      }
+
+      m_indices.clear();
+      m_entries.clear();
+
+      m_dispatcher->writeGlow(glow, paths);
+      delete glow;
+   }
+}
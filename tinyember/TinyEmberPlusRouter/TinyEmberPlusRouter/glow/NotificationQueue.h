@@ -0,0 +1,83 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBERROUTER_GLOW_NOTIFICATIONQUEUE_H
+#define __TINYEMBERROUTER_GLOW_NOTIFICATIONQUEUE_H
+
+#include <unordered_map>
+#include <vector>
+#include <s101net/EventLoop.hpp>
+#include "../util/Types.h"
+
+namespace glow
+{
+   class Dispatcher;
+
+   /**
+     * Coalesces parameter value notifications issued by the DOM.
+     * Only the latest value of each parameter is kept. All pending values
+     * are sent to the consumers in a single GlowRootElementCollection when
+     * the flush interval has elapsed after the first pending value has been
+     * enqueued, which bounds the rate of outbound messages regardless of
+     * the rate of inbound value changes.
+     */
+   class NotificationQueue
+   {
+   public:
+      /**
+        * Creates a new instance of NotificationQueue.
+        * @param loop The event loop of the thread that changes the DOM.
+        *     The flush timer runs on this loop.
+        * @param dispatcher The dispatcher used to send the flushed values.
+        * @param flushInterval The interval in milliseconds to collect
+        *     values before they are sent. If zero, values are sent immediately.
+        */
+      NotificationQueue(libs101net::EventLoop& loop, Dispatcher* dispatcher, int flushInterval);
+
+      /** Destructor, stops a pending flush timer. */
+      ~NotificationQueue();
+
+      /**
+        * Returns the interval in milliseconds to collect values before
+        * they are sent.
+        * @return The flush interval in milliseconds.
+        */
+      inline int flushInterval() const { return m_flushInterval; }
+
+      /**
+        * Sets the interval in milliseconds to collect values before they
+        * are sent. Setting the interval to zero flushes pending values.
+        * @param value The flush interval in milliseconds.
+        */
+      void setFlushInterval(int value);
+
+      /**
+        * Enqueues the value of the parameter at @p parameterPath, replacing
+        * a pending value of the same parameter.
+        * @param parameterPath Path of the parameter that changed.
+        * @param value The new parameter value.
+        */
+      void enqueue(util::Oid const& parameterPath, util::VariantValue const& value);
+
+      /**
+        * Sends all pending values in a single message.
+        */
+      void flush();
+
+   private:
+      typedef std::unordered_map<util::Oid, std::size_t, util::OidHash> IndexMap;
+      typedef std::vector<std::pair<util::Oid, util::VariantValue> > EntryVector;
+
+      libs101net::EventLoop& m_loop;
+      Dispatcher* m_dispatcher;
+      libs101net::EventLoop::TimerId m_timer;
+      int m_flushInterval;
+      IndexMap m_indices;
+      EntryVector m_entries;
+   };
+}
+
+#endif//__TINYEMBERROUTER_GLOW_NOTIFICATIONQUEUE_H
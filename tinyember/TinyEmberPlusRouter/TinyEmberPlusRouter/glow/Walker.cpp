@@ -12,7 +12,7 @@ namespace glow
    {
       using libember::glow::GlowType;
 
-      switch(glow->typeTag().number())
+      switch(glow->type().value())
       {
          case GlowType::Command:
             handleCommand(static_cast<libember::glow::GlowCommand const*>(glow), pathToOid());
@@ -200,10 +200,11 @@ namespace glow
    {
       for(libember::dom::Node const& ember : *glow)
       {
-         auto streamEntry = dynamic_cast<libember::glow::GlowStreamEntry const*>(&ember);
+         auto child = libember::glow::GlowContainer::fromNode(&ember);
 
-         if(streamEntry != nullptr)
-            handleStreamEntry(streamEntry);
+         if(child != nullptr
+         && child->type().value() == libember::glow::GlowType::StreamEntry)
+            handleStreamEntry(static_cast<libember::glow::GlowStreamEntry const*>(child));
       }
    }
 }
@@ -111,7 +111,7 @@ namespace glow
    {
       for( ; first != last; first++)
       {
-         auto glow = dynamic_cast<libember::glow::GlowContainer const*>(std::addressof(*first));
+         auto glow = libember::glow::GlowContainer::fromNode(std::addressof(*first));
 
          if(glow != nullptr)
             walk(glow);
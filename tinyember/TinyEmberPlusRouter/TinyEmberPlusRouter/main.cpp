@@ -4,16 +4,22 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include <csignal>
+#include <cstdio>
 #include <iostream>
 #include <sstream>
-#include <QtCore>
-#include <QtCore/QCoreApplication>
+#include <thread>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+#include <s101net/EventLoop.hpp>
 #include "model/model.h"
 #include "glow/Dispatcher.h"
 
 
 #define VERSION_STRING "1.8.3"
 #define TCP_PORT 9092
+#define NOTIFICATION_INTERVAL 20
 
 // =====================================================
 //
@@ -268,44 +274,49 @@ model::Element* createTree(glow::Dispatcher* dispatcher)
 
 // =====================================================
 //
-// Qt console reading
+// Shutdown
 //
 // =====================================================
 
-class ConsoleReaderThread : public QThread
+/**
+  * Stops the event loop when SIGINT or SIGTERM is received, which is how
+  * the router is stopped when it runs as a service without a console.
+  * The signals must be blocked in all threads, so the mask is set before
+  * any thread is started.
+  */
+class SignalHandler : public libs101net::EventHandler
 {
-   Q_OBJECT
-
-protected:
-   void run()
+public:
+   explicit SignalHandler(libs101net::EventLoop& loop)
+      : m_loop(loop)
    {
-      std::cout << "Tiny Ember+ Router v"
-                << VERSION_STRING
-                << " listening on port "
-                << TCP_PORT
-                << ". Press enter to quit..."
-                << std::endl;
-
-      fgetc(stdin);
+      sigemptyset(&m_signals);
+      sigaddset(&m_signals, SIGINT);
+      sigaddset(&m_signals, SIGTERM);
+      pthread_sigmask(SIG_BLOCK, &m_signals, nullptr);
+
+      m_fd = signalfd(-1, &m_signals, SFD_NONBLOCK | SFD_CLOEXEC);
+      m_loop.add(m_fd, EPOLLIN, this);
    }
-};
 
-class Task : public QObject
-{
-   Q_OBJECT
-public:
-   Task(QObject *parent = 0) : QObject(parent) {}
+   virtual ~SignalHandler()
+   {
+      m_loop.remove(m_fd);
+      close(m_fd);
+   }
 
-public slots:
-   void run()
+   virtual void handleEvents(std::uint32_t)
    {
-      ConsoleReaderThread* thread = new ConsoleReaderThread();
-      thread->start();
-      QObject::connect(thread, SIGNAL(finished()), parent(), SLOT(quit()));
+      auto info = signalfd_siginfo();
+      while(read(m_fd, &info, sizeof(info)) == sizeof(info))
+         m_loop.stop();
    }
-};
 
-#include "main.moc"
+private:
+   libs101net::EventLoop& m_loop;
+   sigset_t m_signals;
+   int m_fd;
+};
 
 
 // =====================================================
@@ -314,22 +325,39 @@ public slots:
 //
 // =====================================================
 
-int main(int argc, char *argv[])
+int main(int, char*[])
 {
-    QCoreApplication a(argc, argv);
+    libs101net::EventLoop loop;
+    SignalHandler signalHandler(loop);
 
     std::unique_ptr<glow::Dispatcher> dispatcher;
-    dispatcher.reset(new glow::Dispatcher(&a, TCP_PORT));
+    dispatcher.reset(new glow::Dispatcher(loop, TCP_PORT, NOTIFICATION_INTERVAL));
     auto root = createTree(dispatcher.get());
     dispatcher->setRoot(root);
-
-    // Task will be deleted by the application object.
-    auto task = new Task(&a);
-
-    // run the task from the application event loop.
-    QTimer::singleShot(0, task, SLOT(run()));
-
-    auto result = a.exec();
+    dispatcher->start();
+
+    std::cout << "Tiny Ember+ Router v"
+              << VERSION_STRING
+              << " listening on port "
+              << TCP_PORT
+              << "."
+              << std::endl;
+
+    // Reading the console blocks, so it is done by a separate thread,
+    // which is left behind if the router is stopped by a signal.
+    if(isatty(STDIN_FILENO))
+    {
+       std::cout << "Press enter to quit..." << std::endl;
+
+       std::thread([&loop]
+       {
+          fgetc(stdin);
+          loop.stop();
+       }).detach();
+    }
+
+    loop.run();
+    dispatcher->stop();
     delete root;
-    return result;
+    return 0;
 }
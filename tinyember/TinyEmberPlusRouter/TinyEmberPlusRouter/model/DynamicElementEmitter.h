@@ -21,10 +21,13 @@ namespace model
    {
    public:
       /**
-        * Creates a new descendant Element representing the parameter
+        * Returns a descendant Element representing the parameter
         * or node at the passed path.
-        * @return A new instance of a class derived from Element,
-        *    which must be freed by the caller.
+        * @return An instance of a class derived from Element, or nullptr
+        *    if the path does not address a dynamic descendant. The
+        *    returned object is owned by the emitter and may be reused
+        *    by the next call to emitDescendant, so callers must not
+        *    keep or delete it.
         */
       virtual Element* emitDescendant(util::Oid const& path) = 0;
    };
@@ -4,6 +4,7 @@
     (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 */
 
+#include <algorithm>
 #include "Node.h"
 #include "DynamicElementEmitter.h"
 
@@ -13,44 +14,81 @@ namespace model
       : m_number(number)
       , m_parent(parent)
       , m_identifier(identifier)
-      , m_path(nullptr)
    {
       if(parent != nullptr)
+      {
+         m_path = parent->path();
+         m_path.push_back(number);
+
          parent->insert(parent->end(), this);
+      }
    }
 
    Element::~Element()
    {
       for(auto child : *this)
          delete child;
+   }
 
-      if(m_path != nullptr)
-         delete m_path;
+   Element::iterator Element::insert(iterator where, Element* child)
+   {
+      auto const result = m_children.insert(where, child);
+      indexChild(child);
+      return result;
    }
 
-   util::Oid Element::path() const
+   void Element::indexChild(Element* child)
    {
-      if(m_path == nullptr)
-      {
-         auto ids = std::vector<std::size_t>();
+      auto const number = child->number();
+      auto const denseLimit = std::max<std::size_t>(64, 2 * m_children.size());
 
-         for(auto elem = this; elem->isRoot() == false; elem = elem->parent())
-            ids.insert(ids.end(), (std::size_t)elem->number());
+      if(number >= 0 && static_cast<std::size_t>(number) < denseLimit)
+      {
+         if(static_cast<std::size_t>(number) >= m_denseIndex.size())
+            m_denseIndex.resize(number + 1, nullptr);
 
-         m_path = new util::Oid(ids.rbegin(), ids.rend());
+         if(m_denseIndex[number] == nullptr)
+            m_denseIndex[number] = child;
       }
+      else
+      {
+         m_sparseIndex.insert(std::make_pair(number, child));
+      }
+   }
 
-      return *m_path;
+   DynamicElementEmitter* Element::dynamicElementEmitter()
+   {
+      return nullptr;
+   }
+
+   void Element::setPath(util::Oid const& value)
+   {
+      m_path = value;
+
+      if(value.empty() == false)
+         m_number = *(value.end() - 1);
+   }
+
+   void Element::setPath(util::Oid const& parentPath, int number)
+   {
+      m_path = parentPath;
+      m_path.push_back(number);
+      m_number = number;
    }
 
    Element* Element::findDescendant(util::Oid const& path, bool& isDynamic) const
    {
+      isDynamic = false;
+
+      auto const cached = m_descendantCache.find(path);
+
+      if(cached != m_descendantCache.end())
+         return cached->second;
+
       auto elem = (Element*)this;
       auto first = path.begin();
       auto last = path.end();
 
-      isDynamic = false;
-
       for( ; first != last; first++)
       {
          auto number = *first;
@@ -58,7 +96,7 @@ namespace model
 
          if(child == nullptr)
          {
-            auto dynamic = dynamic_cast<DynamicElementEmitter*>(elem);
+            auto dynamic = elem->dynamicElementEmitter();
 
             if(dynamic != nullptr)
             {
@@ -75,18 +113,22 @@ namespace model
          elem = child;
       }
 
+      m_descendantCache.insert(std::make_pair(path, elem));
       return elem;
    }
 
    Element* Element::findChild(int number) const
    {
-      for(auto child : m_children)
+      if(number >= 0 && static_cast<std::size_t>(number) < m_denseIndex.size())
       {
-         if(child->number() == number)
+         auto const child = m_denseIndex[number];
+
+         if(child != nullptr)
             return child;
       }
 
-      return nullptr;
+      auto const result = m_sparseIndex.find(number);
+      return result != m_sparseIndex.end() ? result->second : nullptr;
    }
 
    // static
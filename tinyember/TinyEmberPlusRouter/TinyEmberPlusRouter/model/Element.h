@@ -8,12 +8,14 @@
 #define __TINYEMBERROUTER_MODEL_ELEMENT_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "../util/Types.h"
 
 namespace model
 {
    class ElementVisitor;
+   class DynamicElementEmitter;
 
    /**
      * Abstract base class for all types that make up the local DOM,
@@ -38,8 +40,7 @@ namespace model
    // ========================================================
    public:
       /**
-        * Helper class for looking up Elements
-        * and automatically deleting them if necessary.
+        * Helper class for looking up Elements.
         */
       class Lookup
       {
@@ -51,14 +52,16 @@ namespace model
          Lookup(model::Element const* root, util::Oid const& path);
 
          /**
-           * Deletes the result of the lookup if necessary.
+           * Returns the result of the lookup.
            */
-         ~Lookup();
+         inline model::Element* result() const { return m_result; }
 
          /**
-           * Returns the result of the lookup.
+           * Returns true if the result has been emitted by a
+           * DynamicElementEmitter. Such a result is only valid until
+           * the next lookup that addresses the same emitter.
            */
-         inline model::Element* result() const { return m_result; }
+         inline bool isDynamic() const { return m_isDynamic; }
 
       private:
          model::Element* m_result;
@@ -96,7 +99,7 @@ namespace model
       inline const_iterator begin() const { return m_children.begin(); }
       inline iterator end() { return m_children.end(); }
       inline const_iterator end() const { return m_children.end(); }
-      inline iterator insert(iterator where, Element* child) { return m_children.insert(where, child); }
+      iterator insert(iterator where, Element* child);
 
 
    // ========================================================
@@ -154,6 +157,9 @@ namespace model
    public:
       /**
         * Looks for a child element with the passed number.
+        * Children with small, non-negative numbers are stored in a
+        * vector indexed by number, all others in a hash map, so the
+        * lookup does not depend on the number of children.
         * @param number The number of the child to find.
         * @return Either a pointer to the found child or nullptr.
         */
@@ -167,35 +173,75 @@ namespace model
       static Element* createRoot();
 
       /**
-        * Returns the path to this element.
+        * Returns the path to this element. The path is computed once
+        * when the element is created, so this accessor does not allocate.
         * @Return the path to this element.
         */
-      virtual util::Oid path() const;
+      inline util::Oid const& path() const { return m_path; }
 
       /**
         * Accepts a visitor of type ElementVisitor.
         */
       virtual void accept(ElementVisitor* visitor) = 0;
 
+      /**
+        * Returns the DynamicElementEmitter interface of this element.
+        * @return A pointer to the DynamicElementEmitter interface if this
+        *     element emits descendant elements on-the-fly, otherwise nullptr.
+        */
+      virtual DynamicElementEmitter* dynamicElementEmitter();
+
+   protected:
+      /**
+        * Replaces the path and number of this element. Used by elements
+        * emitted on-the-fly, which are not entered in the collection of
+        * children of their logical parent and may be reused for other paths.
+        * @param value The path of this element. The last component of the
+        *     path becomes the number of this element.
+        */
+      void setPath(util::Oid const& value);
+
+      /**
+        * Replaces the path and number of this element with @p parentPath
+        * extended by @p number.
+        * @param parentPath The path of the logical parent of this element.
+        * @param number The number of this element.
+        */
+      void setPath(util::Oid const& parentPath, int number);
+
    private:
       /**
         * Walks down the passed @p path, finding the descendant the
         * path points to.
         * @param path The path to resolve.
         * @param isDynamic Receives the value true if the returned
-        *     Element was created on-the-fly by an Element implementing
+        *     Element was emitted on-the-fly by an Element implementing
         *     the DynamicElementEmitter interface.
-        *     In this case, the returned object must be deleted by the caller.
+        *     In this case, the returned object is owned by the emitter.
+        * @note Static descendants are cached by path, since elements are
+        *     never removed from the tree.
         */
       Element* findDescendant(util::Oid const& path, bool& isDynamic) const;
 
+      /**
+        * Enters the passed @p child in the index used by findChild().
+        * @param child The child to index.
+        */
+      void indexChild(Element* child);
+
    private:
+      typedef std::unordered_map<int, Element*> SparseIndex;
+      typedef std::unordered_map<util::Oid, Element*, util::OidHash> DescendantCache;
+
       int m_number;
       std::string m_identifier;
       std::string m_description;
       Element* m_parent;
       Vector m_children;
-      mutable util::Oid* m_path;
+      Vector m_denseIndex;
+      SparseIndex m_sparseIndex;
+      mutable DescendantCache m_descendantCache;
+      util::Oid m_path;
    };
 
 
@@ -209,12 +255,6 @@ namespace model
    {
       m_result = root->findDescendant(path, m_isDynamic);
    }
-
-   inline Element::Lookup::~Lookup()
-   {
-      if(m_result != nullptr && m_isDynamic)
-         delete m_result;
-   }
 }
 
 #endif//__TINYEMBERROUTER_MODEL_ELEMENT_H
@@ -8,13 +8,33 @@
 #define __TINYEMBERROUTER_MODEL_NOTIFICATIONSINK_H
 
 #include "../util/Types.h"
+#include "matrix/Signal.h"
 
 namespace model
 {
    namespace matrix
    {
       class Matrix;
-      class Signal;
+
+      /**
+        * Describes the change of the sources connected to a single target.
+        */
+      struct ConnectionChange
+      {
+         /**
+           * Creates a new instance of ConnectionChange.
+           * @param target Pointer to the target object that changed.
+           * @param previousSources The sources that were connected to
+           *     @p target before the change.
+           */
+         ConnectionChange(Signal* target, Signal::Vector const& previousSources)
+            : target(target)
+            , previousSources(previousSources)
+         {}
+
+         Signal* target;
+         Signal::Vector previousSources;
+      };
    }
 
    /**
@@ -27,9 +47,20 @@ namespace model
         * Implement this method to handle connection changes from matrices.
         * @param matrix Pointer to the matrix object the connection change was issued on.
         * @param target Pointer to the target object that changed.
-        * @param target State passed through by the caller that initiated the change.
+        * @param previousSources The sources that were connected to @p target
+        *     before the change.
+        * @param state State passed through by the caller that initiated the change.
+        */
+      virtual void notifyMatrixConnection(matrix::Matrix* matrix, matrix::Signal* target, matrix::Signal::Vector const& previousSources, void* state) = 0;
+
+      /**
+        * Implement this method to handle the connection changes of a salvo
+        * issued on a matrix. Each target is contained at most once.
+        * @param matrix Pointer to the matrix object the salvo was issued on.
+        * @param changes The changes of all targets modified by the salvo.
+        * @param state State passed through by the caller that initiated the change.
         */
-      virtual void notifyMatrixConnection(matrix::Matrix* matrix, matrix::Signal* target, void* state) = 0;
+      virtual void notifyMatrixConnections(matrix::Matrix* matrix, std::vector<matrix::ConnectionChange> const& changes, void* state) = 0;
 
       /**
         * Implement this method to handle integer parameter value changes.
@@ -0,0 +1,132 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include <algorithm>
+#include "CrosspointStore.h"
+
+namespace model { namespace matrix
+{
+   // ========================================================
+   //
+   // CrosspointStore Definitions
+   //
+   // ========================================================
+
+   CrosspointStore::~CrosspointStore()
+   {}
+
+
+   // ========================================================
+   //
+   // DenseCrosspointStore Definitions
+   //
+   // ========================================================
+
+   DenseCrosspointStore::DenseCrosspointStore(int targetCount, int sourceCount)
+      : m_targetCount(targetCount)
+      , m_sourceCount(sourceCount)
+      , m_bits(targetCount * sourceCount, false)
+   {}
+
+   bool DenseCrosspointStore::contains(int target, int source) const
+   {
+      auto index = indexOf(target, source);
+
+      return index >= 0 && m_bits[index];
+   }
+
+   bool DenseCrosspointStore::insert(int target, int source)
+   {
+      auto index = indexOf(target, source);
+
+      if(index < 0 || m_bits[index])
+         return false;
+
+      m_bits[index] = true;
+      return true;
+   }
+
+   bool DenseCrosspointStore::erase(int target, int source)
+   {
+      auto index = indexOf(target, source);
+
+      if(index < 0 || m_bits[index] == false)
+         return false;
+
+      m_bits[index] = false;
+      return true;
+   }
+
+   void DenseCrosspointStore::clear(int target)
+   {
+      if(target >= 0 && target < m_targetCount)
+      {
+         auto first = m_bits.begin() + target * m_sourceCount;
+
+         std::fill(first, first + m_sourceCount, false);
+      }
+   }
+
+   int DenseCrosspointStore::indexOf(int target, int source) const
+   {
+      if(target < 0 || target >= m_targetCount
+      || source < 0 || source >= m_sourceCount)
+         return -1;
+
+      return target * m_sourceCount + source;
+   }
+
+
+   // ========================================================
+   //
+   // SparseCrosspointStore Definitions
+   //
+   // ========================================================
+
+   bool SparseCrosspointStore::contains(int target, int source) const
+   {
+      auto result = m_sources.find(target);
+
+      if(result == m_sources.end())
+         return false;
+
+      return std::binary_search(result->second.begin(), result->second.end(), source);
+   }
+
+   bool SparseCrosspointStore::insert(int target, int source)
+   {
+      auto& sources = m_sources[target];
+      auto where = std::lower_bound(sources.begin(), sources.end(), source);
+
+      if(where != sources.end() && *where == source)
+         return false;
+
+      sources.insert(where, source);
+      return true;
+   }
+
+   bool SparseCrosspointStore::erase(int target, int source)
+   {
+      auto result = m_sources.find(target);
+
+      if(result == m_sources.end())
+         return false;
+
+      auto& sources = result->second;
+      auto where = std::lower_bound(sources.begin(), sources.end(), source);
+
+      if(where == sources.end() || *where != source)
+         return false;
+
+      sources.erase(where);
+      return true;
+   }
+
+   void SparseCrosspointStore::clear(int target)
+   {
+      m_sources.erase(target);
+   }
+}}
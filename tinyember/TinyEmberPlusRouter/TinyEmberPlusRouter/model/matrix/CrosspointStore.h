@@ -0,0 +1,116 @@
+/*
+    Copyright (C) 2012-2016 Lawo GmbH (http://www.lawo.com).
+    Distributed under the Boost Software License, Version 1.0.
+    (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef __TINYEMBERROUTER_MODEL_MATRIX_CROSSPOINTSTORE_H
+#define __TINYEMBERROUTER_MODEL_MATRIX_CROSSPOINTSTORE_H
+
+#include <unordered_map>
+#include <vector>
+
+namespace model { namespace matrix
+{
+   /**
+     * Abstract base class for the set of connected crosspoints of a matrix,
+     * addressed by target and source number. A matrix keeps its store in sync
+     * with the connected sources of its targets, which allows connects,
+     * disconnects and membership tests without scanning the connected sources
+     * of a target.
+     */
+   class CrosspointStore
+   {
+   public:
+      /**
+        * Destructor.
+        */
+      virtual ~CrosspointStore();
+
+      /**
+        * Returns true if @p source is connected to @p target.
+        * @param target The number of the target.
+        * @param source The number of the source.
+        * @return True if the crosspoint is connected.
+        */
+      virtual bool contains(int target, int source) const = 0;
+
+      /**
+        * Marks the crosspoint of @p target and @p source as connected.
+        * @param target The number of the target.
+        * @param source The number of the source.
+        * @return True if the crosspoint has not been connected before.
+        */
+      virtual bool insert(int target, int source) = 0;
+
+      /**
+        * Marks the crosspoint of @p target and @p source as disconnected.
+        * @param target The number of the target.
+        * @param source The number of the source.
+        * @return True if the crosspoint has been connected before.
+        */
+      virtual bool erase(int target, int source) = 0;
+
+      /**
+        * Marks all crosspoints of @p target as disconnected.
+        * @param target The number of the target.
+        */
+      virtual void clear(int target) = 0;
+   };
+
+
+   /**
+     * Crosspoint store for matrices with linear addressing mode, which stores
+     * one bit per crosspoint. All operations run in constant time.
+     */
+   class DenseCrosspointStore : public CrosspointStore
+   {
+   public:
+      /**
+        * Creates a new instance of DenseCrosspointStore.
+        * @param targetCount The number of targets of the matrix.
+        * @param sourceCount The number of sources of the matrix.
+        */
+      DenseCrosspointStore(int targetCount, int sourceCount);
+
+      virtual bool contains(int target, int source) const;
+      virtual bool insert(int target, int source);
+      virtual bool erase(int target, int source);
+      virtual void clear(int target);
+
+   private:
+      /**
+        * Returns the index of the bit for the passed crosspoint,
+        * or -1 if the crosspoint is out of range.
+        */
+      int indexOf(int target, int source) const;
+
+   private:
+      int m_targetCount;
+      int m_sourceCount;
+      std::vector<bool> m_bits;
+   };
+
+
+   /**
+     * Crosspoint store for matrices with non-linear addressing mode, which
+     * stores a sorted vector of source numbers per target. Operations run in
+     * logarithmic time with respect to the number of sources connected to
+     * a target.
+     */
+   class SparseCrosspointStore : public CrosspointStore
+   {
+   public:
+      virtual bool contains(int target, int source) const;
+      virtual bool insert(int target, int source);
+      virtual bool erase(int target, int source);
+      virtual void clear(int target);
+
+   private:
+      typedef std::unordered_map<int, std::vector<int> > Map;
+
+      Map m_sources;
+   };
+}}
+
+#endif//__TINYEMBERROUTER_MODEL_MATRIX_CROSSPOINTSTORE_H
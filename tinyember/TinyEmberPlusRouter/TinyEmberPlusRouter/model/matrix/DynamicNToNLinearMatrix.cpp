@@ -17,9 +17,8 @@ namespace model { namespace matrix
    //
    // ========================================================
 
-   DynamicNToNLinearMatrix::DynamicNode::DynamicNode(util::Oid const& path)
-      : Node(*(path.end() - 1), nullptr, "")
-      , m_path(path)
+   DynamicNToNLinearMatrix::DynamicNode::DynamicNode()
+      : Node(0, nullptr, "")
    {}
 
 
@@ -30,23 +29,14 @@ namespace model { namespace matrix
    //
    // ========================================================
 
-   DynamicNToNLinearMatrix::DynamicIntegerParameter::DynamicIntegerParameter(util::Oid const& path,
-                                                                             Element* parent,
-                                                                             std::string identifier,
-                                                                             DynamicNToNLinearMatrix* owner,
-                                                                             int value,
-                                                                             int minimum,
-                                                                             int maximum)
-      : IntegerParameter(*(path.end() - 1), parent, identifier, owner->notificationSink(), minimum, maximum)
+   DynamicNToNLinearMatrix::DynamicIntegerParameter::DynamicIntegerParameter(Element* parent, DynamicNToNLinearMatrix* owner)
+      : IntegerParameter(owner->gainParameterNumber(), parent, "gain", owner->notificationSink(), owner->minimumGain(), owner->maximumGain())
       , m_owner(owner)
-      , m_path(path)
-   {
-      setValueSilent(value);
-   }
+   {}
 
    void DynamicNToNLinearMatrix::DynamicIntegerParameter::onValueChanged()
    {
-      if(m_owner->onParameterValueChanged(m_path, value()))
+      if(m_owner->onParameterValueChanged(path(), value()))
          IntegerParameter::onValueChanged();
    }
 
@@ -70,12 +60,19 @@ namespace model { namespace matrix
 
       for(auto index = 0; index < xpointCount; index++)
          m_xpointGains[index] = minimumGain();
+
+      m_dynamicNode = new DynamicNode();
+      m_dynamicNodeGain = new DynamicIntegerParameter(m_dynamicNode, this);
+      m_dynamicGain = new DynamicIntegerParameter(nullptr, this);
    }
 
    DynamicNToNLinearMatrix::~DynamicNToNLinearMatrix()
    {
       if(m_xpointGains != nullptr)
          delete [] m_xpointGains;
+
+      delete m_dynamicNode;
+      delete m_dynamicGain;
    }
 
    void DynamicNToNLinearMatrix::accept(ElementVisitor* visitor)
@@ -83,9 +80,14 @@ namespace model { namespace matrix
       visitor->visit(this);
    }
 
+   DynamicElementEmitter* DynamicNToNLinearMatrix::dynamicElementEmitter()
+   {
+      return this;
+   }
+
    bool DynamicNToNLinearMatrix::connectOverride(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation)
    {
-      return detail::connectNToN(target, sources, state, operation);
+      return detail::connectNToN(target, sources, crosspoints(), state, operation);
    }
 
    bool DynamicNToNLinearMatrix::onParameterValueChanged(util::Oid const& path, int value)
@@ -127,24 +129,20 @@ namespace model { namespace matrix
          {
             if(path.size() == offset + 4) // return node "parameters/<targetNumber>/<sourceNumber>"
             {
-               auto node = new DynamicNode(path);
-               auto gainPath = std::vector<int>(path.begin(), path.end());
-               gainPath.insert(gainPath.end(), gainParameterNumber());
-
-               auto gain = new DynamicIntegerParameter(util::Oid(gainPath.begin(), gainPath.end()),
-                                                       node,
-                                                       "gain",
-                                                       this,
-                                                       m_xpointGains[index],
-                                                       minimumGain(),
-                                                       maximumGain());
-
-               return node;
+               m_dynamicNode->setPath(path);
+               m_dynamicNodeGain->setPath(path, gainParameterNumber());
+               m_dynamicNodeGain->setValueSilent(m_xpointGains[index]);
+               return m_dynamicNode;
             }
             else // return parameter "parameters/<targetNumber>/<sourceNumber>/<gainParameterNumber>"
             {
-               if(path[offset + 4] == gainParameterNumber())
-                  return new DynamicIntegerParameter(path, nullptr, "gain", this, m_xpointGains[index], minimumGain(), maximumGain());
+               if(path.size() == offset + 5
+               && path[offset + 4] == gainParameterNumber())
+               {
+                  m_dynamicGain->setPath(path);
+                  m_dynamicGain->setValueSilent(m_xpointGains[index]);
+                  return m_dynamicGain;
+               }
             }
          }
       }
@@ -32,14 +32,11 @@ namespace model { namespace matrix
       {
          friend class DynamicNToNLinearMatrix;
 
-         DynamicNode(util::Oid const& path);
-
          /**
-           * Overridden to return m_path.
+           * Creates a new instance of DynamicNode, which has no path
+           * until it is emitted.
            */
-         virtual util::Oid path() const { return m_path; }
-
-         util::Oid m_path;
+         DynamicNode();
       };
 
 
@@ -54,25 +51,20 @@ namespace model { namespace matrix
       {
          friend class DynamicNToNLinearMatrix;
 
-         DynamicIntegerParameter(util::Oid const& path,
-                                 Element* parent,
-                                 std::string identifier,
-                                 DynamicNToNLinearMatrix* owner,
-                                 int value,
-                                 int minimum, int maximum);
-
          /**
-           * Overridden to notify owner of inbound parameter change.
+           * Creates a new "gain" parameter, which has no path until
+           * it is emitted.
+           * @param parent The parent to enter the parameter in, or nullptr.
+           * @param owner The matrix owning the parameter.
            */
-         virtual void onValueChanged();
+         DynamicIntegerParameter(Element* parent, DynamicNToNLinearMatrix* owner);
 
          /**
-           * Overridden to return m_path.
+           * Overridden to notify owner of inbound parameter change.
            */
-         virtual util::Oid path() const { return m_path; }
+         virtual void onValueChanged();
 
          DynamicNToNLinearMatrix* m_owner;
-         util::Oid m_path;
       };
 
 
@@ -131,6 +123,11 @@ namespace model { namespace matrix
         */
       virtual void accept(ElementVisitor* visitor);
 
+      /**
+        * Overridden to return this object's DynamicElementEmitter interface.
+        */
+      virtual DynamicElementEmitter* dynamicElementEmitter();
+
    protected:
       /**
         * Overridden to execute connects according to N:N connection semantics.
@@ -146,12 +143,19 @@ namespace model { namespace matrix
    private:
       int* m_xpointGains;
 
+      // flyweights returned by emitDescendant
+      DynamicNode* m_dynamicNode;
+      DynamicIntegerParameter* m_dynamicNodeGain;
+      DynamicIntegerParameter* m_dynamicGain;
+
    // ========================================================
    // DynamicElementEmitter Members
    // ========================================================
    public:
       /**
         * Implemented to emit descendant Elements on-the-fly.
+        * Instead of allocating new objects for each request, one node
+        * and one parameter are retargeted to the requested crosspoint.
         */
       virtual Element* emitDescendant(util::Oid const& path);
    };
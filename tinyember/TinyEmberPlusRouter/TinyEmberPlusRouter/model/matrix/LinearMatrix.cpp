@@ -9,7 +9,7 @@
 namespace model { namespace matrix
 {
    LinearMatrix::LinearMatrix(int number, Element* parent, std::string const& identifier, NotificationSink* notificationSink, int targetCount, int sourceCount)
-      : Matrix(number, parent, identifier, notificationSink)
+      : Matrix(number, parent, identifier, notificationSink, new DenseCrosspointStore(targetCount, sourceCount))
    {
       auto& targets = this->targets();
       auto& sources = this->sources();
@@ -8,9 +8,10 @@
 
 namespace model { namespace matrix
 {
-   Matrix::Matrix(int number, Element* parent, std::string const& identifier, NotificationSink* notificationSink)
+   Matrix::Matrix(int number, Element* parent, std::string const& identifier, NotificationSink* notificationSink, CrosspointStore* crosspoints)
       : Element(number, parent, identifier)
       , m_notificationSink(notificationSink)
+      , m_crosspoints(crosspoints)
    {}
 
    Matrix::~Matrix()
@@ -20,5 +21,7 @@ namespace model { namespace matrix
 
       for(auto signal : m_sources)
          delete signal;
+
+      delete m_crosspoints;
    }
 }}
@@ -8,11 +8,13 @@
 #define __TINYEMBERROUTER_MODEL_MATRIX_MATRIX_H
 
 #include "../Element.h"
+#include "CrosspointStore.h"
 #include "Signal.h"
 #include "../NotificationSink.h"
 #include "../../util/Collection.h"
 #include "../../util/Types.h"
 #include <stdexcept>
+#include <unordered_set>
 
 namespace model { namespace matrix
 {
@@ -21,6 +23,30 @@ namespace model { namespace matrix
      */
    class Matrix : public Element
    {
+   public:
+      /**
+        * A single connect operation of a salvo.
+        * @see Matrix::connect(SalvoIterator, SalvoIterator, void*)
+        */
+      struct SalvoEntry
+      {
+         /**
+           * Creates a new instance of SalvoEntry.
+           * @param target Pointer to the target to connect to.
+           * @param sources The sources to connect.
+           * @param operation The connect operation to issue.
+           */
+         SalvoEntry(Signal* target, Signal::Vector const& sources, util::ConnectOperation const& operation)
+            : target(target)
+            , sources(sources)
+            , operation(operation)
+         {}
+
+         Signal* target;
+         Signal::Vector sources;
+         util::ConnectOperation operation;
+      };
+
    public:
       /**
         * Creates a new instance of DynamicNToNLinearMatrix.
@@ -30,8 +56,10 @@ namespace model { namespace matrix
         * @param identifier The identifier used for Ember+ automation.
         * @param notificationSink The object to notify of parameter value changes
         *     and matrix connections.
+        * @param crosspoints The store used to track connected crosspoints.
+        *     The matrix takes ownership of the passed object.
         */
-      Matrix(int number, Element* parent, std::string const& identifier, NotificationSink* notificationSink);
+      Matrix(int number, Element* parent, std::string const& identifier, NotificationSink* notificationSink, CrosspointStore* crosspoints);
 
       /**
         * Destructor.
@@ -107,6 +135,27 @@ namespace model { namespace matrix
       template<typename InputIterator>
       void connect(Signal* target, InputIterator firstSource, InputIterator lastSource, void* state);
 
+      /**
+        * Issues the connect operations in the range [@p first, @p last) as
+        * one salvo. All entries are validated before any of them is applied,
+        * and the notification sink is notified once with the changes of all
+        * modified targets.
+        * @param first Forward iterator pointing to the first SalvoEntry.
+        * @param last Forward iterator pointing behind the last SalvoEntry.
+        * @param state Caller-defined state to be passed through.
+        */
+      template<typename SalvoIterator>
+      void connect(SalvoIterator first, SalvoIterator last, void* state);
+
+      /**
+        * Returns true if the source with number @p source is connected
+        * to the target with number @p target.
+        * @param target The number of the target.
+        * @param source The number of the source.
+        * @return True if the crosspoint is connected.
+        */
+      inline bool isConnected(int target, int source) const { return m_crosspoints->contains(target, source); }
+
       /**
         * Returns the number of targets owned by the matrix.
         * @return The number of targets owned by the matrix.
@@ -134,6 +183,13 @@ namespace model { namespace matrix
       virtual Signal* getSource(int number) const = 0;
 
    protected:
+      /**
+        * Returns the crosspoint store which must be passed to
+        * Signal::connect and Signal::disconnect for targets of this matrix.
+        * @return The crosspoint store of this matrix.
+        */
+      inline CrosspointStore& crosspoints() { return *m_crosspoints; }
+
       /**
         * Implement this method in a derived class to issue connects
         * according to specific connection semantics.
@@ -145,10 +201,19 @@ namespace model { namespace matrix
         */
       virtual bool connectOverride(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation) = 0;
 
+   private:
+      /**
+        * Throws std::runtime_error if @p target or the first source in
+        * [@p firstSource, @p lastSource) is not owned by the matrix.
+        */
+      template<typename InputIterator>
+      void validateConnect(Signal* target, InputIterator firstSource, InputIterator lastSource) const;
+
    private:
       Signal::Vector m_targets;
       Signal::Vector m_sources;
       NotificationSink* m_notificationSink;
+      CrosspointStore* m_crosspoints;
       util::Oid m_labelsPath;
    };
 
@@ -162,19 +227,13 @@ namespace model { namespace matrix
    template<typename InputIterator>
    inline void Matrix::connect(Signal* target, InputIterator firstSource, InputIterator lastSource, void* state, util::ConnectOperation const& operation)
    {
-      if(util::contains(m_targets.begin(), m_targets.end(), target) == false)
-         throw std::runtime_error("target");
-
-      if(firstSource != lastSource)
-      {
-         if(util::contains(m_sources.begin(), m_sources.end(), *firstSource) == false)
-            throw std::runtime_error("sources");
-      }
+      validateConnect(target, firstSource, lastSource);
 
       auto sources = Signal::Vector(firstSource, lastSource);
+      auto previousSources = target->connectedSources();
 
       if(connectOverride(target, sources, state, operation))
-         m_notificationSink->notifyMatrixConnection(this, target, state);
+         m_notificationSink->notifyMatrixConnection(this, target, previousSources, state);
    }
 
    template<typename InputIterator>
@@ -182,6 +241,44 @@ namespace model { namespace matrix
    {
       connect(target, firstSource, lastSource, state, util::ConnectOperation::Absolute);
    }
+
+   template<typename SalvoIterator>
+   inline void Matrix::connect(SalvoIterator first, SalvoIterator last, void* state)
+   {
+      for(auto entry = first; entry != last; entry++)
+         validateConnect(entry->target, entry->sources.begin(), entry->sources.end());
+
+      auto changes = std::vector<ConnectionChange>();
+      auto changedTargets = std::unordered_set<Signal*>();
+
+      for( ; first != last; first++)
+      {
+         auto target = first->target;
+         auto previousSources = target->connectedSources();
+
+         // a target connected repeatedly is reported once, relative to
+         // the sources connected before the salvo
+         if(connectOverride(target, first->sources, state, first->operation)
+         && changedTargets.insert(target).second)
+            changes.push_back(ConnectionChange(target, previousSources));
+      }
+
+      if(changes.empty() == false)
+         m_notificationSink->notifyMatrixConnections(this, changes, state);
+   }
+
+   template<typename InputIterator>
+   inline void Matrix::validateConnect(Signal* target, InputIterator firstSource, InputIterator lastSource) const
+   {
+      if(getTarget(target->number()) != target)
+         throw std::runtime_error("target");
+
+      if(firstSource != lastSource)
+      {
+         if(getSource((*firstSource)->number()) != *firstSource)
+            throw std::runtime_error("sources");
+      }
+   }
 }}
 
 #endif//__TINYEMBERROUTER_MODEL_MATRIX_MATRIX_H
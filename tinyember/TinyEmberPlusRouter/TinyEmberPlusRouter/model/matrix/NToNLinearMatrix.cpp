@@ -21,6 +21,6 @@ namespace model { namespace matrix
 
    bool NToNLinearMatrix::connectOverride(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation)
    {
-      return detail::connectNToN(target, sources, state, operation);
+      return detail::connectNToN(target, sources, crosspoints(), state, operation);
    }
 }}
@@ -8,6 +8,59 @@
 
 namespace model { namespace matrix
 {
+   void NonlinearMatrix::addTarget(Signal* target)
+   {
+      auto& targets = this->targets();
+
+      targets.insert(targets.end(), target);
+      m_targetIndex[target->number()] = target;
+   }
+
+   void NonlinearMatrix::addSource(Signal* source)
+   {
+      auto& sources = this->sources();
+
+      sources.insert(sources.end(), source);
+      m_sourceIndex[source->number()] = source;
+   }
+
+   bool NonlinearMatrix::removeTarget(int number)
+   {
+      crosspoints().clear(number);
+      return removeSignal(targets(), m_targetIndex, number);
+   }
+
+   bool NonlinearMatrix::removeSource(int number)
+   {
+      auto const source = getSource(number);
+
+      if(source == nullptr)
+         return false;
+
+      for(auto target : targets())
+         target->disconnect(&source, &source + 1, crosspoints());
+
+      return removeSignal(sources(), m_sourceIndex, number);
+   }
+
+   bool NonlinearMatrix::removeSignal(Signal::Vector& collection, SignalIndex& index, int number)
+   {
+      auto const result = index.find(number);
+
+      if(result == index.end())
+         return false;
+
+      auto const signal = result->second;
+      auto const where = util::find(collection.begin(), collection.end(), signal);
+
+      if(where != collection.end())
+         collection.erase(where);
+
+      index.erase(result);
+      delete signal;
+      return true;
+   }
+
    // overrides
 
    int NonlinearMatrix::targetCount() const
@@ -22,23 +75,13 @@ namespace model { namespace matrix
 
    Signal* NonlinearMatrix::getTarget(int number) const
    {
-      for(auto signal : targets())
-      {
-         if(signal->number() == number)
-            return signal;
-      }
-
-      return nullptr;
+      auto const result = m_targetIndex.find(number);
+      return result != m_targetIndex.end() ? result->second : nullptr;
    }
 
    Signal* NonlinearMatrix::getSource(int number) const
    {
-      for(auto signal : sources())
-      {
-         if(signal->number() == number)
-            return signal;
-      }
-
-      return nullptr;
+      auto const result = m_sourceIndex.find(number);
+      return result != m_sourceIndex.end() ? result->second : nullptr;
    }
 }}
@@ -7,6 +7,7 @@
 #ifndef __TINYEMBERROUTER_MODEL_MATRIX_NONLINEARMATRIX_H
 #define __TINYEMBERROUTER_MODEL_MATRIX_NONLINEARMATRIX_H
 
+#include <unordered_map>
 #include "Matrix.h"
 
 namespace model { namespace matrix
@@ -42,6 +43,40 @@ namespace model { namespace matrix
                       SignalIterator firstTarget, SignalIterator lastTarget,
                       SignalIterator firstSource, SignalIterator lastSource);
 
+      /**
+        * Appends a target to the matrix and enters it in the index used
+        * by getTarget(). The matrix takes ownership of @p target.
+        * Targets added after construction must be added using this
+        * method rather than by modifying the collection returned by
+        * targets() directly.
+        * @param target The target to add. Its number must not be used
+        *     by another target of the matrix.
+        */
+      void addTarget(Signal* target);
+
+      /**
+        * Appends a source to the matrix and enters it in the index used
+        * by getSource(). The matrix takes ownership of @p source.
+        * @param source The source to add. Its number must not be used
+        *     by another source of the matrix.
+        */
+      void addSource(Signal* source);
+
+      /**
+        * Removes and deletes the target with the specified number.
+        * @param number The number of the target to remove.
+        * @return True if the target has been found and removed.
+        */
+      bool removeTarget(int number);
+
+      /**
+        * Removes and deletes the source with the specified number,
+        * after disconnecting it from all targets.
+        * @param number The number of the source to remove.
+        * @return True if the source has been found and removed.
+        */
+      bool removeSource(int number);
+
    // overrides
    public:
       /**
@@ -65,6 +100,19 @@ namespace model { namespace matrix
         * Overridden to find the source with the specified number.
         */
       virtual Signal* getSource(int number) const;
+
+   private:
+      typedef std::unordered_map<int, Signal*> SignalIndex;
+
+      /**
+        * Removes the signal with the specified number from both
+        * @p collection and @p index and deletes it.
+        */
+      static bool removeSignal(Signal::Vector& collection, SignalIndex& index, int number);
+
+   private:
+      SignalIndex m_targetIndex;
+      SignalIndex m_sourceIndex;
    };
 
 
@@ -81,13 +129,13 @@ namespace model { namespace matrix
                                     NotificationSink* notificationSink,
                                     SignalIterator firstTarget, SignalIterator lastTarget,
                                     SignalIterator firstSource, SignalIterator lastSource)
-      : Matrix(number, parent, identifier, notificationSink)
+      : Matrix(number, parent, identifier, notificationSink, new SparseCrosspointStore())
    {
-      auto& targets = this->targets();
-      auto& sources = this->sources();
+      for( ; firstTarget != lastTarget; firstTarget++)
+         addTarget(*firstTarget);
 
-      targets.insert(targets.end(), firstTarget, lastTarget);
-      sources.insert(sources.end(), firstSource, lastSource);
+      for( ; firstSource != lastSource; firstSource++)
+         addSource(*firstSource);
    }
 }}
 
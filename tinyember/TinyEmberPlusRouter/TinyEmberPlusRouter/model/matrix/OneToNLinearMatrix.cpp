@@ -22,6 +22,6 @@ namespace model { namespace matrix
 
    bool OneToNLinearMatrix::connectOverride(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation)
    {
-      return detail::connectOneToN(target, sources, state, operation);
+      return detail::connectOneToN(target, sources, crosspoints(), state, operation);
    }
 }}
@@ -8,7 +8,7 @@
 #define __TINYEMBERROUTER_MODEL_MATRIX_SIGNAL_H
 
 #include <vector>
-#include "../../util/Collection.h"
+#include "CrosspointStore.h"
 
 namespace model { namespace matrix
 {
@@ -25,11 +25,29 @@ namespace model { namespace matrix
       inline Vector const& connectedSources() const { return m_connectedSources; }
 
       // methods
+      /**
+        * Connects the sources in the range [@p firstSource, @p lastSource)
+        * to this target. Sources which are already connected are ignored.
+        * @param firstSource Iterator pointing to the first source to connect.
+        * @param lastSource Iterator pointing behind the last source to connect.
+        * @param isAbsolute If true, all sources not contained in the range
+        *     are disconnected.
+        * @param crosspoints The crosspoint store of the matrix owning this
+        *     target, which is kept in sync with the connected sources.
+        */
       template<typename InputIterator>
-      void connect(InputIterator firstSource, InputIterator lastSource, bool isAbsolute);
+      void connect(InputIterator firstSource, InputIterator lastSource, bool isAbsolute, CrosspointStore& crosspoints);
 
+      /**
+        * Disconnects the sources in the range [@p firstSource, @p lastSource)
+        * from this target.
+        * @param firstSource Iterator pointing to the first source to disconnect.
+        * @param lastSource Iterator pointing behind the last source to disconnect.
+        * @param crosspoints The crosspoint store of the matrix owning this
+        *     target, which is kept in sync with the connected sources.
+        */
       template<typename InputIterator>
-      void disconnect(InputIterator firstSource, InputIterator lastSource);
+      void disconnect(InputIterator firstSource, InputIterator lastSource, CrosspointStore& crosspoints);
 
    private:
       int m_number;
@@ -37,33 +55,43 @@ namespace model { namespace matrix
    };
 
    template<typename InputIterator>
-   inline void Signal::connect(InputIterator firstSource, InputIterator lastSource, bool isAbsolute)
+   inline void Signal::connect(InputIterator firstSource, InputIterator lastSource, bool isAbsolute, CrosspointStore& crosspoints)
    {
       if(isAbsolute)
       {
+         crosspoints.clear(m_number);
          m_connectedSources.clear();
-         m_connectedSources.insert(m_connectedSources.end(), firstSource, lastSource);
       }
-      else
+
+      for( ; firstSource != lastSource; firstSource++)
       {
-         for( ; firstSource != lastSource; firstSource++)
-         {
-            if(util::contains(m_connectedSources.begin(), m_connectedSources.end(), *firstSource) == false)
-               m_connectedSources.insert(m_connectedSources.end(), *firstSource);
-         }
+         if(crosspoints.insert(m_number, (*firstSource)->number()))
+            m_connectedSources.insert(m_connectedSources.end(), *firstSource);
       }
    }
 
    template<typename InputIterator>
-   inline void Signal::disconnect(InputIterator firstSource, InputIterator lastSource)
+   inline void Signal::disconnect(InputIterator firstSource, InputIterator lastSource, CrosspointStore& crosspoints)
    {
+      auto anyErased = false;
+
       for( ; firstSource != lastSource; firstSource++)
       {
-         auto last = m_connectedSources.end();
-         auto where = util::find(m_connectedSources.begin(), last, *firstSource);
+         if(crosspoints.erase(m_number, (*firstSource)->number()))
+            anyErased = true;
+      }
+
+      if(anyErased)
+      {
+         auto last = m_connectedSources.begin();
+
+         for(auto source : m_connectedSources)
+         {
+            if(crosspoints.contains(m_number, source->number()))
+               *last++ = source;
+         }
 
-         if(where != last)
-            m_connectedSources.erase(where);
+         m_connectedSources.erase(last, m_connectedSources.end());
       }
    }
 }}
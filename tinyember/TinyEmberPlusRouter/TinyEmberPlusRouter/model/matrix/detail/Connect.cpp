@@ -8,7 +8,7 @@
 
 namespace model { namespace matrix { namespace detail
 {
-   bool connectOneToN(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation)
+   bool connectOneToN(Signal* target, Signal::Vector const& sources, CrosspointStore& crosspoints, void* state, util::ConnectOperation const& operation)
    {
       // only connect first source
       // do not disconnect
@@ -17,21 +17,21 @@ namespace model { namespace matrix { namespace detail
 
       if(firstSource != sources.end())
       {
-         target->connect(firstSource, firstSource + 1, true);
+         target->connect(firstSource, firstSource + 1, true, crosspoints);
          return true;
       }
 
       return false;
    }
 
-   bool connectNToN(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation)
+   bool connectNToN(Signal* target, Signal::Vector const& sources, CrosspointStore& crosspoints, void* state, util::ConnectOperation const& operation)
    {
       // connect/disconnect all passed sources
 
       if(operation.value() == util::ConnectOperation::Disconnect)
-         target->disconnect(sources.begin(), sources.end());
+         target->disconnect(sources.begin(), sources.end(), crosspoints);
       else
-         target->connect(sources.begin(), sources.end(), operation.value() == util::ConnectOperation::Absolute);
+         target->connect(sources.begin(), sources.end(), operation.value() == util::ConnectOperation::Absolute, crosspoints);
 
       return true;
    }
@@ -17,22 +17,24 @@ namespace model { namespace matrix { namespace detail
      * (1:N connection semantics).
      * @param target Pointer to the target to connect to.
      * @param sources Collection of pointers to sources to connect to @p target.
+     * @param crosspoints The crosspoint store of the matrix owning @p target.
      * @param state Caller-defined state to pass through.
      * @param operation The desired connection operation.
      * @return True if the connection could be made, false otherwise.
      */
-   bool connectOneToN(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation);
+   bool connectOneToN(Signal* target, Signal::Vector const& sources, CrosspointStore& crosspoints, void* state, util::ConnectOperation const& operation);
 
    /**
      * Connects or disconnects the sources in @p sources to/from target at @p target
      * (N:N connection semantics).
      * @param target Pointer to the target to connect to.
      * @param sources Collection of pointers to sources to connect to @p target.
+     * @param crosspoints The crosspoint store of the matrix owning @p target.
      * @param state Caller-defined state to pass through.
      * @param operation The desired connection operation.
      * @return True if the connection could be made, false otherwise.
      */
-   bool connectNToN(Signal* target, Signal::Vector const& sources, void* state, util::ConnectOperation const& operation);
+   bool connectNToN(Signal* target, Signal::Vector const& sources, CrosspointStore& crosspoints, void* state, util::ConnectOperation const& operation);
 }}}
 
 #endif
@@ -22,6 +22,23 @@ namespace util
    typedef std::vector<libember::glow::Value> VariantValueVector;
    typedef libember::glow::ParameterType VariantType;
 
+   /**
+     * Hash function object for Oid, which allows Oids to be used as
+     * keys of unordered associative containers.
+     */
+   struct OidHash
+   {
+      std::size_t operator()(Oid const& oid) const
+      {
+         auto hash = std::size_t(17);
+
+         for(auto subid : oid)
+            hash = hash * 31 + subid;
+
+         return hash;
+      }
+   };
+
    class TupleItem
    {
    public: